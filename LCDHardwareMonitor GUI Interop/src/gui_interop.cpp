@@ -33,6 +33,7 @@ static State state = {};
 namespace LCDHardwareMonitor::GUI
 {
 	using namespace System;
+	using namespace System::Collections::Generic;
 	using namespace System::Collections::ObjectModel;
 	using namespace System::ComponentModel;
 	using namespace System::Diagnostics;
@@ -68,6 +69,20 @@ namespace LCDHardwareMonitor::GUI
 		Broken,
 	};
 
+	public enum struct PixelFormat
+	{
+		Null,
+		RGB565,
+		RGB666,
+	};
+
+	public enum struct Dither
+	{
+		Null,
+		Ordered,
+		BlueNoise,
+	};
+
 	public value struct PluginInfo
 	{
 		property CLRString^ Name;
@@ -128,10 +143,13 @@ namespace LCDHardwareMonitor::GUI
 		property Vector                            RenderSize;
 		property ObservableCollection<Plugin>^     Plugins;
 		property ObservableCollection<Sensor>^     Sensors;
+		property Dictionary<UInt32, Int32>^        SensorIndices;
 		property ObservableCollection<WidgetDesc>^ WidgetDescs;
 		property ObservableCollection<Widget>^     Widgets;
 		property ObservableCollection<Widget>^     SelectedWidgets;
 		property Interaction                       Interaction;
+		property PixelFormat                       LCDPixelFormat;
+		property Dither                            LCDDither;
 
 		// UI Helpers
 		property bool         IsSimulationConnected;
@@ -145,6 +163,7 @@ namespace LCDHardwareMonitor::GUI
 		{
 			Plugins           = gcnew ObservableCollection<Plugin>();
 			Sensors           = gcnew ObservableCollection<Sensor>();
+			SensorIndices     = gcnew Dictionary<UInt32, Int32>();
 			WidgetDescs       = gcnew ObservableCollection<WidgetDesc>();
 			Widgets           = gcnew ObservableCollection<Widget>();
 			SelectedWidgets   = gcnew ObservableCollection<Widget>();
@@ -309,6 +328,19 @@ namespace LCDHardwareMonitor::GUI
 			SerializeAndQueueMessage(state.simConnection, resetCamera);
 		}
 
+		static void
+		SetLCDPixelFormat(SimulationState^ simState, PixelFormat format, Dither dither)
+		{
+			simState->LCDPixelFormat = format;
+			simState->LCDDither      = dither;
+			simState->NotifyPropertyChanged("");
+
+			FromGUI::SetLCDPixelFormat setPixelFormat = {};
+			setPixelFormat.format = (::PixelFormat) format;
+			setPixelFormat.dither = (::Dither) dither;
+			SerializeAndQueueMessage(state.simConnection, setPixelFormat);
+		}
+
 		static void
 		BeginDragSelection(SimulationState^ simState)
 		{
@@ -401,6 +433,8 @@ namespace LCDHardwareMonitor::GUI
 
 			simState.RenderSurface = (IntPtr) state.d3d9RenderSurface0;
 			simState.RenderSize = ToManagedVector(connect.renderSize);
+			simState.LCDPixelFormat = (PixelFormat) connect.lcdPixelFormat;
+			simState.LCDDither = (Dither) connect.lcdDither;
 			simState.IsSimulationConnected = true;
 			simState.NotifyPropertyChanged("");
 		}
@@ -415,6 +449,7 @@ namespace LCDHardwareMonitor::GUI
 			simState.RenderSurface = IntPtr::Zero;
 			simState.Plugins->Clear();
 			simState.Sensors->Clear();
+			simState.SensorIndices->Clear();
 			simState.WidgetDescs->Clear();
 			simState.IsSimulationConnected = false;
 			simState.NotifyPropertyChanged("");
@@ -478,12 +513,29 @@ namespace LCDHardwareMonitor::GUI
 				mSensor.Name       = ToManagedString(sensor.name);
 				mSensor.Identifier = ToManagedString(sensor.identifier);
 				mSensor.Format     = ToManagedString(sensor.format);
-				mSensor.Value      = sensor.value;
+				mSensor.Value      = sensorsAdded.values[i];
+				simState.SensorIndices[mSensor.Handle] = simState.Sensors->Count;
 				simState.Sensors->Add(mSensor);
 			}
 			simState.NotifyPropertyChanged("");
 		}
 
+		static void
+		FromSim_SensorValuesChanged(SimulationState% simState, ToGUI::SensorValuesChanged& valuesChanged)
+		{
+			for (u32 i = 0; i < valuesChanged.handles.length; i++)
+			{
+				Int32 index;
+				if (!simState.SensorIndices->TryGetValue(valuesChanged.handles[i].value, index))
+					continue;
+
+				Sensor mSensor = simState.Sensors[index];
+				mSensor.Value = valuesChanged.values[i];
+				simState.Sensors[index] = mSensor;
+			}
+			simState.NotifyPropertyChanged("");
+		}
+
 		static void
 		FromSim_WidgetTypesAdded(SimulationState% simState, ToGUI::WidgetTypesAdded& widgetTypesAdded)
 		{
@@ -533,7 +585,7 @@ namespace LCDHardwareMonitor::GUI
 			// DEBUG: Needed for the Watch window
 			State& s = state;
 
-			PipeResult result = Platform_CreatePipeClient("LCDHardwareMonitor GUI Pipe", s.simConnection.pipe);
+			PipeResult result = Platform_CreatePipeClient(GUIPipeName, s.simConnection.pipe, GUIPipeTransport);
 			LOG_IF(result == PipeResult::UnexpectedFailure, return false,
 				Severity::Error, "Failed to create pipe for sim communication");
 
@@ -581,7 +633,7 @@ namespace LCDHardwareMonitor::GUI
 					if (!success) break;
 
 					#define HANDLE_MESSAGE(Type) \
-						case IdOf<ToGUI::Type>: \
+						case MessageTypeOf<ToGUI::Type>: \
 						{ \
 							using Type = ToGUI::Type; \
 							DeserializeMessage<Type>(bytes); \
@@ -590,11 +642,13 @@ namespace LCDHardwareMonitor::GUI
 							break; \
 						}
 
+					// NOTE: Managed handlers can't go in a MessageTable. The type is a dense index so this
+					// still compiles to a jump table.
 					Message::Header& header = (Message::Header&) bytes[0];
-					switch (header.id)
+					switch (header.type)
 					{
 						default:
-						case IdOf<Message::Null>:
+						case MessageTypeOf<Message::Null>:
 							Assert(false);
 							break;
 
@@ -603,6 +657,7 @@ namespace LCDHardwareMonitor::GUI
 						HANDLE_MESSAGE(PluginsAdded)
 						HANDLE_MESSAGE(PluginStatesChanged)
 						HANDLE_MESSAGE(SensorsAdded)
+						HANDLE_MESSAGE(SensorValuesChanged)
 						HANDLE_MESSAGE(WidgetTypesAdded)
 						HANDLE_MESSAGE(WidgetsAdded)
 						HANDLE_MESSAGE(WidgetSelectionChanged)
@@ -100,6 +100,18 @@ namespace LCDHardwareMonitor.GUI
 			Interop.ForceTerminateSim(simState);
 		}
 
+		private void LCDPixelFormat_SelectionChanged(object sender, SelectionChangedEventArgs e)
+		{
+			// NOTE: Also raised when the binding updates on connect, which shouldn't be sent back
+			if (lcdPixelFormat.SelectedItem == null || lcdDither.SelectedItem == null) return;
+
+			PixelFormat format = (PixelFormat) lcdPixelFormat.SelectedItem;
+			Dither      dither = (Dither) lcdDither.SelectedItem;
+			if (format == simState.LCDPixelFormat && dither == simState.LCDDither) return;
+
+			Interop.SetLCDPixelFormat(simState, format, dither);
+		}
+
 		private void LoadPlugin_Click(object sender, RoutedEventArgs e)
 		{
 			Button button = (Button) sender;
@@ -25,7 +25,7 @@ Bytes_WriteObject(Bytes& bytes, u32 offset, T& object)
 
 	T& dst = (T&) bytes[offset];
 	dst = object;
-	bytes.length = Max(bytes.length, offset + sizeof(T));
+	bytes.length = Max(bytes.length, (u32) (offset + sizeof(T)));
 
 	return true;
 }
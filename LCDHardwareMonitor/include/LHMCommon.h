@@ -2,6 +2,7 @@
 #define LHM_COMMON
 
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 #include <math.h>
 
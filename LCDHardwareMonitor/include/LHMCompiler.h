@@ -22,6 +22,15 @@
 	#else
 		#define DEBUG 0
 	#endif
+#elif __GNUC__
+	#define EXPORT extern "C" __attribute__((visibility("default")))
+	#define __FUNCTION_FULL_NAME__ __PRETTY_FUNCTION__
+
+	#if !defined(NDEBUG)
+		#define DEBUG 1
+	#else
+		#define DEBUG 0
+	#endif
 #endif
 
 #if defined(__cplusplus_cli)
@@ -1,7 +1,7 @@
 #ifndef LHM_HASH
 #define LHM_HASH
 
-// NOTE: This is somewhat weak for short, similar strings. Consider FNV or Murmur.
+// NOTE: This is somewhat weak for short, similar strings. Use Fnv1a64 for identifiers.
 constexpr u32 Adler32(const c8* data, size length)
 {
 	if (length == 0) return 0;
@@ -24,13 +24,34 @@ constexpr u32 Adler32(const char (&data)[N])
 	return Adler32(data, N);
 }
 
+// NOTE: FNV-1a. Every input byte is mixed into all 64 bits so strings that only differ by a
+// character or two (e.g. type names) still end up far apart.
+constexpr u64 Fnv1a64(const c8* data, size length)
+{
+	u64 hash = 0xCBF29CE484222325;
+	for (size i = 0; i < length; i++)
+	{
+		hash ^= (u8) data[i];
+		hash *= 0x100000001B3;
+	}
+
+	return hash;
+}
+
+template<size N>
+constexpr u64 Fnv1a64(const char (&data)[N])
+{
+	// NOTE: Skip the null terminator
+	return Fnv1a64(data, N - 1);
+}
+
 template<typename T>
-constexpr u32 _IdOf()
+constexpr u64 _IdOf()
 {
-	return Adler32(__FUNCTION_FULL_NAME__);
+	return Fnv1a64(__FUNCTION_FULL_NAME__);
 }
 
 template<class T>
-constexpr u32 IdOf = _IdOf<T>();
+constexpr u64 IdOf = _IdOf<T>();
 
 #endif
@@ -0,0 +1,385 @@
+#ifndef LHM_HASHMAP
+#define LHM_HASHMAP
+
+// NOTE:
+// - Open addressing with linear probing over groups of 16 slots. Each slot has a control byte that
+//   is either empty, deleted, or the low 7 bits of the key's hash. A lookup compares a whole group
+//   of control bytes at once (SSE2 when available) and only touches keys whose bits match.
+//
+// - Full hashes are stored next to the keys. Growing never rehashes keys and a key comparison
+//   only happens when all 64 bits match.
+//
+// - Keys are copy-assigned into slots. StringView keys are not owned: the map only points at the
+//   characters so they must outlive the entry (e.g. use the String stored in the object the value
+//   refers to).
+//
+// - Every function has an overload that takes a precomputed hash (see HashMap_Hash) so callers
+//   that look up the same key repeatedly, or already have the hash, don't pay for it again.
+//
+// - Removing leaves a tombstone. Tombstones are cleared the next time the map grows or is
+//   rehashed.
+
+#if _MSC_VER
+	#include <intrin.h>
+#endif
+
+const u32 HashMapGroupSize   = 16;
+const u8  HashMapEmpty       = 0x80;
+const u8  HashMapDeleted     = 0xFE;
+const u32 HashMapMinCapacity = HashMapGroupSize;
+
+template<typename K, typename V>
+struct HashMap
+{
+	u32  length;
+	u32  capacity;
+	u32  tombstones;
+	u8*  control;
+	u64* hashes;
+	K*   keys;
+	V*   values;
+};
+
+// -------------------------------------------------------------------------------------------------
+// Keys
+
+inline u64
+HashMap_Hash(StringView key)
+{
+	return Fnv1a64(key.data, key.length);
+}
+
+template<typename K>
+inline u64
+HashMap_Hash(const K& key)
+{
+	return Fnv1a64((const c8*) &key, sizeof(K));
+}
+
+inline b8
+HashMap_KeyEqual(StringView lhs, StringView rhs)
+{
+	return String_Equal(lhs, rhs);
+}
+
+template<typename K>
+inline b8
+HashMap_KeyEqual(const K& lhs, const K& rhs)
+{
+	return lhs == rhs;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Control Bytes
+
+// NOTE: Returns a bit per slot in the group whose control byte equals value
+inline u32
+HashMap_MatchGroup(const u8* group, u8 value)
+{
+	#if LHM_SIMD
+	__m128i control = _mm_loadu_si128((const __m128i*) group);
+	__m128i matches = _mm_cmpeq_epi8(control, _mm_set1_epi8((c8) value));
+	return (u32) _mm_movemask_epi8(matches);
+	#else
+	u32 result = 0;
+	for (u32 i = 0; i < HashMapGroupSize; i++)
+		result |= (u32) (group[i] == value) << i;
+	return result;
+	#endif
+}
+
+// NOTE: Empty and deleted are the only control bytes with the high bit set
+inline u32
+HashMap_MatchGroupFree(const u8* group)
+{
+	#if LHM_SIMD
+	__m128i control = _mm_loadu_si128((const __m128i*) group);
+	return (u32) _mm_movemask_epi8(control);
+	#else
+	u32 result = 0;
+	for (u32 i = 0; i < HashMapGroupSize; i++)
+		result |= (u32) (group[i] >> 7) << i;
+	return result;
+	#endif
+}
+
+inline u32
+HashMap_FirstMatch(u32 matches)
+{
+	Assert(matches);
+	#if _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, matches);
+	return (u32) index;
+	#else
+	return (u32) __builtin_ctz(matches);
+	#endif
+}
+
+inline u8
+HashMap_Tag(u64 hash)
+{
+	return (u8) (hash & 0x7F);
+}
+
+inline u32
+HashMap_FirstGroup(u32 capacity, u64 hash)
+{
+	u32 groupMask = capacity / HashMapGroupSize - 1;
+	return (u32) (hash >> 7) & groupMask;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Internal
+
+// NOTE: Returns u32Max if the key isn't in the map
+template<typename K, typename V>
+inline u32
+HashMap_FindSlot(HashMap<K, V>& map, const K& key, u64 hash)
+{
+	if (map.length == 0) return u32Max;
+
+	u32 groupCount = map.capacity / HashMapGroupSize;
+	u32 group      = HashMap_FirstGroup(map.capacity, hash);
+	u8  tag        = HashMap_Tag(hash);
+
+	for (u32 probe = 0; probe < groupCount; probe++)
+	{
+		u32 first = group * HashMapGroupSize;
+		u8* control = &map.control[first];
+
+		u32 matches = HashMap_MatchGroup(control, tag);
+		while (matches)
+		{
+			u32 slot = first + HashMap_FirstMatch(matches);
+			if (map.hashes[slot] == hash && HashMap_KeyEqual(map.keys[slot], key))
+				return slot;
+			matches &= matches - 1;
+		}
+
+		// NOTE: Inserts fill the first group with room, so an empty slot ends the probe
+		if (HashMap_MatchGroup(control, HashMapEmpty)) break;
+		group = (group + 1) & (groupCount - 1);
+	}
+
+	return u32Max;
+}
+
+// NOTE: Doesn't check for an existing key or capacity
+template<typename K, typename V>
+inline u32
+HashMap_InsertSlot(HashMap<K, V>& map, u64 hash)
+{
+	u32 groupCount = map.capacity / HashMapGroupSize;
+	u32 group      = HashMap_FirstGroup(map.capacity, hash);
+
+	for (;;)
+	{
+		u32 first   = group * HashMapGroupSize;
+		u32 matches = HashMap_MatchGroupFree(&map.control[first]);
+		if (matches)
+		{
+			u32 slot = first + HashMap_FirstMatch(matches);
+			map.tombstones -= map.control[slot] == HashMapDeleted;
+			map.control[slot] = HashMap_Tag(hash);
+			map.hashes[slot]  = hash;
+			map.length++;
+			return slot;
+		}
+
+		group = (group + 1) & (groupCount - 1);
+	}
+}
+
+template<typename K, typename V>
+inline void
+HashMap_Rehash(HashMap<K, V>& map, u32 capacity)
+{
+	Assert(capacity >= HashMapMinCapacity && (capacity & (capacity - 1)) == 0);
+
+	// NOTE: One allocation. capacity is a multiple of 16 so every array stays aligned.
+	size controlSize = sizeof(u8)  * capacity;
+	size hashesSize  = sizeof(u64) * capacity;
+	size keysSize    = sizeof(K)   * capacity;
+	size valuesSize  = sizeof(V)   * capacity;
+
+	u8* memory = (u8*) AllocChecked(controlSize + hashesSize + keysSize + valuesSize);
+	memset(memory, HashMapEmpty, controlSize);
+	memset(memory + controlSize, 0, hashesSize + keysSize + valuesSize);
+
+	HashMap<K, V> result = {};
+	result.capacity = capacity;
+	result.control  = memory;
+	result.hashes   = (u64*) (memory + controlSize);
+	result.keys     = (K*)   (memory + controlSize + hashesSize);
+	result.values   = (V*)   (memory + controlSize + hashesSize + keysSize);
+
+	for (u32 i = 0; i < map.capacity; i++)
+	{
+		if (map.control[i] & 0x80) continue;
+
+		u32 slot = HashMap_InsertSlot(result, map.hashes[i]);
+		result.keys[slot]   = map.keys[i];
+		result.values[slot] = map.values[i];
+	}
+
+	Free(map.control);
+	map = result;
+}
+
+// -------------------------------------------------------------------------------------------------
+// HashMap Functions
+
+// NOTE: Makes room for count more entries without rehashing
+template<typename K, typename V>
+inline b8
+HashMap_Reserve(HashMap<K, V>& map, u32 count)
+{
+	// NOTE: Max load factor of 7/8
+	u32 used = map.length + map.tombstones + count;
+	if (used <= map.capacity - map.capacity / 8) return false;
+
+	u32 needed   = map.length + count;
+	u32 capacity = HashMapMinCapacity;
+	while (needed > capacity - capacity / 8)
+		capacity *= 2;
+
+	HashMap_Rehash(map, Max(capacity, map.capacity));
+	return true;
+}
+
+template<typename K, typename V>
+inline V*
+HashMap_Find(HashMap<K, V>& map, const K& key, u64 hash)
+{
+	u32 slot = HashMap_FindSlot(map, key, hash);
+	if (slot == u32Max) return nullptr;
+	return &map.values[slot];
+}
+
+template<typename K, typename V>
+inline V*
+HashMap_Find(HashMap<K, V>& map, const K& key)
+{
+	return HashMap_Find(map, key, HashMap_Hash(key));
+}
+
+template<typename K, typename V>
+inline b8
+HashMap_Contains(HashMap<K, V>& map, const K& key)
+{
+	return HashMap_Find(map, key) != nullptr;
+}
+
+// NOTE: Adds the entry or replaces an existing one. Returns true if it was added. The key is
+// replaced along with the value so a key that points at the value's storage (e.g. a StringView of
+// a member) never outlives it.
+template<typename K, typename V>
+inline b8
+HashMap_Set(HashMap<K, V>& map, const K& key, const V& value, u64 hash)
+{
+	u32 slot = HashMap_FindSlot(map, key, hash);
+	if (slot != u32Max)
+	{
+		map.keys[slot]   = key;
+		map.values[slot] = value;
+		return false;
+	}
+
+	HashMap_Reserve(map, 1);
+	slot = HashMap_InsertSlot(map, hash);
+	map.keys[slot]   = key;
+	map.values[slot] = value;
+	return true;
+}
+
+template<typename K, typename V>
+inline b8
+HashMap_Set(HashMap<K, V>& map, const K& key, const V& value)
+{
+	return HashMap_Set(map, key, value, HashMap_Hash(key));
+}
+
+// NOTE: Bulk version of HashMap_Set. Grows at most once and hashes every key before probing. Keys
+// can be any type that converts to K (e.g. a Slice<String> for a StringView map). Returns the number
+// of entries that were added rather than replaced.
+template<typename K, typename V, typename U>
+inline u32
+HashMap_SetRange(HashMap<K, V>& map, Slice<U> keys, Slice<V> values)
+{
+	Assert(keys.length == values.length);
+	if (keys.length == 0) return 0;
+
+	HashMap_Reserve(map, keys.length);
+
+	List<u64> hashes = {};
+	List_AppendRange(hashes, keys.length);
+	defer { List_Free(hashes); };
+
+	for (u32 i = 0; i < keys.length; i++)
+		hashes[i] = HashMap_Hash((K) keys[i]);
+
+	u32 added = 0;
+	for (u32 i = 0; i < keys.length; i++)
+	{
+		K key = keys[i];
+
+		u32 slot = HashMap_FindSlot(map, key, hashes[i]);
+		if (slot == u32Max)
+		{
+			slot = HashMap_InsertSlot(map, hashes[i]);
+			added++;
+		}
+		map.keys[slot]   = key;
+		map.values[slot] = values[i];
+	}
+
+	return added;
+}
+
+template<typename K, typename V>
+inline b8
+HashMap_Remove(HashMap<K, V>& map, const K& key, u64 hash)
+{
+	u32 slot = HashMap_FindSlot(map, key, hash);
+	if (slot == u32Max) return false;
+
+	map.control[slot] = HashMapDeleted;
+	map.hashes[slot]  = 0;
+	map.keys[slot]    = {};
+	map.values[slot]  = {};
+	map.length--;
+	map.tombstones++;
+	return true;
+}
+
+template<typename K, typename V>
+inline b8
+HashMap_Remove(HashMap<K, V>& map, const K& key)
+{
+	return HashMap_Remove(map, key, HashMap_Hash(key));
+}
+
+template<typename K, typename V>
+inline void
+HashMap_Clear(HashMap<K, V>& map)
+{
+	if (map.capacity == 0) return;
+
+	memset(map.control, HashMapEmpty, sizeof(u8) * map.capacity);
+	memset(map.hashes, 0, sizeof(u64) * map.capacity);
+	memset(map.keys,   0, sizeof(K)   * map.capacity);
+	memset(map.values, 0, sizeof(V)   * map.capacity);
+	map.length     = 0;
+	map.tombstones = 0;
+}
+
+template<typename K, typename V>
+inline void
+HashMap_Free(HashMap<K, V>& map)
+{
+	Free(map.control);
+	map = {};
+}
+
+#endif
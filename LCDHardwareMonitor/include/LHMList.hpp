@@ -134,7 +134,7 @@ List_Grow(List<T>& list, u32 count)
 	{
 		u32 capacity  = Max(list.capacity ? 2*list.capacity : 4, list.length + count);
 		u64 totalSize = sizeof(T) * u64(capacity);
-		u64 emptySize = sizeof(T) * u64(count);
+		u64 emptySize = sizeof(T) * u64(capacity - list.length);
 
 		list.capacity = capacity;
 		list.data     = (T*) ReallocChecked(list.data, (size) totalSize);
@@ -443,8 +443,6 @@ List_Shrink(List<T>& list)
 		list.capacity = capacity;
 		list.data     = (T*) ReallocChecked(list.data, (size) totalSize);
 	}
-
-	return true;
 }
 
 // TODO: Consider renaming to List_SizeOfData
@@ -19,6 +19,28 @@
 // TODO: Can't use operators from the VS Watch window if they are
 // pass-by-value, but passing by reference requires const everywhere. Ugh.
 
+// NOTE: TransformBatch uses SSE when it's available (always on x64). Matrix products and
+// MultiplyBatch use AVX2 + FMA when the compiler is allowed to emit them (/arch:AVX2, -mavx2 -mfma).
+// Single SSE matrix products, v4 * Matrix, and InvertRT weren't faster than scalar code so they
+// don't have SIMD versions. The Windows build enables AVX2 with msbuild /p:EnableAVX2=true. Define
+// LHM_SIMD as 0 before including this file to force the scalar code. /clr builds always get the
+// scalar code: functions using __m128 can't be managed, so they'd be compiled native (C4793).
+#if !defined(LHM_SIMD)
+	#if defined(_M_CEE)
+		#define LHM_SIMD 0
+	#elif defined(__AVX2__) && (defined(__FMA__) || _MSC_VER)
+		#define LHM_SIMD 2
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define LHM_SIMD 1
+	#else
+		#define LHM_SIMD 0
+	#endif
+#endif
+
+#if LHM_SIMD
+	#include <immintrin.h>
+#endif
+
 // -------------------------------------------------------------------------------------------------
 // General
 
@@ -69,6 +91,22 @@ Cos(r64 theta)
 	return cos(theta);
 }
 
+template<typename T>
+constexpr inline T
+Max(T lhs, T rhs)
+{
+	T result = lhs > rhs ? lhs : rhs;
+	return result;
+}
+
+template<typename T>
+constexpr inline T
+Min(T lhs, T rhs)
+{
+	T result = lhs < rhs ? lhs : rhs;
+	return result;
+}
+
 template<typename T>
 constexpr inline T
 Clamp(T value, T min, T max)
@@ -136,22 +174,6 @@ InverseLerpClamped(T from, T to, T value)
 	return result;
 }
 
-template<typename T>
-constexpr inline T
-Max(T lhs, T rhs)
-{
-	T result = lhs > rhs ? lhs : rhs;
-	return result;
-}
-
-template<typename T>
-constexpr inline T
-Min(T lhs, T rhs)
-{
-	T result = lhs < rhs ? lhs : rhs;
-	return result;
-}
-
 inline r32
 Round(r32 value)
 {
@@ -1645,20 +1667,22 @@ union Matrix
 	};
 
 	// Aliases
+	// NOTE: Members that aren't aliased are padding. GCC and Clang don't allow the same name in more
+	// than one anonymous struct.
 	struct
 	{
 		// TODO: Not sure if this is correct
 		r32 xx,  yx,  zx,  tx;
 		r32 xy,  yy,  zy,  ty;
 		r32 xz,  yz,  zz,  tz;
-		r32 m03, m13, m23, m33;
+		r32 _t0, _t1, _t2, _t3;
 	};
 	struct
 	{
-		r32 sx,  m10, m20, m30;
-		r32 m01, sy,  m21, m31;
-		r32 m02, m12, sz,  m32;
-		r32 m03, m13, m23, m33;
+		r32 sx,  _s0, _s1, _s2;
+		r32 _s3, sy,  _s4, _s5;
+		r32 _s6, _s7, sz,  _s8;
+		r32 _s9, _sA, _sB, _sC;
 	};
 	r32 raw[16];
 	r32 arr[4][4];
@@ -1687,31 +1711,75 @@ Col(const Matrix& m, u32 col)
 	return result;
 }
 
-constexpr inline Matrix
-operator* (const Matrix& lhs, const Matrix& rhs)
+#if LHM_SIMD
+// NOTE: Returns c0*v.x + c1*v.y + c2*v.z + c3*v.w
+inline __m128
+SIMD_Combine(__m128 v, __m128 c0, __m128 c1, __m128 c2, __m128 c3)
 {
-	Matrix result = {
+	#if LHM_SIMD >= 2
+	__m128 result = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+	result = _mm_fmadd_ps(c1, _mm_shuffle_ps(v, v, 0x55), result);
+	result = _mm_fmadd_ps(c2, _mm_shuffle_ps(v, v, 0xAA), result);
+	result = _mm_fmadd_ps(c3, _mm_shuffle_ps(v, v, 0xFF), result);
+	#else
+	__m128 result = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, 0x00));
+	result = _mm_add_ps(result, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, 0x55)));
+	result = _mm_add_ps(result, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, 0xAA)));
+	result = _mm_add_ps(result, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, 0xFF)));
+	#endif
+	return result;
+}
+#endif
+
+// NOTE: result may alias lhs or rhs
+inline void
+Multiply(Matrix& result, const Matrix& lhs, const Matrix& rhs)
+{
+	#if LHM_SIMD >= 2
+	// NOTE: Two result columns per iteration. Each column is the columns of lhs weighted by the
+	// matching column of rhs.
+	__m256 l0 = _mm256_broadcast_ps((const __m128*) &lhs.col[0]);
+	__m256 l1 = _mm256_broadcast_ps((const __m128*) &lhs.col[1]);
+	__m256 l2 = _mm256_broadcast_ps((const __m128*) &lhs.col[2]);
+	__m256 l3 = _mm256_broadcast_ps((const __m128*) &lhs.col[3]);
+	for (u32 c = 0; c < 4; c += 2)
+	{
+		__m256 r = _mm256_loadu_ps(rhs.col[c].arr);
+		__m256 v = _mm256_mul_ps(l0, _mm256_permute_ps(r, 0x00));
+		v = _mm256_fmadd_ps(l1, _mm256_permute_ps(r, 0x55), v);
+		v = _mm256_fmadd_ps(l2, _mm256_permute_ps(r, 0xAA), v);
+		v = _mm256_fmadd_ps(l3, _mm256_permute_ps(r, 0xFF), v);
+		_mm256_storeu_ps(result.col[c].arr, v);
+	}
+	#else
+	// NOTE: An SSE version wasn't any faster than what the compiler makes of this
+	result = {
 		Dot(Row(lhs, 0), Col(rhs, 0)), Dot(Row(lhs, 1), Col(rhs, 0)), Dot(Row(lhs, 2), Col(rhs, 0)), Dot(Row(lhs, 3), Col(rhs, 0)),
 		Dot(Row(lhs, 0), Col(rhs, 1)), Dot(Row(lhs, 1), Col(rhs, 1)), Dot(Row(lhs, 2), Col(rhs, 1)), Dot(Row(lhs, 3), Col(rhs, 1)),
 		Dot(Row(lhs, 0), Col(rhs, 2)), Dot(Row(lhs, 1), Col(rhs, 2)), Dot(Row(lhs, 2), Col(rhs, 2)), Dot(Row(lhs, 3), Col(rhs, 2)),
 		Dot(Row(lhs, 0), Col(rhs, 3)), Dot(Row(lhs, 1), Col(rhs, 3)), Dot(Row(lhs, 2), Col(rhs, 3)), Dot(Row(lhs, 3), Col(rhs, 3))
 	};
+	#endif
+}
+
+inline Matrix
+operator* (const Matrix& lhs, const Matrix& rhs)
+{
+	Matrix result;
+	Multiply(result, lhs, rhs);
 	return result;
 }
 
-constexpr inline void
+inline void
 operator*= (Matrix& lhs, const Matrix& rhs)
 {
-	lhs = {
-		Dot(Row(lhs, 0), Col(rhs, 0)), Dot(Row(lhs, 1), Col(rhs, 0)), Dot(Row(lhs, 2), Col(rhs, 0)), Dot(Row(lhs, 3), Col(rhs, 0)),
-		Dot(Row(lhs, 0), Col(rhs, 1)), Dot(Row(lhs, 1), Col(rhs, 1)), Dot(Row(lhs, 2), Col(rhs, 1)), Dot(Row(lhs, 3), Col(rhs, 1)),
-		Dot(Row(lhs, 0), Col(rhs, 2)), Dot(Row(lhs, 1), Col(rhs, 2)), Dot(Row(lhs, 2), Col(rhs, 2)), Dot(Row(lhs, 3), Col(rhs, 2)),
-		Dot(Row(lhs, 0), Col(rhs, 3)), Dot(Row(lhs, 1), Col(rhs, 3)), Dot(Row(lhs, 2), Col(rhs, 3)), Dot(Row(lhs, 3), Col(rhs, 3))
-	};
+	Multiply(lhs, lhs, rhs);
 }
 
 // TODO: Versions for v3?
-constexpr inline v4
+// NOTE: A single transform is too little work for SIMD to pay for the shuffles. Use TransformBatch
+// for many vectors.
+inline v4
 operator* (v4 lhs, const Matrix& rhs)
 {
 	v4 result = {
@@ -1723,12 +1791,71 @@ operator* (v4 lhs, const Matrix& rhs)
 	return result;
 }
 
-constexpr inline void
+inline void
 operator*= (v4& lhs, const Matrix& rhs)
 {
 	lhs = lhs * rhs;
 }
 
+// NOTE: result[i] = lhs[i] * rhs. result may alias lhs.
+inline void
+MultiplyBatch(Matrix* result, const Matrix* lhs, const Matrix& rhs, u32 count)
+{
+	#if LHM_SIMD >= 2
+	// NOTE: rhs is the same for every matrix so its splats are hoisted out of the loop
+	__m256 r01 = _mm256_loadu_ps(rhs.col[0].arr);
+	__m256 r23 = _mm256_loadu_ps(rhs.col[2].arr);
+	__m256 r01x = _mm256_permute_ps(r01, 0x00), r23x = _mm256_permute_ps(r23, 0x00);
+	__m256 r01y = _mm256_permute_ps(r01, 0x55), r23y = _mm256_permute_ps(r23, 0x55);
+	__m256 r01z = _mm256_permute_ps(r01, 0xAA), r23z = _mm256_permute_ps(r23, 0xAA);
+	__m256 r01w = _mm256_permute_ps(r01, 0xFF), r23w = _mm256_permute_ps(r23, 0xFF);
+	for (u32 i = 0; i < count; i++)
+	{
+		__m256 l0 = _mm256_broadcast_ps((const __m128*) &lhs[i].col[0]);
+		__m256 l1 = _mm256_broadcast_ps((const __m128*) &lhs[i].col[1]);
+		__m256 l2 = _mm256_broadcast_ps((const __m128*) &lhs[i].col[2]);
+		__m256 l3 = _mm256_broadcast_ps((const __m128*) &lhs[i].col[3]);
+
+		__m256 v01 = _mm256_mul_ps(l0, r01x);
+		__m256 v23 = _mm256_mul_ps(l0, r23x);
+		v01 = _mm256_fmadd_ps(l1, r01y, v01);
+		v23 = _mm256_fmadd_ps(l1, r23y, v23);
+		v01 = _mm256_fmadd_ps(l2, r01z, v01);
+		v23 = _mm256_fmadd_ps(l2, r23z, v23);
+		v01 = _mm256_fmadd_ps(l3, r01w, v01);
+		v23 = _mm256_fmadd_ps(l3, r23w, v23);
+		_mm256_storeu_ps(result[i].col[0].arr, v01);
+		_mm256_storeu_ps(result[i].col[2].arr, v23);
+	}
+	#else
+	for (u32 i = 0; i < count; i++)
+		Multiply(result[i], lhs[i], rhs);
+	#endif
+}
+
+// NOTE: result[i] = vectors[i] * m. result may alias vectors.
+inline void
+TransformBatch(v4* result, const v4* vectors, const Matrix& m, u32 count)
+{
+	#if LHM_SIMD
+	// NOTE: v * m is the rows of m weighted by v, so transpose once up front
+	__m128 t0 = _mm_loadu_ps(m.col[0].arr);
+	__m128 t1 = _mm_loadu_ps(m.col[1].arr);
+	__m128 t2 = _mm_loadu_ps(m.col[2].arr);
+	__m128 t3 = _mm_loadu_ps(m.col[3].arr);
+	_MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+
+	for (u32 i = 0; i < count; i++)
+	{
+		__m128 v = SIMD_Combine(_mm_loadu_ps(vectors[i].arr), t0, t1, t2, t3);
+		_mm_storeu_ps(result[i].arr, v);
+	}
+	#else
+	for (u32 i = 0; i < count; i++)
+		result[i] = vectors[i] * m;
+	#endif
+}
+
 constexpr inline v4&
 Matrix::operator[] (u32 _col)
 {
@@ -1758,7 +1885,7 @@ Identity()
 }
 
 // TODO: What about scale?
-constexpr inline Matrix
+inline Matrix
 InvertRT(const Matrix& m)
 {
 	Matrix result = {
@@ -1,13 +1,25 @@
 #ifndef LHM_SENSORPLUGIN
 #define LHM_SENSORPLUGIN
 
+struct SensorPlugin;
+
+// NOTE: Sensor only holds metadata. Values live in a separate, dense column (see
+// SensorPluginAPI::Update::values) so updating and scanning values doesn't drag names and text
+// through the cache.
 struct Sensor
 {
-	Handle<Sensor> handle;
-	String         name;
-	String         identifier;
-	String         format;
-	r32            value;
+	Handle<Sensor>       handle;
+	String               name;
+	String               identifier;
+	String               format;
+
+	// NOTE: Maintained by the application. text is only regenerated when value changes at the
+	// precision specified by format. guiValue is the last value sent to the GUI.
+	Handle<SensorPlugin> sensorPluginHandle;
+	String               text;
+	NumberFormat         textFormat;
+	i64                  textValue;
+	r32                  guiValue;
 
 	// TODO: Might want an integer Type field with a plugin provided to-string function.
 };
@@ -38,7 +50,9 @@ struct SensorPluginAPI
 		RegisterSensorsFn*   RegisterSensors;
 		UnregisterSensorsFn* UnregisterSensors;
 
+		// NOTE: values[i] is the value of sensors[i]. Plugins write values, sensors is read only.
 		Slice<Sensor> sensors;
+		Slice<r32>    values;
 	};
 
 	struct Teardown
@@ -58,6 +72,9 @@ struct SensorPluginFunctions
 	InitializeFn*    Initialize;
 	UpdateFn*        Update;
 	TeardownFn*      Teardown;
+
+	// NOTE: Seconds between calls to Update. Zero updates every frame.
+	r32              updateInterval;
 };
 
 #endif
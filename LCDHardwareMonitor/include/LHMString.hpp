@@ -14,6 +14,20 @@
 // string and a zero initialized String struct both have length = 0, which is ambiguous and a bit of
 // a trap.
 
+#if !_MSC_VER
+// NOTE: strncpy_s is only in the MSVC CRT. Same semantics for how it's used here: copy up to count
+// characters, stopping at a null, and always terminate.
+inline int
+strncpy_s(c8* dst, size dstSize, const c8* src, size count)
+{
+	size length = strnlen(src, count);
+	AssertOrUnused(length < dstSize);
+	memcpy(dst, src, length);
+	dst[length] = '\0';
+	return 0;
+}
+#endif
+
 struct StrPos
 {
 	u32 value;
@@ -126,6 +140,16 @@ String_FromSlice(StringSlice slice)
 	return string;
 }
 
+// NOTE: The view points into the null terminated string, nothing is copied
+StringView
+String_ViewCString(const c8* cstring)
+{
+	StringView view = {};
+	view.length = (u32) strlen(cstring);
+	view.data   = (c8*) cstring;
+	return view;
+}
+
 inline StrPos
 String_GetPos(StringView string, u32 index)
 {
@@ -168,6 +192,17 @@ String_FindLast(StringView string, c8 item)
 	return StrPos::Null;
 }
 
+inline b8
+String_Equal(StringView lhs, StringView rhs)
+{
+	if (lhs.length != rhs.length) return false;
+	for (u32 i = 0; i < lhs.length; i++)
+		if (lhs.data[i] != rhs.data[i])
+			return false;
+
+	return true;
+}
+
 StringSlice
 String_Slice(StringView string, StrPos first, StrPos last)
 {
@@ -293,6 +328,251 @@ String_FormatChecked(StringView format, Args&&... args)
 	return String_FormatImpl(format, args...);
 }
 
+// -------------------------------------------------------------------------------------------------
+// Numeric Formatting
+
+// NOTE: Sensor values are formatted every frame, so these avoid printf and the C runtime entirely.
+// They follow the same convention as ToString: when string.data is null only the length is
+// computed. Fixed precision values are quantized to an integer first (e.g. 12.345 at precision 2
+// becomes 1235) so callers can cheaply tell whether the displayed text would change.
+
+enum struct NumberKind : u8
+{
+	Null,
+	Integer,
+	Fixed,
+};
+
+// NOTE: A single numeric placeholder with optional literal text on either side, e.g. "%.0f RPM" or
+// "%i MHz". The literal text is stored as ranges of the original format string so this stays POD.
+struct NumberFormat
+{
+	NumberKind kind;
+	u8         precision;
+	u32        prefixLength;
+	u32        suffixIndex;
+};
+
+const u32 MaxNumberPrecision = 9;
+const u32 MaxNumberLength    = 24;
+const i64 QuantizedNaN       = INT64_MIN;
+
+constexpr u64 DecimalPowers[MaxNumberPrecision + 1] = {
+	1ULL,
+	10ULL,
+	100ULL,
+	1000ULL,
+	10000ULL,
+	100000ULL,
+	1000000ULL,
+	10000000ULL,
+	100000000ULL,
+	1000000000ULL,
+};
+
+inline u32
+ToStringChars(String& string, const c8* chars, u32 count)
+{
+	b8 lengthOnly = !string.data;
+	if (!lengthOnly)
+	{
+		Assert(string.length + count < string.capacity);
+		memcpy(&string.data[string.length], chars, count);
+		string.data[string.length + count] = '\0';
+	}
+	string.length += count * !lengthOnly;
+	return count;
+}
+
+inline u32
+ToStringUnsigned(String& string, u64 value, u32 minDigits = 1)
+{
+	c8  digits[20];
+	u32 count = 0;
+
+	Assert(minDigits <= ArrayLength(digits));
+	while (value || count < minDigits)
+	{
+		count++;
+		digits[ArrayLength(digits) - count] = (c8) ('0' + value % 10);
+		value /= 10;
+	}
+
+	return ToStringChars(string, &digits[ArrayLength(digits) - count], count);
+}
+
+inline u32
+ToStringSigned(String& string, i64 value)
+{
+	u32 written = 0;
+	u64 magnitude = (u64) value;
+	if (value < 0)
+	{
+		written += ToStringChars(string, "-", 1);
+		magnitude = 0 - magnitude;
+	}
+	written += ToStringUnsigned(string, magnitude);
+	return written;
+}
+
+inline b8
+QuantizeFixed(r64 value, u32 precision, i64& quantized)
+{
+	Assert(precision <= MaxNumberPrecision);
+
+	r64 scaled = round(value * (r64) DecimalPowers[precision]);
+	b8  inRange = fabs(scaled) < 9.2e18;
+
+	if (isnan(value))   quantized = QuantizedNaN;
+	else if (inRange)   quantized = (i64) scaled;
+	else if (value < 0) quantized = -INT64_MAX;
+	else                quantized = INT64_MAX;
+
+	return inRange;
+}
+
+inline i64
+QuantizeFixed(r64 value, u32 precision)
+{
+	// NOTE: Values outside roughly +/-9.2e18 / 10^precision saturate.
+	i64 quantized;
+	QuantizeFixed(value, precision, quantized);
+	return quantized;
+}
+
+inline u32
+ToStringQuantized(String& string, i64 quantized, u32 precision)
+{
+	Assert(precision <= MaxNumberPrecision);
+
+	if (quantized == QuantizedNaN)
+		return ToStringChars(string, "nan", 3);
+
+	u32 written = 0;
+	u64 magnitude = (u64) quantized;
+	if (quantized < 0)
+	{
+		written += ToStringChars(string, "-", 1);
+		magnitude = 0 - magnitude;
+	}
+
+	u64 scale = DecimalPowers[precision];
+	written += ToStringUnsigned(string, magnitude / scale);
+	if (precision)
+	{
+		written += ToStringChars(string, ".", 1);
+		written += ToStringUnsigned(string, magnitude % scale, precision);
+	}
+	return written;
+}
+
+inline u32
+ToStringFixed(String& string, r64 value, u32 precision)
+{
+	i64 quantized = QuantizeFixed(value, precision);
+	return ToStringQuantized(string, quantized, precision);
+}
+
+// NOTE: Writes format[first, last) collapsing escaped percent signs ("%%").
+inline u32
+ToStringLiteral(String& string, StringView format, u32 first, u32 last)
+{
+	u32 written  = 0;
+	u32 runStart = first;
+	for (u32 i = first; i < last; i++)
+	{
+		if (format.data[i] == '%' && i + 1 < last && format.data[i + 1] == '%')
+		{
+			written += ToStringChars(string, &format.data[runStart], i + 1 - runStart);
+			runStart = i + 2;
+			i++;
+		}
+	}
+	written += ToStringChars(string, &format.data[runStart], last - runStart);
+	return written;
+}
+
+// NOTE: Supports printf style "%d", "%i", "%u", "%f", and "%.Nf" with literal text around it.
+// Returns a format with kind Null if the format isn't supported.
+inline NumberFormat
+NumberFormat_Parse(StringView format)
+{
+	NumberFormat result = {};
+
+	for (u32 i = 0; i < format.length; i++)
+	{
+		if (format.data[i] != '%') continue;
+
+		// Escaped percent sign
+		if (i + 1 < format.length && format.data[i + 1] == '%')
+		{
+			i++;
+			continue;
+		}
+
+		// Only a single placeholder is supported
+		if (result.kind != NumberKind::Null) return {};
+
+		u32 j = i + 1;
+		u32 precision = 6;
+		if (j < format.length && format.data[j] == '.')
+		{
+			precision = 0;
+			for (j++; j < format.length && format.data[j] >= '0' && format.data[j] <= '9'; j++)
+			{
+				precision = 10 * precision + (u32) (format.data[j] - '0');
+				if (precision > MaxNumberPrecision) return {};
+			}
+		}
+		if (j >= format.length) return {};
+
+		switch (format.data[j])
+		{
+			default: return {};
+
+			case 'd':
+			case 'i':
+			case 'u':
+				result.kind      = NumberKind::Integer;
+				result.precision = 0;
+				break;
+
+			case 'f':
+				result.kind      = NumberKind::Fixed;
+				result.precision = (u8) precision;
+				break;
+		}
+
+		result.prefixLength = i;
+		result.suffixIndex  = j + 1;
+		i = j;
+	}
+
+	return result;
+}
+
+inline u32
+ToStringNumber(String& string, StringView format, NumberFormat numberFormat, i64 quantized)
+{
+	Assert(numberFormat.kind != NumberKind::Null);
+
+	u32 written = 0;
+	written += ToStringLiteral(string, format, 0, numberFormat.prefixLength);
+	written += ToStringQuantized(string, quantized, numberFormat.precision);
+	written += ToStringLiteral(string, format, numberFormat.suffixIndex, format.length);
+	return written;
+}
+
+// NOTE: Overwrites the contents of string. Only allocates if string isn't already large enough.
+inline void
+String_FormatNumber(String& string, StringView format, NumberFormat numberFormat, i64 quantized)
+{
+	String_Reserve(string, format.length + MaxNumberLength + 1);
+	string.length  = 0;
+	string.data[0] = '\0';
+	ToStringNumber(string, format, numberFormat, quantized);
+}
+
 // -------------------------------------------------------------------------------------------------
 // Primitive ToString Implementations
 
@@ -309,20 +589,34 @@ ToStringf(String& string, StringView format, T value)
 }
 
 // TODO: Might want to add a 'context' parameter that can keep track of nested indentation
-u32 ToString(String& string, u8        value) { return ToStringf(string, "%hu",  value); }
-u32 ToString(String& string, u16       value) { return ToStringf(string, "%u",   value); }
-u32 ToString(String& string, u32       value) { return ToStringf(string, "%lu",  value); }
-u32 ToString(String& string, u64       value) { return ToStringf(string, "%llu", value); }
-u32 ToString(String& string, i8        value) { return ToStringf(string, "%hi",  value); }
-u32 ToString(String& string, i16       value) { return ToStringf(string, "%i",   value); }
-u32 ToString(String& string, i32       value) { return ToStringf(string, "%li",  value); }
-u32 ToString(String& string, i64       value) { return ToStringf(string, "%lli", value); }
-u32 ToString(String& string, r32       value) { return ToStringf(string, "%f",   value); }
-u32 ToString(String& string, r64       value) { return ToStringf(string, "%f",   value); }
+u32 ToString(String& string, u8        value) { return ToStringUnsigned(string, value); }
+u32 ToString(String& string, u16       value) { return ToStringUnsigned(string, value); }
+u32 ToString(String& string, u32       value) { return ToStringUnsigned(string, value); }
+u32 ToString(String& string, u64       value) { return ToStringUnsigned(string, value); }
+u32 ToString(String& string, i8        value) { return ToStringSigned(string, value); }
+u32 ToString(String& string, i16       value) { return ToStringSigned(string, value); }
+u32 ToString(String& string, i32       value) { return ToStringSigned(string, value); }
+u32 ToString(String& string, i64       value) { return ToStringSigned(string, value); }
 u32 ToString(String& string, c8        value) { return ToStringf(string, "%c",   value); }
 u32 ToString(String& string, const c8* value) { return ToStringf(string, "%s",   value); }
 u32 ToString(String& string, b8        value) { return ToStringf(string, "%s",   value ? "true" : "false"); }
 
+u32
+ToString(String& string, r64 value)
+{
+	// NOTE: Matches "%f". Huge values and infinities fall back to the C runtime.
+	i64 quantized;
+	b8 inRange = QuantizeFixed(value, 6, quantized);
+	if (!inRange) return ToStringf(string, "%f", value);
+	return ToStringQuantized(string, quantized, 6);
+}
+
+u32
+ToString(String& string, r32 value)
+{
+	return ToString(string, (r64) value);
+}
+
 u32
 ToString(String& string, String value)
 {
@@ -40,7 +40,8 @@ struct WidgetAPI
 		r32                        t;
 		Slice<Widget>              widgets;
 		ByteSlice                  widgetsUserData;
-		Slice<Sensor>              sensors;
+		Slice<r32>                 sensorValues; // NOTE: sensorValues[i] is the value of widgets[i].sensorHandle
+		Slice<Matrix>              wvps;         // NOTE: wvps[i] is WidgetWorldMatrix(widgets[i]) * view * projection
 		GetSensorFn*               GetSensor;
 		GetViewMatrixFn*           GetViewMatrix;
 		GetProjectionMatrixFn*     GetProjectionMatrix;
@@ -117,6 +118,15 @@ WidgetPosition(Widget widget)
 	return result;
 }
 
+inline Matrix
+WidgetWorldMatrix(Widget widget)
+{
+	Matrix result = Identity();
+	SetPosition(result, WidgetPosition(widget), -widget.depth);
+	SetScale   (result, widget.size, 1.0f);
+	return result;
+}
+
 inline v4
 WidgetRect(Widget widget)
 {
@@ -11,6 +11,20 @@ enum struct Signal : u8
 	High = 0b1,
 };
 
+// NOTE: "Requested" is what every call would have cost if it were written straight through.
+// "Emitted" is what actually went out over USB.
+struct FT232HProgramStats
+{
+	u64 requestedBytes;
+	u64 emittedBytes;
+	u32 requestedWrites;
+	u32 emittedWrites;
+	u32 requestedPinWrites;
+	u32 emittedPinWrites;
+	u32 requestedSends;
+	u32 emittedSends;
+};
+
 b8     FT232H_Initialize          (FT232HState&);
 void   FT232H_Teardown            (FT232HState&);
 
@@ -20,9 +34,11 @@ b8     FT232H_HasError            (FT232HState&);
 
 void   FT232H_Write               (FT232HState&, ByteSlice bytes);
 void   FT232H_WriteImmediate      (FT232HState&, ByteSlice bytes);
+void   FT232H_WriteSegments       (FT232HState&, Slice<ByteSlice> segments);
 void   FT232H_Flush               (FT232HState&);
 void   FT232H_Read                (FT232HState&, Bytes& bytes, u16 numBytesToRead);
 void   FT232H_SendBytes           (FT232HState&, ByteSlice bytes);
+u8*    FT232H_AllocateScratch     (FT232HState&, u32 size);
 void   FT232H_RecvBytes           (FT232HState&, Bytes& bytes, u16 numBytesToRead);
 
 u32    FT232H_SetClockSpeed       (FT232HState&, u32 hz);
@@ -40,3 +56,7 @@ void   FT232H_BeginSPI            (FT232HState&);
 void   FT232H_EndSPI              (FT232HState&);
 void   FT232H_BeginSPIDeferred    (FT232HState&);
 void   FT232H_EndSPIDeferred      (FT232HState&);
+void   FT232H_BeginProgram        (FT232HState&);
+void   FT232H_EndProgram          (FT232HState&);
+
+FT232HProgramStats FT232H_TakeProgramStats (FT232HState&);
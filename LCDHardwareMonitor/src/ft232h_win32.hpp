@@ -1,6 +1,15 @@
 #include "ftd2xx.h"
 #pragma comment(lib, "ftd2xx.lib")
 
+// NOTE: A piece of a deferred write. Commands and small payloads are copied into pendingCommands and
+// refer to it by offset since it can move as it grows. Larger payloads point at the caller's memory.
+struct FT232HSegment
+{
+	u8* data;
+	u32 offset;
+	u32 length;
+};
+
 struct FT232HState
 {
 	DLLState  dllState;
@@ -10,6 +19,7 @@ struct FT232HState
 	b8        enableDebugChecks;
 	b8        inSPITransaction;
 	b8        deferTransaction;
+	b8        inProgram;
 	u8        latency;
 	u32       writeTimeout;
 	u32       readTimeout;
@@ -21,7 +31,22 @@ struct FT232HState
 	u8        lowPinDirections;
 	u8        highPinValues;
 	u8        highPinDirections;
-	Bytes     pendingCommands;
+
+	// NOTE: While deferring, commands are collected into a single buffer and written with one
+	// FT_Write. Pin values above are what callers asked for and the emitted values are what the device
+	// was last told. Pin commands are only added when something is about to be clocked out, so
+	// changes that cancel out (e.g. CS going high then low between transactions) never reach the
+	// device. Consecutive SendBytes extend the open header instead of starting a new one.
+	Bytes               pendingCommands;
+	List<FT232HSegment> pendingSegments;
+	List<ByteSlice>     writeSegments;
+	Bytes               staging;
+	List<Bytes>         scratch;
+	u32                 scratchUsed;
+	u32                 pendingSendHeader;
+	u8                  lowPinValuesEmitted;
+	u8                  highPinValuesEmitted;
+	FT232HProgramStats  programStats;
 };
 
 namespace FT232H
@@ -31,6 +56,10 @@ namespace FT232H
 	static const u32   ClockSpeedMax = 30'000'000;
 	static const u32   ClockSpeedMin = u32(457.763);
 
+	// NOTE: Deferred payloads smaller than this are copied. A reference is only worth it once the copy
+	// costs more than tracking another segment.
+	static const u32   MinReferenceBytes = 256;
+
 	struct LowPins
 	{
 		static const u8 CLKBit = 0;
@@ -86,7 +115,176 @@ static void
 EnterErrorMode(FT232HState& ft232h)
 {
 	ft232h.errorMode = true;
-	List_Clear(ft232h.pendingCommands);
+	ft232h.pendingSendHeader = u32Max;
+	ft232h.pendingCommands.length = 0;
+	ft232h.pendingSegments.length = 0;
+}
+
+static b8
+IsDeferred(FT232HState& ft232h)
+{
+	return ft232h.deferTransaction || ft232h.inProgram;
+}
+
+// NOTE: Copies bytes into pendingCommands, extending the last segment if it ends there
+static void
+DeferCopy(FT232HState& ft232h, ByteSlice bytes)
+{
+	Bytes&               pending  = ft232h.pendingCommands;
+	List<FT232HSegment>& segments = ft232h.pendingSegments;
+
+	b8 extend = segments.length != 0;
+	if (extend)
+	{
+		FT232HSegment& last = segments[segments.length - 1];
+		extend = !last.data && last.offset + last.length == pending.length;
+	}
+
+	if (!extend)
+	{
+		FT232HSegment& segment = List_Append(segments);
+		segment.data   = nullptr;
+		segment.offset = pending.length;
+		segment.length = 0;
+	}
+
+	segments[segments.length - 1].length += bytes.length;
+	List_AppendRange(pending, bytes);
+}
+
+// NOTE: bytes must stay valid until the next flush
+static void
+DeferReference(FT232HState& ft232h, ByteSlice bytes)
+{
+	if (bytes.length < FT232H::MinReferenceBytes)
+	{
+		DeferCopy(ft232h, bytes);
+		return;
+	}
+
+	FT232HSegment& segment = List_Append(ft232h.pendingSegments);
+	segment.data   = bytes.data;
+	segment.offset = 0;
+	segment.length = bytes.length;
+}
+
+static void
+WriteDevice(FT232HState& ft232h, ByteSlice bytes)
+{
+	u32 bytesWritten;
+	FT_STATUS status = FT_Write(ft232h.device, bytes.data, bytes.length, (DWORD*) &bytesWritten);
+	LOG_IF(status != FT_OK, EnterErrorMode(ft232h); return,
+		Severity::Error, "Failed to write to device: %", status);
+	Assert(bytesWritten == bytes.length);
+
+	ft232h.programStats.emittedBytes += bytes.length;
+	ft232h.programStats.emittedWrites++;
+
+	if (ft232h.enableTracing)
+		Bytes_Print("write", bytes);
+}
+
+static void
+WriteRaw(FT232HState& ft232h, ByteSlice bytes)
+{
+	if (IsDeferred(ft232h))
+	{
+		DeferCopy(ft232h, bytes);
+		ft232h.pendingSendHeader = u32Max;
+
+		if (ft232h.enableTracing)
+			Bytes_Print("queue", bytes);
+	}
+	else
+	{
+		FT232H_WriteImmediate(ft232h, bytes);
+	}
+}
+
+static void
+EmitPins(FT232HState& ft232h)
+{
+	if (ft232h.lowPinValuesEmitted != ft232h.lowPinValues)
+	{
+		ft232h.lowPinValuesEmitted = ft232h.lowPinValues;
+		ft232h.programStats.emittedPinWrites++;
+
+		u8 pinCmd[] = { FT232H::Command::SetDataBitsLowByte, ft232h.lowPinValues, ft232h.lowPinDirections };
+		WriteRaw(ft232h, pinCmd);
+	}
+
+	if (ft232h.highPinValuesEmitted != ft232h.highPinValues)
+	{
+		ft232h.highPinValuesEmitted = ft232h.highPinValues;
+		ft232h.programStats.emittedPinWrites++;
+
+		u8 pinCmd[] = { FT232H::Command::SetDataBitsHighByte, ft232h.highPinValues, ft232h.highPinDirections };
+		WriteRaw(ft232h, pinCmd);
+	}
+}
+
+static void
+SetPins(FT232HState& ft232h, u8& pinValues, u8 newValues)
+{
+	if (pinValues == newValues) return;
+	pinValues = newValues;
+
+	ft232h.programStats.requestedBytes += 3;
+	ft232h.programStats.requestedWrites++;
+	ft232h.programStats.requestedPinWrites++;
+
+	if (!IsDeferred(ft232h))
+		EmitPins(ft232h);
+}
+
+// NOTE: Appends to the open SendBytes header if there is one, otherwise starts a new one. Pixel data
+// for a full frame is larger than a single header allows so it still ends up split at MaxSendBytes.
+// Only the header is copied for large payloads.
+static void
+DeferSendBytes(FT232HState& ft232h, ByteSlice bytes)
+{
+	Bytes& pending = ft232h.pendingCommands;
+
+	u32 chunkCount = (bytes.length + FT232H::MaxSendBytes - 1) / FT232H::MaxSendBytes;
+	ft232h.programStats.requestedBytes  += bytes.length + 3 * chunkCount;
+	ft232h.programStats.requestedWrites += 2 * chunkCount;
+	ft232h.programStats.requestedSends  += chunkCount;
+
+	u32 remainingLen = bytes.length;
+	while (remainingLen > 0)
+	{
+		u32 sendLen = FT232H::MaxSendBytes;
+		if (ft232h.pendingSendHeader != u32Max)
+		{
+			u8* header = &pending.data[ft232h.pendingSendHeader];
+			sendLen = (u32) (header[1] | (header[2] << 8)) + 1;
+		}
+
+		if (sendLen == FT232H::MaxSendBytes)
+		{
+			// NOTE: LCD reads on the rising edge so write on the falling edge
+			u8 ftcmd[] = { FT232H::Command::SendBytesFallingMSB, 0, 0 };
+			DeferCopy(ft232h, ftcmd);
+			ft232h.pendingSendHeader = pending.length - ArrayLength(ftcmd);
+			ft232h.programStats.emittedSends++;
+			sendLen = 0;
+		}
+
+		ByteSlice chunk = {};
+		chunk.data   = &bytes.data[bytes.length - remainingLen];
+		chunk.length = Min(remainingLen, FT232H::MaxSendBytes - sendLen);
+		chunk.stride = 1;
+		DeferReference(ft232h, chunk);
+		remainingLen -= chunk.length;
+
+		u16 numBytesEnc = (u16) (sendLen + chunk.length - 1);
+		u8* header = &pending.data[ft232h.pendingSendHeader];
+		header[1] = GetByte(0, numBytesEnc);
+		header[2] = GetByte(1, numBytesEnc);
+
+		if (ft232h.enableTracing)
+			Bytes_Print("queue", chunk);
+	}
 }
 
 // NOTE: Be *super* careful with sprinkling this around. It will trash performance in a hurry
@@ -240,33 +438,11 @@ FT232H_Write(FT232HState& ft232h, ByteSlice bytes)
 {
 	if (ft232h.errorMode) return;
 
-	if (ft232h.deferTransaction)
-	{
-		if (bytes.length <= ft232h.pendingCommands.capacity - ft232h.pendingCommands.length)
-		{
-			List_AppendRange(ft232h.pendingCommands, bytes);
-
-			if (ft232h.enableTracing)
-				Bytes_Print("queue", bytes);
-		}
-		else if (bytes.length < ft232h.pendingCommands.capacity)
-		{
-			FT232H_Flush(ft232h);
-			List_AppendRange(ft232h.pendingCommands, bytes);
+	ft232h.programStats.requestedBytes += bytes.length;
+	ft232h.programStats.requestedWrites++;
 
-			if (ft232h.enableTracing)
-				Bytes_Print("queue", bytes);
-		}
-		else
-		{
-			FT232H_Flush(ft232h);
-			FT232H_WriteImmediate(ft232h, bytes);
-		}
-	}
-	else
-	{
-		FT232H_WriteImmediate(ft232h, bytes);
-	}
+	EmitPins(ft232h);
+	WriteRaw(ft232h, bytes);
 }
 
 void
@@ -277,38 +453,81 @@ FT232H_WriteImmediate(FT232HState& ft232h, ByteSlice bytes)
 	Assert(ft232h.pendingCommands.length == 0);
 	if (ft232h.errorMode) return;
 
-	u32 bytesWritten;
-	FT_STATUS status = FT_Write(ft232h.device, bytes.data, bytes.length, (DWORD*) &bytesWritten);
-	LOG_IF(status != FT_OK, EnterErrorMode(ft232h); return,
-		Severity::Error, "Failed to write to device: %", status);
-	Assert(bytesWritten == bytes.length);
+	WriteDevice(ft232h, bytes);
+}
 
-	if (ft232h.enableTracing)
-		Bytes_Print("write", bytes);
+// NOTE: D2XX doesn't have a vectored write, so more than one segment is gathered into a staging buffer
+// and written at once. Writing each segment separately would cost a USB transaction apiece.
+void
+FT232H_WriteSegments(FT232HState& ft232h, Slice<ByteSlice> segments)
+{
+	Assert(segments.length != 0);
+	Assert(ft232h.pendingSegments.length == 0);
+	if (ft232h.errorMode) return;
+
+	if (segments.length == 1)
+	{
+		FT232H_WriteImmediate(ft232h, segments[0]);
+		return;
+	}
+
+	Bytes& staging = ft232h.staging;
+	staging.length = 0;
+	for (u32 i = 0; i < segments.length; i++)
+	{
+		Assert(!Slice_IsSparse(segments[i]));
+		List_AppendRange(staging, segments[i]);
+	}
+
+	WriteDevice(ft232h, staging);
 }
 
 void
 FT232H_Flush(FT232HState& ft232h)
 {
 	if (ft232h.errorMode) return;
-	if (ft232h.pendingCommands.length == 0) return;
+
+	EmitPins(ft232h);
+	if (ft232h.pendingSegments.length == 0)
+	{
+		ft232h.scratchUsed = 0;
+		return;
+	}
 
 	if (ft232h.enableTracing)
 		Platform_Print("flush\n");
 
-	Bytes bytes = ft232h.pendingCommands;
+	// NOTE: Resolve offsets now that pendingCommands is done growing
+	List<ByteSlice>& writeSegments = ft232h.writeSegments;
+	writeSegments.length = 0;
+	for (u32 i = 0; i < ft232h.pendingSegments.length; i++)
+	{
+		FT232HSegment& segment = ft232h.pendingSegments[i];
+
+		ByteSlice& slice = List_Append(writeSegments);
+		slice.data   = segment.data ? segment.data : &ft232h.pendingCommands.data[segment.offset];
+		slice.length = segment.length;
+		slice.stride = 1;
+	}
+
+	// NOTE: The data isn't touched when the lengths are reset so it's fine to write after
 	ft232h.pendingCommands.length = 0;
-	FT232H_WriteImmediate(ft232h, bytes);
-	List_Clear(bytes);
+	ft232h.pendingSegments.length = 0;
+	ft232h.pendingSendHeader = u32Max;
+	FT232H_WriteSegments(ft232h, writeSegments);
+	ft232h.scratchUsed = 0;
 }
 
+// NOTE: Flushes first, even in a program, since the commands that produce the response have to
+// reach the device before it can be read
 void
 FT232H_Read(FT232HState& ft232h, Bytes& bytes, u16 numBytesToRead)
 {
 	Assert(numBytesToRead != 0);
-	Assert(ft232h.pendingCommands.length == 0);
 	if (ft232h.errorMode) return;
 
+	FT232H_Flush(ft232h);
+
 	FT_STATUS status;
 
 	if (ft232h.enableDebugChecks)
@@ -352,6 +571,13 @@ FT232H_SendBytes(FT232HState& ft232h, ByteSlice bytes)
 	Assert(bytes.length != 0);
 	if (ft232h.errorMode) return;
 
+	if (IsDeferred(ft232h))
+	{
+		EmitPins(ft232h);
+		DeferSendBytes(ft232h, bytes);
+		return;
+	}
+
 	u32 remainingLen = bytes.length;
 	while (remainingLen > 0)
 	{
@@ -366,6 +592,9 @@ FT232H_SendBytes(FT232HState& ft232h, ByteSlice bytes)
 		FT232H_Write(ft232h, ftcmd);
 		FT232H_Write(ft232h, chunk);
 		remainingLen -= chunk.length;
+
+		ft232h.programStats.requestedSends++;
+		ft232h.programStats.emittedSends++;
 	}
 }
 
@@ -380,10 +609,27 @@ FT232H_RecvBytes(FT232HState& ft232h, Bytes& bytes, u16 numBytesToRead)
 	u8 ftcmd[] = { FT232H::Command::RecvBytesRisingMSB, UnpackLSB2(numBytesEnc) };
 
 	FT232H_Write(ft232h, ftcmd);
-	FT232H_Flush(ft232h);
 	FT232H_Read(ft232h, bytes, numBytesToRead);
 }
 
+// NOTE: Memory for data passed to SendBytes that would otherwise go out of scope before a deferred
+// send is flushed. It stays valid until the next flush. Buffers are kept and reused.
+u8*
+FT232H_AllocateScratch(FT232HState& ft232h, u32 size)
+{
+	// NOTE: Nothing can still reference scratch memory if nothing is pending
+	if (ft232h.pendingSegments.length == 0)
+		ft232h.scratchUsed = 0;
+
+	if (ft232h.scratchUsed == ft232h.scratch.length)
+		List_Append(ft232h.scratch);
+
+	Bytes& buffer = ft232h.scratch[ft232h.scratchUsed++];
+	List_Reserve(buffer, size);
+	buffer.length = size;
+	return buffer.data;
+}
+
 void
 FT232H_SetCLK(FT232HState& ft232h, Signal signal)
 {
@@ -394,13 +640,7 @@ FT232H_SetCLK(FT232HState& ft232h, Signal signal)
 
 	Assert(signal == Signal::Low || signal == Signal::High);
 	u8 newValues = SetBit(ft232h.lowPinValues, FT232H::LowPins::CLKBit, (u8) signal);
-
-	if (ft232h.lowPinValues != newValues)
-	{
-		ft232h.lowPinValues = newValues;
-		u8 pinInitCmd[] = { FT232H::Command::SetDataBitsLowByte, ft232h.lowPinValues, ft232h.lowPinDirections };
-		FT232H_Write(ft232h, pinInitCmd);
-	}
+	SetPins(ft232h, ft232h.lowPinValues, newValues);
 }
 
 void
@@ -413,13 +653,7 @@ FT232H_SetDO(FT232HState& ft232h, Signal signal)
 
 	Assert(signal == Signal::Low || signal == Signal::High);
 	u8 newValues = SetBit(ft232h.lowPinValues, FT232H::LowPins::DOBit, (u8) signal);
-
-	if (ft232h.lowPinValues != newValues)
-	{
-		ft232h.lowPinValues = newValues;
-		u8 pinInitCmd[] = { FT232H::Command::SetDataBitsLowByte, ft232h.lowPinValues, ft232h.lowPinDirections };
-		FT232H_Write(ft232h, pinInitCmd);
-	}
+	SetPins(ft232h, ft232h.lowPinValues, newValues);
 }
 
 void
@@ -432,13 +666,7 @@ FT232H_SetCS(FT232HState& ft232h, Signal signal)
 
 	Assert(signal == Signal::Low || signal == Signal::High);
 	u8 newValues = SetBit(ft232h.highPinValues, FT232H::HighPins::CSBit, (u8) signal);
-
-	if (ft232h.highPinValues != newValues)
-	{
-		ft232h.highPinValues = newValues;
-		u8 pinInitCmd[] = { FT232H::Command::SetDataBitsHighByte, ft232h.highPinValues, ft232h.highPinDirections };
-		FT232H_Write(ft232h, pinInitCmd);
-	}
+	SetPins(ft232h, ft232h.highPinValues, newValues);
 }
 
 void
@@ -451,13 +679,7 @@ FT232H_SetDC(FT232HState& ft232h, Signal signal)
 
 	Assert(signal == Signal::Low || signal == Signal::High);
 	u8 newValues = SetBit(ft232h.highPinValues, FT232H::HighPins::DCBit, (u8) signal);
-
-	if (ft232h.highPinValues != newValues)
-	{
-		ft232h.highPinValues = newValues;
-		u8 pinInitCmd[] = { FT232H::Command::SetDataBitsHighByte, ft232h.highPinValues, ft232h.highPinDirections };
-		FT232H_Write(ft232h, pinInitCmd);
-	}
+	SetPins(ft232h, ft232h.highPinValues, newValues);
 }
 
 Signal
@@ -531,7 +753,7 @@ FT232H_EndSPIDeferred(FT232HState& ft232h)
 	FT232H_SetCS(ft232h, Signal::High);
 	FT232H_SetDO(ft232h, Signal::Low);
 	FT232H_SetCLK(ft232h, Signal::Low);
-	FT232H_Flush(ft232h);
+	if (!ft232h.inProgram) FT232H_Flush(ft232h);
 	ft232h.inSPITransaction = false;
 	ft232h.deferTransaction = false;
 
@@ -539,6 +761,38 @@ FT232H_EndSPIDeferred(FT232HState& ft232h)
 		Platform_Print("end spi deferred\n");
 }
 
+// NOTE: Everything between Begin and End is collected and written with a single FT_Write. Reads
+// flush (see FT232H_Read) since the response is needed right away. Callers that need to wait on the
+// device (e.g. sleeping after a reset) must flush first.
+void
+FT232H_BeginProgram(FT232HState& ft232h)
+{
+	if (ft232h.enableTracing)
+		Platform_Print("begin program\n");
+
+	Assert(!ft232h.inProgram);
+	ft232h.inProgram = true;
+}
+
+void
+FT232H_EndProgram(FT232HState& ft232h)
+{
+	Assert(ft232h.inProgram);
+	FT232H_Flush(ft232h);
+	ft232h.inProgram = false;
+
+	if (ft232h.enableTracing)
+		Platform_Print("end program\n");
+}
+
+FT232HProgramStats
+FT232H_TakeProgramStats(FT232HState& ft232h)
+{
+	FT232HProgramStats result = ft232h.programStats;
+	ft232h.programStats = {};
+	return result;
+}
+
 // TODO: Maybe speed should be a double?
 u32
 FT232H_SetClockSpeed(FT232HState& ft232h, u32 hz)
@@ -588,6 +842,7 @@ FT232H_Initialize(FT232HState& ft232h)
 		return false;
 
 	List_Reserve(ft232h.pendingCommands, FT232H::MaxSendBytes);
+	ft232h.pendingSendHeader = u32Max;
 
 	// NOTE: Device list only updates when calling this function
 	u32 deviceCount;
@@ -708,12 +963,14 @@ FT232H_Initialize(FT232HState& ft232h)
 	// Pin 2: DI, DO, CLK
 	ft232h.lowPinValues     = 0b0000'0000;
 	ft232h.lowPinDirections = 0b0000'0011;
+	ft232h.lowPinValuesEmitted = ft232h.lowPinValues;
 	u8 pinInitLCmd[] = { FT232H::Command::SetDataBitsLowByte, ft232h.lowPinValues, ft232h.lowPinDirections };
 	FT232H_Write(ft232h, pinInitLCmd);
 
 	// Pin 2: RST, D/C, CS
 	ft232h.highPinValues     = 0b0000'0011;
 	ft232h.highPinDirections = 0b0000'0011;
+	ft232h.highPinValuesEmitted = ft232h.highPinValues;
 	u8 pinInitHCmd[] = { FT232H::Command::SetDataBitsHighByte, ft232h.highPinValues, ft232h.highPinDirections };
 	FT232H_Write(ft232h, pinInitHCmd);
 
@@ -753,6 +1010,12 @@ FT232H_Teardown(FT232HState& ft232h)
 		Severity::Error, "Failed to close device: %", status);
 
 	List_Free(ft232h.pendingCommands);
+	List_Free(ft232h.pendingSegments);
+	List_Free(ft232h.writeSegments);
+	List_Free(ft232h.staging);
+	for (u32 i = 0; i < ft232h.scratch.length; i++)
+		List_Free(ft232h.scratch[i]);
+	List_Free(ft232h.scratch);
 
 	ft232h = {};
 }
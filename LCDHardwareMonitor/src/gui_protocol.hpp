@@ -1,8 +1,12 @@
 namespace Message
 {
+	// NOTE: id is the type's IdOf hash and type is its index in Messages. The receiver routes on
+	// type and checks id against it, so a mismatched build on the other end is caught rather than
+	// misrouted.
 	struct Header
 	{
-		u32 id;
+		u64 id;
+		u32 type;
 		u32 index;
 		u32 size;
 	};
@@ -19,10 +23,12 @@ namespace ToGUI
 
 	struct Connect
 	{
-		Header header;
-		u32    version;
-		size   renderSurface;
-		v2u    renderSize;
+		Header      header;
+		u32         version;
+		size        renderSurface;
+		v2u         renderSize;
+		PixelFormat lcdPixelFormat;
+		Dither      lcdDither;
 	};
 
 	struct Disconnect
@@ -53,6 +59,15 @@ namespace ToGUI
 	{
 		Header        header;
 		Slice<Sensor> sensors;
+		Slice<r32>    values;
+	};
+
+	// NOTE: Only sensors whose value changed since the last send are included
+	struct SensorValuesChanged
+	{
+		Header                header;
+		Slice<Handle<Sensor>> handles;
+		Slice<r32>            values;
 	};
 
 	// TODO: WidgetTypesRemoved
@@ -159,15 +174,99 @@ namespace FromGUI
 		Header                header;
 		Slice<Handle<Widget>> handles;
 	};
+
+	struct SetLCDPixelFormat
+	{
+		Header      header;
+		PixelFormat format;
+		Dither      dither;
+	};
 }
 
 template<>
-constexpr u32 IdOf<Message::Null> = 0;
+constexpr u64 IdOf<Message::Null> = 0;
+
+// -------------------------------------------------------------------------------------------------
+// Message Registry
+
+template<typename... Types>
+struct MessageRegistry
+{
+	static constexpr u32 Count = sizeof...(Types);
+	static constexpr u64 ids[] = { IdOf<Types>... };
+
+	static constexpr b8
+	IdsAreUnique()
+	{
+		for (u32 i = 0; i < Count; i++)
+			for (u32 j = i + 1; j < Count; j++)
+				if (ids[i] == ids[j]) return false;
+		return true;
+	}
+
+	// NOTE: Ids are unique so matching on them is the same as matching on the type
+	template<typename T>
+	static constexpr u32
+	IndexOf()
+	{
+		for (u32 i = 0; i < Count; i++)
+			if (ids[i] == IdOf<T>) return i;
+		return Count;
+	}
+
+	static inline b8
+	IsValid(const Message::Header& header)
+	{
+		return header.type < Count && ids[header.type] == header.id;
+	}
+};
+
+// NOTE: Every message in both directions. Adding a message type means adding it here.
+using Messages = MessageRegistry<
+	Message::Null,
+	ToGUI::Connect,
+	ToGUI::Disconnect,
+	ToGUI::PluginsAdded,
+	ToGUI::PluginStatesChanged,
+	ToGUI::SensorsAdded,
+	ToGUI::SensorValuesChanged,
+	ToGUI::WidgetTypesAdded,
+	ToGUI::WidgetsAdded,
+	ToGUI::WidgetSelectionChanged,
+	FromGUI::TerminateSimulation,
+	FromGUI::SetPluginLoadStates,
+	FromGUI::MouseMove,
+	FromGUI::SelectHovered,
+	FromGUI::BeginMouseLook,
+	FromGUI::EndMouseLook,
+	FromGUI::ResetCamera,
+	FromGUI::DragDrop,
+	FromGUI::AddWidget,
+	FromGUI::RemoveWidget,
+	FromGUI::RemoveSelectedWidgets,
+	FromGUI::BeginDragSelection,
+	FromGUI::EndDragSelection,
+	FromGUI::SetWidgetSelection,
+	FromGUI::SetLCDPixelFormat>;
+
+static_assert(Messages::IdsAreUnique(), "Two message types have the same IdOf hash");
+
+template<typename T>
+constexpr u32 MessageTypeOf = Messages::IndexOf<T>();
+
+// NOTE: One handler per entry in Messages, indexed by Header::type. Handlers for messages that
+// flow the other way are left null.
+template<typename State>
+struct MessageTable
+{
+	using HandlerFn = void(State&, Bytes&);
+
+	HandlerFn* handlers[Messages::Count];
+};
 
 enum struct ByteStreamMode
 {
 	Null,
-	Size,
 	Read,
 	Write,
 };
@@ -179,6 +278,10 @@ struct ByteStream
 	Bytes          bytes;
 };
 
+// NOTE: Both ends must agree on the transport. Shared memory avoids a kernel round trip per message.
+const StringView    GUIPipeName      = "LCDHardwareMonitor GUI Pipe";
+const PipeTransport GUIPipeTransport = PipeTransport::SharedMemory;
+
 struct ConnectionState
 {
 	Pipe        pipe;
@@ -201,12 +304,144 @@ Connection_Teardown(ConnectionState& con)
 	con = {};
 }
 
-// NOTE: There's one small gotcha with this serialization approach. We use
-// Serialize(ByteStream&, T&) to support a pattern where you simply call Serialize for every member
-// of your type and it will serialize properly as long as overloads exist for types that aren't
-// blittable (e.g. contain pointers). Unfortunately, this function signature will match anything
-// so if a necessary overload is missing we'll serialize the data anyway and it will fail somewhere
-// on the receivers side when they try to dereference a pointer that came from the sender.
+// NOTE: A serialized message is the message struct followed by the out-of-line data (slices and
+// strings) it references, in field order. Types with out-of-line data list their fields with
+// FieldsOf and the serializers are generated from that list. Everything else is flat and is copied
+// as is. Each field list is checked against the layout of its type at compile time: every field
+// must be at the offset that follows the previous one and the fields must add up to the size of the
+// type, so a missed, extra, or reordered field is a compile error.
+//
+// A nested type without a field list is copied as is, pointers included. Class types have to be
+// marked with IsPlainData to be copied that way, and SerializeMessage checks every nested type, so
+// one that was missed is a compile error rather than a pointer sent to the other process.
+
+template<typename T>
+struct MemberTraits;
+
+template<typename C, typename F>
+struct MemberTraits<F C::*>
+{
+	using Class = C;
+	using Field = F;
+};
+
+template<auto Member>
+using FieldType = typename MemberTraits<decltype(Member)>::Field;
+
+template<typename T> constexpr b8 IsPlainData                  = !__is_class(T);
+template<typename T> constexpr b8 IsPlainData<T*>              = false;
+template<typename T> constexpr b8 IsPlainData<v2t<T>>          = IsPlainData<T>;
+template<typename T> constexpr b8 IsPlainData<Handle<T>>       = true;
+template<>           constexpr b8 IsPlainData<Message::Header> = true;
+template<>           constexpr b8 IsPlainData<NumberFormat>    = true;
+
+template<typename T>
+struct FieldsOf
+{
+	static constexpr b8 Defined = false;
+	static constexpr b8 Flat    = true;
+
+	static constexpr b8
+	Described()
+	{
+		return IsPlainData<T>;
+	}
+};
+
+// NOTE: Only evaluated from SerializeMessage, after every field list has been declared
+template<typename T> constexpr b8 IsDescribed             = FieldsOf<T>::Described();
+template<typename T> constexpr b8 IsDescribed<List<T>>    = IsDescribed<T>;
+template<typename T> constexpr b8 IsDescribed<Slice<T>>   = IsDescribed<T>;
+template<>           constexpr b8 IsDescribed<String>     = true;
+template<>           constexpr b8 IsDescribed<StringView> = true;
+
+template<typename T> constexpr b8 IsFlat             = FieldsOf<T>::Flat;
+template<typename T> constexpr b8 IsFlat<List<T>>    = false;
+template<typename T> constexpr b8 IsFlat<Slice<T>>   = false;
+template<>           constexpr b8 IsFlat<String>     = false;
+template<>           constexpr b8 IsFlat<StringView> = false;
+
+constexpr size
+AlignSize(size value, size alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+// NOTE: Member pointers can't be turned into offsets at compile time, so each field carries its
+// offsetof alongside. Use FIELD to declare them.
+template<auto Member, size Offset>
+struct Field
+{
+	using Class = typename MemberTraits<decltype(Member)>::Class;
+	using Type  = FieldType<Member>;
+
+	static constexpr auto member = Member;
+	static constexpr size offset = Offset;
+};
+
+#define FIELD(Type, member) Field<&Type::member, offsetof(Type, member)>
+
+// NOTE: Each field has to start where the previous one ends, after padding for its own alignment
+template<typename... Fs>
+constexpr b8
+FieldOffsetsMatch()
+{
+	size offset = 0;
+	b8   match  = true;
+	((offset = AlignSize(offset, alignof(typename Fs::Type)),
+	  match  = match && Fs::offset == offset,
+	  offset = offset + sizeof(typename Fs::Type)), ...);
+	return match;
+}
+
+template<typename... Fs>
+constexpr size
+FieldLayoutSize()
+{
+	size offset = 0;
+	((offset = AlignSize(offset, alignof(typename Fs::Type)) + sizeof(typename Fs::Type)), ...);
+	return offset;
+}
+
+template<typename First, typename... Rest>
+struct Fields
+{
+	using Type = typename First::Class;
+
+	static constexpr b8 Defined = true;
+	static constexpr b8 Flat    = (IsFlat<typename First::Type> && ... && IsFlat<typename Rest::Type>);
+
+	static_assert(FieldOffsetsMatch<First, Rest...>(),
+		"Field list is missing a member or lists members out of order");
+	static_assert(AlignSize(FieldLayoutSize<First, Rest...>(), alignof(Type)) == sizeof(Type),
+		"Field list does not cover every member of the type");
+
+	static constexpr b8
+	Described()
+	{
+		return (IsDescribed<typename First::Type> && ... && IsDescribed<typename Rest::Type>);
+	}
+
+	template<typename Fn>
+	static inline void
+	ForEach(Type& value, Fn&& fn)
+	{
+		fn(value.*First::member);
+		(fn(value.*Rest::member), ...);
+	}
+};
+
+template<typename T>
+u32 SerializedSize(T&);
+
+template<typename T>
+u32 SerializedSize(List<T>&);
+
+template<typename T>
+u32 SerializedSize(Slice<T>&);
+
+u32 SerializedSize(String&);
+u32 SerializedSize(StringView&);
 
 template<typename T>
 void Serialize(ByteStream&, T*&&);
@@ -223,19 +458,157 @@ void Serialize(ByteStream&, List<T>&);
 template<typename T>
 void Serialize(ByteStream&, Slice<T>&);
 
-// TODO: String?
+void Serialize(ByteStream&, String&);
 void Serialize(ByteStream&, StringView&);
 
-void Serialize(ByteStream&, ToGUI::PluginsAdded&);
-void Serialize(ByteStream&, ToGUI::PluginStatesChanged&);
-void Serialize(ByteStream&, ToGUI::SensorsAdded&);
-void Serialize(ByteStream&, ToGUI::WidgetTypesAdded&);
-void Serialize(ByteStream&, ToGUI::WidgetsAdded&);
-void Serialize(ByteStream&, ToGUI::WidgetSelectionChanged&);
-void Serialize(ByteStream&, FromGUI::SetPluginLoadStates&);
-void Serialize(ByteStream&, FromGUI::SetWidgetSelection&);
-void Serialize(ByteStream&, PluginInfo&);
-void Serialize(ByteStream&, Sensor&);
+// -------------------------------------------------------------------------------------------------
+// Field Lists
+
+template<>
+struct FieldsOf<ToGUI::Connect> : Fields<
+	FIELD(ToGUI::Connect, header),
+	FIELD(ToGUI::Connect, version),
+	FIELD(ToGUI::Connect, renderSurface),
+	FIELD(ToGUI::Connect, renderSize),
+	FIELD(ToGUI::Connect, lcdPixelFormat),
+	FIELD(ToGUI::Connect, lcdDither)> {};
+
+template<>
+struct FieldsOf<ToGUI::Disconnect> : Fields<
+	FIELD(ToGUI::Disconnect, header)> {};
+
+template<>
+struct FieldsOf<ToGUI::PluginsAdded> : Fields<
+	FIELD(ToGUI::PluginsAdded, header),
+	FIELD(ToGUI::PluginsAdded, handles),
+	FIELD(ToGUI::PluginsAdded, kinds),
+	FIELD(ToGUI::PluginsAdded, infos),
+	FIELD(ToGUI::PluginsAdded, languages)> {};
+
+template<>
+struct FieldsOf<ToGUI::PluginStatesChanged> : Fields<
+	FIELD(ToGUI::PluginStatesChanged, header),
+	FIELD(ToGUI::PluginStatesChanged, handles),
+	FIELD(ToGUI::PluginStatesChanged, kinds),
+	FIELD(ToGUI::PluginStatesChanged, loadStates)> {};
+
+template<>
+struct FieldsOf<ToGUI::SensorsAdded> : Fields<
+	FIELD(ToGUI::SensorsAdded, header),
+	FIELD(ToGUI::SensorsAdded, sensors),
+	FIELD(ToGUI::SensorsAdded, values)> {};
+
+template<>
+struct FieldsOf<ToGUI::SensorValuesChanged> : Fields<
+	FIELD(ToGUI::SensorValuesChanged, header),
+	FIELD(ToGUI::SensorValuesChanged, handles),
+	FIELD(ToGUI::SensorValuesChanged, values)> {};
+
+template<>
+struct FieldsOf<ToGUI::WidgetTypesAdded> : Fields<
+	FIELD(ToGUI::WidgetTypesAdded, header),
+	FIELD(ToGUI::WidgetTypesAdded, handles),
+	FIELD(ToGUI::WidgetTypesAdded, names)> {};
+
+template<>
+struct FieldsOf<ToGUI::WidgetsAdded> : Fields<
+	FIELD(ToGUI::WidgetsAdded, header),
+	FIELD(ToGUI::WidgetsAdded, handles)> {};
+
+template<>
+struct FieldsOf<ToGUI::WidgetSelectionChanged> : Fields<
+	FIELD(ToGUI::WidgetSelectionChanged, header),
+	FIELD(ToGUI::WidgetSelectionChanged, handles)> {};
+
+template<>
+struct FieldsOf<FromGUI::TerminateSimulation> : Fields<
+	FIELD(FromGUI::TerminateSimulation, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::SetPluginLoadStates> : Fields<
+	FIELD(FromGUI::SetPluginLoadStates, header),
+	FIELD(FromGUI::SetPluginLoadStates, handles),
+	FIELD(FromGUI::SetPluginLoadStates, loadStates)> {};
+
+template<>
+struct FieldsOf<FromGUI::MouseMove> : Fields<
+	FIELD(FromGUI::MouseMove, header),
+	FIELD(FromGUI::MouseMove, pos)> {};
+
+template<>
+struct FieldsOf<FromGUI::SelectHovered> : Fields<
+	FIELD(FromGUI::SelectHovered, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::BeginMouseLook> : Fields<
+	FIELD(FromGUI::BeginMouseLook, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::EndMouseLook> : Fields<
+	FIELD(FromGUI::EndMouseLook, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::ResetCamera> : Fields<
+	FIELD(FromGUI::ResetCamera, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::DragDrop> : Fields<
+	FIELD(FromGUI::DragDrop, header),
+	FIELD(FromGUI::DragDrop, pluginKind),
+	FIELD(FromGUI::DragDrop, inProgress)> {};
+
+template<>
+struct FieldsOf<FromGUI::AddWidget> : Fields<
+	FIELD(FromGUI::AddWidget, header),
+	FIELD(FromGUI::AddWidget, handle),
+	FIELD(FromGUI::AddWidget, position)> {};
+
+template<>
+struct FieldsOf<FromGUI::RemoveWidget> : Fields<
+	FIELD(FromGUI::RemoveWidget, header),
+	FIELD(FromGUI::RemoveWidget, handle)> {};
+
+template<>
+struct FieldsOf<FromGUI::RemoveSelectedWidgets> : Fields<
+	FIELD(FromGUI::RemoveSelectedWidgets, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::BeginDragSelection> : Fields<
+	FIELD(FromGUI::BeginDragSelection, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::EndDragSelection> : Fields<
+	FIELD(FromGUI::EndDragSelection, header)> {};
+
+template<>
+struct FieldsOf<FromGUI::SetWidgetSelection> : Fields<
+	FIELD(FromGUI::SetWidgetSelection, header),
+	FIELD(FromGUI::SetWidgetSelection, handles)> {};
+
+template<>
+struct FieldsOf<FromGUI::SetLCDPixelFormat> : Fields<
+	FIELD(FromGUI::SetLCDPixelFormat, header),
+	FIELD(FromGUI::SetLCDPixelFormat, format),
+	FIELD(FromGUI::SetLCDPixelFormat, dither)> {};
+
+template<>
+struct FieldsOf<PluginInfo> : Fields<
+	FIELD(PluginInfo, name),
+	FIELD(PluginInfo, author),
+	FIELD(PluginInfo, version),
+	FIELD(PluginInfo, lhmVersion)> {};
+
+template<>
+struct FieldsOf<Sensor> : Fields<
+	FIELD(Sensor, handle),
+	FIELD(Sensor, name),
+	FIELD(Sensor, identifier),
+	FIELD(Sensor, format),
+	FIELD(Sensor, sensorPluginHandle),
+	FIELD(Sensor, text),
+	FIELD(Sensor, textFormat),
+	FIELD(Sensor, textValue),
+	FIELD(Sensor, guiValue)> {};
 
 inline b8
 MessageTimeLeft(i64 startTicks)
@@ -248,16 +621,22 @@ template<typename T>
 void
 SerializeMessage(Bytes& bytes, T& message, u32 messageIndex)
 {
+	static_assert(FieldsOf<T>::Defined, "Message types must declare a field list");
+	static_assert(FieldsOf<T>::Described(),
+		"A nested type has no field list and isn't marked with IsPlainData");
+
 	ByteStream stream = {};
 	defer { List_Free(stream.bytes); };
 
-	stream.mode = ByteStreamMode::Size;
-	Serialize(stream, &message);
+	// NOTE: Flat data is sized in closed form, only non-flat elements are visited
+	u32 messageSize = sizeof(T) + SerializedSize(message);
+	List_Reserve(stream.bytes, messageSize);
+	stream.bytes.length = messageSize;
 
-	List_Reserve(stream.bytes, stream.cursor);
-	stream.bytes.length = stream.cursor;
+	static_assert(MessageTypeOf<T> < Messages::Count, "Message types must be listed in Messages");
 
 	message.header.id    = IdOf<T>;
+	message.header.type  = MessageTypeOf<T>;
 	message.header.index = messageIndex;
 	message.header.size  = stream.bytes.length;
 
@@ -282,6 +661,27 @@ DeserializeMessage(Bytes& bytes)
 	Serialize(stream, (T*) bytes.data);
 }
 
+template<typename State, typename T, void (*Handler)(State&, T&)>
+void
+MessageHandler(State& s, Bytes& bytes)
+{
+	DeserializeMessage<T>(bytes);
+	Handler(s, (T&) bytes[0]);
+}
+
+// NOTE: ReceiveMessage has already validated the header
+template<typename State>
+void
+DispatchMessage(const MessageTable<State>& table, State& s, Bytes& bytes)
+{
+	Message::Header& header = (Message::Header&) bytes[0];
+
+	typename MessageTable<State>::HandlerFn* handler = table.handlers[header.type];
+	LOG_IF(!handler, return, Severity::Warning, "Received a message with no handler (type %)", header.type);
+
+	handler(s, bytes);
+}
+
 b8
 HandleMessageResult(ConnectionState& con, b8 success)
 {
@@ -332,6 +732,29 @@ SerializeAndQueueMessage(ConnectionState& con, T& message)
 	QueueMessage(con, bytes);
 }
 
+// NOTE: Replaces the last queued message if it's the same type and hasn't been sent yet. Only use
+// this for messages that carry complete state so dropping the older one loses nothing.
+template<typename T>
+void
+SerializeAndReplaceMessage(ConnectionState& con, T& message)
+{
+	if (con.queue.length > con.queueIndex)
+	{
+		Bytes& last = con.queue[con.queue.length - 1];
+		Message::Header& header = (Message::Header&) last[0];
+		if (header.type == MessageTypeOf<T>)
+		{
+			Bytes bytes = {};
+			SerializeMessage(bytes, message, header.index);
+			List_Free(last);
+			last = bytes;
+			return;
+		}
+	}
+
+	SerializeAndQueueMessage(con, message);
+}
+
 b8
 SendMessage(ConnectionState& con)
 {
@@ -379,6 +802,9 @@ ReceiveMessage(ConnectionState& con, Bytes& bytes)
 	LOG_IF(header.index != con.recvIndex, return HandleMessageResult(con, false),
 		Severity::Warning, "Unexpected message received");
 
+	LOG_IF(!Messages::IsValid(header), return HandleMessageResult(con, false),
+		Severity::Warning, "Unknown message type received");
+
 	con.recvIndex++;
 	return true;
 }
@@ -403,9 +829,6 @@ Serialize(ByteStream& stream, T*& pointer)
 			Assert(false);
 			break;
 
-		case ByteStreamMode::Size:
-			break;
-
 		case ByteStreamMode::Read:
 		{
 			// Point to the data appended to the stream
@@ -428,11 +851,58 @@ Serialize(ByteStream& stream, T*& pointer)
 	Serialize(stream, *pointer);
 }
 
+template<typename T>
+u32
+SerializedSize(T& value)
+{
+	u32 result = 0;
+	if constexpr (!IsFlat<T>)
+		FieldsOf<T>::ForEach(value, [&](auto& field) { result += SerializedSize(field); });
+	Unused(value);
+	return result;
+}
+
+template<typename T>
+u32
+SerializedSize(List<T>& list)
+{
+	u32 result = List_SizeOf(list);
+	if constexpr (!IsFlat<T>)
+		for (u32 i = 0; i < list.length; i++)
+			result += SerializedSize(list[i]);
+	return result;
+}
+
+template<typename T>
+u32
+SerializedSize(Slice<T>& slice)
+{
+	u32 result = Slice_SizeOf(slice);
+	if constexpr (!IsFlat<T>)
+		for (u32 i = 0; i < slice.length; i++)
+			result += SerializedSize(slice[i]);
+	return result;
+}
+
+u32
+SerializedSize(String& string)
+{
+	return string.length + 1;
+}
+
+u32
+SerializedSize(StringView& string)
+{
+	return string.length + 1;
+}
+
 template<typename T>
 void
 Serialize(ByteStream& stream, T& value)
 {
-	// No-op
+	// NOTE: Flat values were already copied along with their parent
+	if constexpr (!IsFlat<T>)
+		FieldsOf<T>::ForEach(value, [&](auto& field) { Serialize(stream, field); });
 	Unused(value, stream);
 }
 
@@ -450,27 +920,25 @@ Serialize(ByteStream& stream, List<T>& list)
 			Assert(false);
 			break;
 
-		case ByteStreamMode::Size:
-			for (u32 i = 0; i < list.length; i++)
-				Serialize(stream, list[i]);
-			break;
-
 		case ByteStreamMode::Read:
 			list.data = data;
-			for (u32 i = 0; i < list.length; i++)
-				Serialize(stream, list[i]);
 			break;
 
 		case ByteStreamMode::Write:
-		{
-			memcpy(data, list.data, List_SizeOf(list));
-			for (u32 i = 0; i < list.length; i++)
-				Serialize(stream, list[i]);
-
-			list.capacity = list.length;
-			list.data     = nullptr;
+			if (list.length)
+				memcpy(data, list.data, List_SizeOf(list));
+			list.data = data;
 			break;
-		}
+	}
+
+	if constexpr (!IsFlat<T>)
+		for (u32 i = 0; i < list.length; i++)
+			Serialize(stream, list[i]);
+
+	if (stream.mode == ByteStreamMode::Write)
+	{
+		list.capacity = list.length;
+		list.data     = nullptr;
 	}
 }
 
@@ -488,32 +956,34 @@ Serialize(ByteStream& stream, Slice<T>& slice)
 			Assert(false);
 			break;
 
-		case ByteStreamMode::Size:
-			for (u32 i = 0; i < slice.length; i++)
-				Serialize(stream, slice[i]);
-			break;
-
 		case ByteStreamMode::Read:
 			slice.data = data;
-			for (u32 i = 0; i < slice.length; i++)
-				Serialize(stream, slice[i]);
 			break;
 
 		case ByteStreamMode::Write:
 		{
-			for (u32 i = 0; i < slice.length; i++)
-				data[i] = slice[i];
+			if (Slice_IsSparse(slice))
+			{
+				for (u32 i = 0; i < slice.length; i++)
+					data[i] = slice[i];
+			}
+			else if (slice.length)
+			{
+				memcpy(data, slice.data, Slice_SizeOf(slice));
+			}
 
 			slice.data   = data;
 			slice.stride = sizeof(T);
-
-			for (u32 i = 0; i < slice.length; i++)
-				Serialize(stream, slice[i]);
-
-			slice.data   = nullptr;
 			break;
 		}
 	}
+
+	if constexpr (!IsFlat<T>)
+		for (u32 i = 0; i < slice.length; i++)
+			Serialize(stream, slice[i]);
+
+	if (stream.mode == ByteStreamMode::Write)
+		slice.data = nullptr;
 }
 
 void
@@ -529,9 +999,6 @@ Serialize(ByteStream& stream, String& string)
 			Assert(false);
 			break;
 
-		case ByteStreamMode::Size:
-			break;
-
 		case ByteStreamMode::Read:
 			string.data = data;
 			break;
@@ -563,9 +1030,6 @@ Serialize(ByteStream& stream, StringView& string)
 			Assert(false);
 			break;
 
-		case ByteStreamMode::Size:
-			break;
-
 		case ByteStreamMode::Read:
 			string.data = data;
 			break;
@@ -583,87 +1047,3 @@ Serialize(ByteStream& stream, StringView& string)
 			break;
 	}
 }
-
-void
-Serialize(ByteStream& stream, ToGUI::PluginsAdded& pluginsAdded)
-{
-	Serialize(stream, pluginsAdded.header);
-	Serialize(stream, pluginsAdded.handles);
-	Serialize(stream, pluginsAdded.kinds);
-	Serialize(stream, pluginsAdded.infos);
-	Serialize(stream, pluginsAdded.languages);
-}
-
-void
-Serialize(ByteStream& stream, ToGUI::PluginStatesChanged& statesChanged)
-{
-	Serialize(stream, statesChanged.header);
-	Serialize(stream, statesChanged.handles);
-	Serialize(stream, statesChanged.kinds);
-	Serialize(stream, statesChanged.loadStates);
-}
-
-void
-Serialize(ByteStream& stream, FromGUI::SetPluginLoadStates& pluginloadStates)
-{
-	Serialize(stream, pluginloadStates.header);
-	Serialize(stream, pluginloadStates.handles);
-	Serialize(stream, pluginloadStates.loadStates);
-}
-
-void
-Serialize(ByteStream& stream, FromGUI::SetWidgetSelection& widgetSelection)
-{
-	Serialize(stream, widgetSelection.header);
-	Serialize(stream, widgetSelection.handles);
-}
-
-void
-Serialize(ByteStream& stream, PluginInfo& pluginInfo)
-{
-	Serialize(stream, pluginInfo.name);
-	Serialize(stream, pluginInfo.author);
-	Serialize(stream, pluginInfo.version);
-}
-
-void
-Serialize(ByteStream& stream, ToGUI::SensorsAdded& sensorsAdded)
-{
-	Serialize(stream, sensorsAdded.header);
-	Serialize(stream, sensorsAdded.sensors);
-}
-
-void
-Serialize(ByteStream& stream, Sensor& sensor)
-{
-	Serialize(stream, sensor.handle);
-	Serialize(stream, sensor.name);
-	Serialize(stream, sensor.identifier);
-	Serialize(stream, sensor.format);
-	Serialize(stream, sensor.value);
-}
-
-void
-Serialize(ByteStream& stream, ToGUI::WidgetTypesAdded& widgetTypesAdded)
-{
-	Serialize(stream, widgetTypesAdded.header);
-	Serialize(stream, widgetTypesAdded.handles);
-	Serialize(stream, widgetTypesAdded.names);
-}
-
-void
-Serialize(ByteStream& stream, ToGUI::WidgetsAdded& widgetsAdded)
-{
-	Serialize(stream, widgetsAdded.header);
-	Serialize(stream, widgetsAdded.handles);
-}
-
-void
-Serialize(ByteStream& stream, ToGUI::WidgetSelectionChanged& widgetSelection)
-{
-	Serialize(stream, widgetSelection.header);
-	Serialize(stream, widgetSelection.handles);
-}
-
-// TODO: Code gen the actual Serialize functions
-// TODO: Maybe we can catch missed fields by counting bytes from serialize calls?
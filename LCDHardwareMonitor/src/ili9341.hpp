@@ -12,6 +12,8 @@ struct ILI9341State
 	b8    rowColSwap;
 	v2u16 size;
 	b8    drawingFrames;
+
+	PixelFormat pixelFormat;
 };
 
 namespace ILI9341
@@ -233,19 +235,28 @@ ILI9341_MemoryAccessControl(ILI9341State& ili9341)
 }
 
 void
-ILI9341_PixelFormatSet(ILI9341State& ili9341)
+ILI9341_PixelFormatSet(ILI9341State& ili9341, PixelFormat format)
 {
 	u8 bpp16 = 0b101;
-	//u8 bpp18 = 0b110;
+	u8 bpp18 = 0b110;
+
+	u8 bpp = 0;
+	switch (format)
+	{
+		default: Assert(false); return;
+		case PixelFormat::RGB565: bpp = bpp16; break;
+		case PixelFormat::RGB666: bpp = bpp18; break;
+	}
 
 	u8 mcuShift = 0;
 	u8 rgbShift = 4;
 
 	u8 pf = 0;
-	pf |= bpp16 << mcuShift;
-	pf |= bpp16 << rgbShift;
+	pf |= bpp << mcuShift;
+	pf |= bpp << rgbShift;
 
 	ILI9341_Write(ili9341, ILI9341::Command::PixelFormatSet, pf);
+	ili9341.pixelFormat = format;
 }
 
 void
@@ -436,6 +447,7 @@ ILI9341_Reset(ILI9341State& ili9341)
 {
 	//NOTE: Resets device state to defaults
 	ILI9341_WriteCmd(ili9341, ILI9341::Command::SoftwareReset);
+	FT232H_Flush(*ili9341.ft232h);
 	ili9341.sleep = true;
 	ili9341.sleepTime = Platform_GetTicks();
 	Platform_Sleep(5);
@@ -453,6 +465,7 @@ ILI9341_Sleep(ILI9341State& ili9341)
 			Platform_Sleep(120 - sinceWake);
 
 	ILI9341_WriteCmd(ili9341, ILI9341::Command::SleepIn);
+	FT232H_Flush(*ili9341.ft232h);
 	ili9341.sleep = true;
 	ili9341.sleepTime = Platform_GetTicks();
 	Platform_Sleep(5);
@@ -469,6 +482,7 @@ ILI9341_Wake(ILI9341State& ili9341)
 		Platform_Sleep(120 - sinceSleep);
 
 	ILI9341_WriteCmd(ili9341, ILI9341::Command::SleepOut);
+	FT232H_Flush(*ili9341.ft232h);
 	ili9341.sleep = false;
 	ili9341.wakeTime = Platform_GetTicks();
 	// NOTE: Docs contradict themselves. Is it 5 ms or 120 ms?
@@ -476,6 +490,7 @@ ILI9341_Wake(ILI9341State& ili9341)
 	//ili9341.nextCommandTime = ili9341.wakeTime + 5ms
 }
 
+// NOTE: color is RGB565. It's expanded to RGB666 if that's the current pixel format.
 void
 ILI9341_SetRect(ILI9341State& ili9341, v4u16 rect, u16 color)
 {
@@ -491,19 +506,34 @@ ILI9341_SetRect(ILI9341State& ili9341, v4u16 rect, u16 color)
 	ILI9341_BeginWriteTransaction(ili9341);
 	ILI9341_WriteCmdRaw(ili9341, ILI9341::Command::MemoryWrite);
 
-	u32 totalDataLen = (u32) (2 * rect.size.x * rect.size.y);
+	// NOTE: Wire order, most significant byte first
+	u8  pixel[3] = {};
+	u32 bpp      = PixelFormat_BytesPerPixel(ili9341.pixelFormat);
+	if (ili9341.pixelFormat == PixelFormat::RGB565)
+	{
+		pixel[0] = GetByte(1, color);
+		pixel[1] = GetByte(0, color);
+	}
+	else
+	{
+		u8 r = (u8) ((color >> 11) & 0x1F);
+		u8 g = (u8) ((color >>  5) & 0x3F);
+		u8 b = (u8) ((color >>  0) & 0x1F);
+		pixel[0] = (u8) (((r << 3) | (r >> 2)) & 0xFC);
+		pixel[1] = (u8) (g << 2);
+		pixel[2] = (u8) (((b << 3) | (b >> 2)) & 0xFC);
+	}
+
+	u32 totalDataLen = (u32) (bpp * rect.size.x * rect.size.y);
 
 	// NOTE: The FT232H has a maximum number of bytes it can send in a single command, so we only
-	// need to make a buffer that big and can send it multiple times.
-	u8 colorData[FT232H::MaxSendBytes];
-	u32 colorDataLen = Min(totalDataLen, FT232H::MaxSendBytes);
+	// need to make a buffer that big and can send it multiple times. Deferred sends reference it, so
+	// it comes from FT232H scratch memory and the rect can be part of a program.
+	u32 colorDataLen = Min(totalDataLen, FT232H::MaxSendBytes - FT232H::MaxSendBytes % bpp);
+	u8* colorData    = FT232H_AllocateScratch(*ili9341.ft232h, colorDataLen);
 	// TODO: Try using wmemset and profiling the difference
-	for (u32 i = 0; i < colorDataLen; i += 2)
-	{
-		// TODO: Remove endian swap when using parallel interface
-		colorData[i + 0] = GetByte(1, color);
-		colorData[i + 1] = GetByte(0, color);
-	}
+	for (u32 i = 0; i < colorDataLen; i += bpp)
+		memcpy(&colorData[i], pixel, bpp);
 
 	u32 remainingLen = totalDataLen;
 	while (remainingLen > 0)
@@ -612,20 +642,13 @@ ILI9341_EndDrawFrames(ILI9341State& ili9341)
 	ILI9341_EndWriteTransaction(ili9341);
 }
 
+// NOTE: bytes must already be in the current pixel format and in wire order (see Pixels_Convert)
 void
 ILI9341_DrawFrame(ILI9341State& ili9341, ByteSlice bytes)
 {
 	Assert(ili9341.drawingFrames);
 	Assert(!Slice_IsSparse(bytes));
-
-	// TODO: Remove endian swap when using parallel interface
-	Assert(bytes.length % 2 == 0);
-	for (u32 i = 0; i < bytes.length; i += 2)
-	{
-		u8 temp = bytes[i];
-		bytes[i + 0] = bytes[i + 1];
-		bytes[i + 1] = temp;
-	}
+	Assert(bytes.length == PixelFormat_BytesPerPixel(ili9341.pixelFormat) * ili9341.size.x * ili9341.size.y);
 
 	// TODO: Immediate
 	ILI9341_WriteDataRaw(ili9341, bytes);
@@ -639,6 +662,19 @@ ILI9341_DrawSingleFrame(ILI9341State& ili9341, ByteSlice bytes)
 	ILI9341_EndDrawFrames(ili9341);
 }
 
+// NOTE: Can be called between frames. Memory write has to be restarted after the format changes,
+// which also moves the write position back to the top left.
+void
+ILI9341_ChangePixelFormat(ILI9341State& ili9341, PixelFormat format)
+{
+	if (ili9341.pixelFormat == format) return;
+
+	b8 drawingFrames = ili9341.drawingFrames;
+	if (drawingFrames) ILI9341_EndDrawFrames(ili9341);
+	ILI9341_PixelFormatSet(ili9341, format);
+	if (drawingFrames) ILI9341_BeginDrawFrames(ili9341);
+}
+
 // -------------------------------------------------------------------------------------------------
 // Public API - Core Functions
 
@@ -647,13 +683,14 @@ ILI9341_Initialize(ILI9341State& ili9341, FT232HState& ft232h)
 {
 	ili9341.ft232h = &ft232h;
 
+	FT232H_BeginProgram(*ili9341.ft232h);
 	FT232H_SetCS(*ili9341.ft232h, Signal::Low);
 
 	// TODO: Want to do a software reset to set all config to default, but it causes a flicker.
 	ILI9341_Reset(ili9341);
 
 	ILI9341_MemoryAccessControl(ili9341);
-	ILI9341_PixelFormatSet(ili9341);
+	ILI9341_PixelFormatSet(ili9341, PixelFormat::RGB565);
 	ILI9341_FrameRateControl_Normal(ili9341);
 	ILI9341_DisplayFunctionControl(ili9341);
 	ILI9341_PowerControl(ili9341);
@@ -664,10 +701,11 @@ ILI9341_Initialize(ILI9341State& ili9341, FT232HState& ft232h)
 	ILI9341_SetGamma(ili9341);
 	ILI9341_WriteCmd(ili9341, ILI9341::Command::SleepOut);
 	ILI9341_WriteCmd(ili9341, ILI9341::Command::DisplayOn);
+	FT232H_EndProgram(*ili9341.ft232h);
 
 	// TODO: The screen can do an endian swap, but only in the parallel interface. Once we're using
-	// the parallel interface remove the byte-swaps in SetRect and DrawFrame and set the endianness
-	// mode with Interface Control 0xF6.
+	// the parallel interface remove the byte-swap in SetRect, have Pixels_Convert write native
+	// order, and set the endianness mode with Interface Control 0xF6.
 }
 
 void
@@ -0,0 +1,275 @@
+// NOTE: A small dependency graph for startup work. A job runs once every job it depends on has
+// succeeded. Worker jobs are pushed to a WorkQueue. Main thread jobs (anything that touches the
+// renderer, the handle table, or managed code) run on the thread calling JobGraph_Run while the
+// workers are busy. Only that thread updates the graph, so the queue is the only synchronization. A
+// job that fails skips everything that depends on it.
+//
+// Jobs can be added between runs and can depend on jobs from an earlier run, so work that can only be
+// planned once earlier results are in (e.g. plugins listed in the layout) goes in a second run. Main
+// thread jobs that are ready at the same time run in the order they were added. Without a queue every
+// job runs on the calling thread.
+
+using JobFn = b8(void* data);
+
+enum struct JobState
+{
+	Null,
+	Pending,
+	Running,
+	Succeeded,
+	Failed,
+	Skipped,
+};
+
+struct Job
+{
+	String     name;
+	u32        stage;
+	JobFn*     function;
+	void*      data;
+	b8         mainThread;
+	JobState   state;
+	b8         succeeded;
+	u32        run;
+	u32        waitCount;
+	List<u32>  dependents;
+	i64        startTicks;
+	i64        endTicks;
+};
+
+struct JobGraph
+{
+	WorkQueue* queue;
+	List<Job>  jobs;
+	u32        runCount;
+	b8         running;
+};
+
+inline u32
+JobGraph_Add(JobGraph& graph, StringView name, u32 stage, JobFn* function, void* data, b8 mainThread = false)
+{
+	Assert(!graph.running);
+
+	Job& job = List_Append(graph.jobs);
+	job.name       = String_FromView(name);
+	job.stage      = stage;
+	job.function   = function;
+	job.data       = data;
+	job.mainThread = mainThread;
+	job.state      = JobState::Pending;
+	job.run        = graph.runCount;
+	return graph.jobs.length - 1;
+}
+
+inline void
+JobGraph_AddDependency(JobGraph& graph, u32 jobIndex, u32 dependencyIndex)
+{
+	Assert(!graph.running);
+
+	Job& job        = graph.jobs[jobIndex];
+	Job& dependency = graph.jobs[dependencyIndex];
+	Assert(job.state == JobState::Pending);
+
+	switch (dependency.state)
+	{
+		default: Assert(false); break;
+
+		case JobState::Pending:
+			List_Append(dependency.dependents, jobIndex);
+			job.waitCount++;
+			break;
+
+		case JobState::Succeeded:
+			break;
+
+		case JobState::Failed:
+		case JobState::Skipped:
+			job.state = JobState::Skipped;
+			break;
+	}
+}
+
+inline b8
+JobGraph_Succeeded(JobGraph& graph, u32 jobIndex)
+{
+	return graph.jobs[jobIndex].state == JobState::Succeeded;
+}
+
+// NOTE: Runs on a worker. state is read by the main thread while workers are busy so it stays Running
+// until JobGraph_Finish. The rest of the job is only read after the queue hands it back.
+inline void
+JobGraph_Execute(Job& job)
+{
+	job.startTicks = Platform_GetTicks();
+	job.succeeded  = job.function(job.data);
+	job.endTicks   = Platform_GetTicks();
+}
+
+inline void
+JobGraph_ExecuteOnWorker(void* data)
+{
+	JobGraph_Execute(*(Job*) data);
+}
+
+// NOTE: Returns the number of jobs that were skipped
+inline u32
+JobGraph_Skip(JobGraph& graph, Job& job)
+{
+	u32 result = 0;
+	for (u32 i = 0; i < job.dependents.length; i++)
+	{
+		Job& dependent = graph.jobs[job.dependents[i]];
+		if (dependent.state != JobState::Pending) continue;
+
+		dependent.state = JobState::Skipped;
+		result += 1 + JobGraph_Skip(graph, dependent);
+	}
+	return result;
+}
+
+// NOTE: Returns the number of jobs that are done, including any that were skipped as a result
+inline u32
+JobGraph_Finish(JobGraph& graph, Job& job)
+{
+	Assert(job.state == JobState::Running);
+	job.state = job.succeeded ? JobState::Succeeded : JobState::Failed;
+
+	if (job.state != JobState::Succeeded)
+	{
+		LOG(Severity::Warning, "Job '%' failed", job.name);
+		return 1 + JobGraph_Skip(graph, job);
+	}
+
+	for (u32 i = 0; i < job.dependents.length; i++)
+	{
+		Job& dependent = graph.jobs[job.dependents[i]];
+		Assert(dependent.waitCount > 0);
+		dependent.waitCount--;
+	}
+	return 1;
+}
+
+// NOTE: Runs every pending job. Returns false if any job failed or was skipped.
+inline b8
+JobGraph_Run(JobGraph& graph)
+{
+	Assert(!graph.running);
+	graph.running = true;
+	defer { graph.running = false; };
+
+	u32 remaining = 0;
+	for (u32 i = 0; i < graph.jobs.length; i++)
+		remaining += graph.jobs[i].state == JobState::Pending;
+	graph.runCount++;
+
+	u32 queued = 0;
+	while (remaining)
+	{
+		// NOTE: Collect finished work first so its dependents can start as early as possible
+		while (queued)
+		{
+			Job* job = (Job*) Platform_PopFinishedWork(*graph.queue, false);
+			if (!job) break;
+
+			queued--;
+			remaining -= JobGraph_Finish(graph, *job);
+		}
+
+		Job* mainJob = nullptr;
+		for (u32 i = 0; i < graph.jobs.length; i++)
+		{
+			Job& job = graph.jobs[i];
+			if (job.state != JobState::Pending || job.waitCount) continue;
+
+			if (job.mainThread || !graph.queue)
+			{
+				if (!mainJob) mainJob = &job;
+				continue;
+			}
+
+			job.state = JobState::Running;
+			Platform_PushWork(*graph.queue, JobGraph_ExecuteOnWorker, &job);
+			queued++;
+		}
+
+		if (mainJob)
+		{
+			mainJob->state = JobState::Running;
+			JobGraph_Execute(*mainJob);
+			remaining -= JobGraph_Finish(graph, *mainJob);
+		}
+		else if (queued)
+		{
+			Job* job = (Job*) Platform_PopFinishedWork(*graph.queue, true);
+			queued--;
+			remaining -= JobGraph_Finish(graph, *job);
+		}
+		else if (remaining)
+		{
+			// NOTE: Nothing is running and nothing can start
+			Assert(false);
+			break;
+		}
+	}
+
+	b8 result = true;
+	for (u32 i = 0; i < graph.jobs.length; i++)
+		result &= graph.jobs[i].state == JobState::Succeeded;
+	return result;
+}
+
+// NOTE: Wall time is from the first job in a stage starting to the last one finishing, summed over
+// runs so the time between runs isn't counted. Stages overlap so wall times can add up to more than
+// the total. Work time is the sum of every job in the stage, so work / wall is how well the stage was
+// spread across threads.
+inline void
+JobGraph_LogStages(JobGraph& graph, Slice<StringView> stageNames)
+{
+	for (u32 stage = 0; stage < stageNames.length; stage++)
+	{
+		u32 jobCount    = 0;
+		u32 failedCount = 0;
+		r32 wall        = 0.0f;
+		r32 work        = 0.0f;
+		for (u32 run = 0; run < graph.runCount; run++)
+		{
+			i64 firstStart = i64Max;
+			i64 lastEnd    = 0;
+			for (u32 i = 0; i < graph.jobs.length; i++)
+			{
+				Job& job = graph.jobs[i];
+				if (job.stage != stage || job.run != run) continue;
+
+				jobCount++;
+				if (job.state != JobState::Succeeded) failedCount++;
+				if (!job.startTicks) continue;
+
+				firstStart = Min(firstStart, job.startTicks);
+				lastEnd    = Max(lastEnd, job.endTicks);
+				work      += Platform_GetElapsedMilliseconds(job.startTicks, job.endTicks);
+			}
+
+			if (lastEnd)
+				wall += Platform_GetElapsedMilliseconds(firstStart, lastEnd);
+		}
+		if (jobCount == 0) continue;
+
+		LOG(Severity::Info, "Stage '%' took % ms (% ms of work, % jobs, % failed)",
+			stageNames[stage], wall, work, jobCount, failedCount);
+	}
+}
+
+inline void
+JobGraph_Free(JobGraph& graph)
+{
+	Assert(!graph.running);
+
+	for (u32 i = 0; i < graph.jobs.length; i++)
+	{
+		Job& job = graph.jobs[i];
+		String_Free(job.name);
+		List_Free(job.dependents);
+	}
+	List_Free(graph.jobs);
+	graph = {};
+}
@@ -0,0 +1,246 @@
+// NOTE: Binary snapshot of the widget layout. The file is a header followed by tightly packed
+// sections of fixed size records, so it can be mapped and restored with a handful of copies: widget
+// records and user data are copied straight into the widget type lists and only the handles need to
+// be fixed up afterwards.
+//
+// Handles aren't stable across runs. Records refer to plugins, widget types, and sensors by index
+// into tables stored in the file instead. Plugins are identified by directory and file name, widget
+// types by plugin and name, and sensors by identifier. Strings are NUL terminated and live in the
+// strings section.
+//
+// Widget records are stored exactly as they are in memory (with handles cleared) so the version must
+// be bumped whenever Widget changes. widgetSize catches most mistakes.
+
+const u32 LayoutMagic     = 0x4C4D484C; // LHML
+const u32 LayoutVersion   = 1;
+const u32 LayoutAlignment = 16;
+const u32 LayoutNone      = u32Max;
+
+const StringView LayoutPath = "Layout.bin";
+
+struct LayoutString
+{
+	u32 offset; // NOTE: Relative to the strings section
+	u32 length; // NOTE: Not including the NUL terminator
+};
+
+struct LayoutSection
+{
+	u32 offset; // NOTE: Relative to the start of the file
+	u32 count;
+};
+
+struct LayoutPlugin
+{
+	PluginKind   kind;
+	b8           outOfProcess;
+	LayoutString directory;
+	LayoutString fileName;
+};
+
+struct LayoutWidgetType
+{
+	u32          plugin;
+	LayoutString name;
+	u32          userDataSize;
+	u32          firstWidget;
+	u32          widgetCount;
+	u32          firstUserData;
+};
+
+struct LayoutSensor
+{
+	LayoutString identifier;
+};
+
+struct LayoutHeader
+{
+	u32           magic;
+	u32           version;
+	u32           size;
+	u32           widgetSize;
+	LayoutSection plugins;       // LayoutPlugin
+	LayoutSection widgetTypes;   // LayoutWidgetType
+	LayoutSection sensors;       // LayoutSensor
+	LayoutSection widgets;       // Widget
+	LayoutSection widgetSensors; // u32, parallel to widgets. Index into sensors or LayoutNone.
+	LayoutSection userData;      // u8
+	LayoutSection strings;       // c8
+};
+
+// -------------------------------------------------------------------------------------------------
+// Writing
+
+struct LayoutWriter
+{
+	Bytes        bytes;
+	List<c8>     strings;
+	LayoutHeader header;
+};
+
+// NOTE: Reserves room for the header. It's filled in by Layout_Finalize.
+inline void
+Layout_InitializeWriter(LayoutWriter& writer)
+{
+	List_AppendRange(writer.bytes, sizeof(LayoutHeader));
+}
+
+inline LayoutString
+Layout_AppendString(LayoutWriter& writer, StringView string)
+{
+	LayoutString result = {};
+	result.offset = writer.strings.length;
+	result.length = string.length;
+
+	Slice<c8> chars = {};
+	chars.data   = string.data;
+	chars.length = string.length;
+
+	List_AppendRange(writer.strings, chars);
+	List_Append(writer.strings, '\0');
+	return result;
+}
+
+template<typename T>
+inline void
+Layout_AppendSection(LayoutWriter& writer, LayoutSection& section, Slice<T> records)
+{
+	Assert(!Slice_IsSparse(records));
+
+	u32 offset = (writer.bytes.length + LayoutAlignment - 1) & ~(LayoutAlignment - 1);
+	List_AppendRange(writer.bytes, offset - writer.bytes.length);
+
+	section.offset = offset;
+	section.count  = records.length;
+
+	ByteSlice bytes = {};
+	bytes.data   = (u8*) records.data;
+	bytes.length = sizeof(T) * records.length;
+	bytes.stride = 1;
+	List_AppendRange(writer.bytes, bytes);
+}
+
+// NOTE: Appends the strings section and fills in the header. Every other section must have been
+// appended already.
+inline ByteSlice
+Layout_Finalize(LayoutWriter& writer)
+{
+	Layout_AppendSection(writer, writer.header.strings, Slice<c8>(writer.strings));
+
+	LayoutHeader& header = (LayoutHeader&) writer.bytes[0];
+	header            = writer.header;
+	header.magic      = LayoutMagic;
+	header.version    = LayoutVersion;
+	header.size       = writer.bytes.length;
+	header.widgetSize = sizeof(Widget);
+	return writer.bytes;
+}
+
+inline void
+Layout_FreeWriter(LayoutWriter& writer)
+{
+	List_Free(writer.bytes);
+	List_Free(writer.strings);
+	writer = {};
+}
+
+// -------------------------------------------------------------------------------------------------
+// Reading
+
+template<typename T>
+inline Slice<T>
+Layout_GetSection(ByteSlice bytes, LayoutSection section)
+{
+	Slice<T> result = {};
+	result.data   = (T*) &bytes.data[section.offset];
+	result.length = section.count;
+	return result;
+}
+
+inline StringView
+Layout_GetString(ByteSlice bytes, LayoutHeader& header, LayoutString string)
+{
+	StringView result = {};
+	result.data   = (c8*) &bytes.data[header.strings.offset + string.offset];
+	result.length = string.length;
+	return result;
+}
+
+inline b8
+Layout_IsSectionValid(ByteSlice bytes, LayoutSection section, u32 recordSize)
+{
+	u64 end = (u64) section.offset + (u64) section.count * recordSize;
+
+	b8 result = true;
+	result &= section.offset >= sizeof(LayoutHeader);
+	result &= (section.offset & (LayoutAlignment - 1)) == 0;
+	result &= end <= bytes.length;
+	return result;
+}
+
+inline b8
+Layout_IsStringValid(ByteSlice bytes, LayoutHeader& header, LayoutString string)
+{
+	u64 end = (u64) string.offset + string.length;
+	if (end >= header.strings.count) return false;
+	return bytes.data[header.strings.offset + end] == '\0';
+}
+
+// NOTE: Checks every offset and index in the file so the rest of the loading code can index freely.
+// Returns nullptr if the file is corrupt or from a different version.
+inline LayoutHeader*
+Layout_Validate(ByteSlice bytes)
+{
+	Assert(!Slice_IsSparse(bytes));
+	if (bytes.length < sizeof(LayoutHeader)) return nullptr;
+
+	LayoutHeader& header = (LayoutHeader&) bytes[0];
+
+	b8 valid = true;
+	valid &= header.magic == LayoutMagic;
+	valid &= header.version == LayoutVersion;
+	valid &= header.size == bytes.length;
+	valid &= header.widgetSize == sizeof(Widget);
+	valid &= header.widgetSensors.count == header.widgets.count;
+	if (!valid) return nullptr;
+
+	valid &= Layout_IsSectionValid(bytes, header.plugins,       sizeof(LayoutPlugin));
+	valid &= Layout_IsSectionValid(bytes, header.widgetTypes,   sizeof(LayoutWidgetType));
+	valid &= Layout_IsSectionValid(bytes, header.sensors,       sizeof(LayoutSensor));
+	valid &= Layout_IsSectionValid(bytes, header.widgets,       sizeof(Widget));
+	valid &= Layout_IsSectionValid(bytes, header.widgetSensors, sizeof(u32));
+	valid &= Layout_IsSectionValid(bytes, header.userData,      sizeof(u8));
+	valid &= Layout_IsSectionValid(bytes, header.strings,       sizeof(c8));
+	if (!valid) return nullptr;
+
+	Slice<LayoutPlugin> plugins = Layout_GetSection<LayoutPlugin>(bytes, header.plugins);
+	for (u32 i = 0; i < plugins.length; i++)
+	{
+		LayoutPlugin& plugin = plugins[i];
+		valid &= plugin.kind == PluginKind::Sensor || plugin.kind == PluginKind::Widget;
+		valid &= Layout_IsStringValid(bytes, header, plugin.directory);
+		valid &= Layout_IsStringValid(bytes, header, plugin.fileName);
+	}
+
+	Slice<LayoutWidgetType> widgetTypes = Layout_GetSection<LayoutWidgetType>(bytes, header.widgetTypes);
+	for (u32 i = 0; i < widgetTypes.length; i++)
+	{
+		LayoutWidgetType& widgetType = widgetTypes[i];
+		u64 userDataEnd = (u64) widgetType.firstUserData + (u64) widgetType.userDataSize * widgetType.widgetCount;
+
+		valid &= widgetType.plugin < plugins.length && plugins[widgetType.plugin].kind == PluginKind::Widget;
+		valid &= Layout_IsStringValid(bytes, header, widgetType.name);
+		valid &= (u64) widgetType.firstWidget + widgetType.widgetCount <= header.widgets.count;
+		valid &= userDataEnd <= header.userData.count;
+	}
+
+	Slice<LayoutSensor> sensors = Layout_GetSection<LayoutSensor>(bytes, header.sensors);
+	for (u32 i = 0; i < sensors.length; i++)
+		valid &= Layout_IsStringValid(bytes, header, sensors[i].identifier);
+
+	Slice<u32> widgetSensors = Layout_GetSection<u32>(bytes, header.widgetSensors);
+	for (u32 i = 0; i < widgetSensors.length; i++)
+		valid &= widgetSensors[i] == LayoutNone || widgetSensors[i] < sensors.length;
+
+	return valid ? &header : nullptr;
+}
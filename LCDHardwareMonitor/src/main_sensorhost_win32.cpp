@@ -0,0 +1,223 @@
+#include "LHMAPI.h"
+
+#include <stdio.h>
+
+#include "platform.h"
+#include "pluginloader.h"
+#include "plugin_shared.h"
+#include "sensor_table.hpp"
+
+#include "platform_win32.hpp"
+#include "pluginloader_win32.hpp"
+
+// NOTE: Runs a single sensor plugin on behalf of the simulation. See sensor_table.hpp.
+// Usage: "LCDHardwareMonitor Sensor Host.exe" <plugin directory> <plugin file> <sensor table name>
+
+struct PluginContext
+{
+	SensorTable*  table;
+	SensorPlugin* sensorPlugin;
+	b8            success;
+};
+
+static void
+RegisterSensors(PluginContext& context, Slice<SensorDesc> sensorDescs)
+{
+	if (!context.success) return;
+	context.success = false;
+
+	SensorPlugin& sensorPlugin = *context.sensorPlugin;
+
+	b8 success = SensorTable_AppendDescs(*context.table, sensorDescs);
+	LOG_IF(!success, return,
+		Severity::Error, "Sensor plugin '%' registered more than % sensors", sensorPlugin.name, SensorTableCapacity);
+
+	List_Grow(sensorPlugin.sensors, sensorDescs.length);
+	List_AppendRange(sensorPlugin.values, sensorDescs.length);
+	for (u32 i = 0; i < sensorDescs.length; i++)
+	{
+		SensorDesc& desc = sensorDescs[i];
+
+		Sensor& sensor = List_Append(sensorPlugin.sensors);
+		sensor.handle     = { sensorPlugin.sensors.length };
+		sensor.name       = String_FromView(desc.name);
+		sensor.identifier = String_FromView(desc.identifier);
+		sensor.format     = String_FromView(desc.format);
+	}
+
+	context.success = true;
+}
+
+// NOTE: The simulation maps sensors to table slots by registration order, so removing sensors would
+// shift every later value.
+static void
+UnregisterSensors(PluginContext& context, Slice<Handle<Sensor>>)
+{
+	if (!context.success) return;
+	context.success = false;
+
+	LOG(Severity::Warning, "Sensor plugin '%' tried to unregister sensors. This isn't supported out of process.",
+		context.sensorPlugin->name);
+}
+
+i32
+main(i32 argc, c8* argv[])
+{
+	b8 success = Platform_InitializeLog(LogOverflow::Drop);
+	LOG_IF(!success, IGNORE, Severity::Warning, "Failed to initialize asynchronous logging");
+	defer { Platform_TeardownLog(); };
+
+	LOG_IF(argc != 4, return -1,
+		Severity::Fatal, "Usage: <plugin directory> <plugin file> <sensor table name>");
+
+
+	StringView pluginDirectory = String_ViewCString(argv[1]);
+	StringView pluginFileName  = String_ViewCString(argv[2]);
+	StringView tableName       = String_ViewCString(argv[3]);
+
+
+	// Sensor Table
+	SharedMemory tableMemory = {};
+	success = Platform_OpenSharedMemory(tableName, sizeof(SensorTable), tableMemory);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to open sensor table '%'", tableName);
+	defer { Platform_DestroySharedMemory(tableMemory); };
+
+	SensorTable& table = *(SensorTable*) tableMemory.data;
+	LOG_IF(!SensorTable_IsValid(table), return -1,
+		Severity::Fatal, "Sensor table '%' has an unexpected layout", tableName);
+
+	auto tableGuard = guard { SensorTable_Store(table.header.state, (u32) SensorTableState::Failed); };
+
+
+	// Plugin
+	PluginLoaderState pluginLoader = {};
+	success = PluginLoader_Initialize(pluginLoader);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize the plugin loader");
+	defer { PluginLoader_Teardown(pluginLoader); };
+
+	Plugin plugin = {};
+	plugin.kind      = PluginKind::Sensor;
+	plugin.directory = String_FromView(pluginDirectory);
+	plugin.fileName  = String_FromView(pluginFileName);
+	defer
+	{
+		String_Free(plugin.fileName);
+		String_Free(plugin.directory);
+		String_Free(plugin.info.name);
+		String_Free(plugin.info.author);
+	};
+
+	SensorPlugin sensorPlugin = {};
+	List_Reserve(sensorPlugin.sensors, 32);
+	List_Reserve(sensorPlugin.values, 32);
+	defer
+	{
+		for (u32 i = 0; i < sensorPlugin.sensors.length; i++)
+		{
+			Sensor& sensor = sensorPlugin.sensors[i];
+			String_Free(sensor.name);
+			String_Free(sensor.identifier);
+			String_Free(sensor.format);
+		}
+		List_Free(sensorPlugin.sensors);
+		List_Free(sensorPlugin.values);
+	};
+
+	success = PluginLoader_LoadSensorPlugin(pluginLoader, plugin, sensorPlugin);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to load Sensor plugin '%'", plugin.fileName);
+	defer { PluginLoader_UnloadSensorPlugin(pluginLoader, plugin, sensorPlugin); };
+
+	sensorPlugin.name = plugin.info.name;
+
+	SensorTable_CopyText(table.header.pluginName,   ArrayLength(table.header.pluginName),   plugin.info.name);
+	SensorTable_CopyText(table.header.pluginAuthor, ArrayLength(table.header.pluginAuthor), plugin.info.author);
+	table.header.pluginVersion  = plugin.info.version;
+	table.header.updateInterval = sensorPlugin.functions.updateInterval;
+
+	PluginContext context = {};
+	context.table        = &table;
+	context.sensorPlugin = &sensorPlugin;
+	context.success      = true;
+
+	if (sensorPlugin.functions.Initialize)
+	{
+		SensorPluginAPI::Initialize api = {};
+		api.RegisterSensors = RegisterSensors;
+
+		success = sensorPlugin.functions.Initialize(context, api);
+		success &= context.success;
+		LOG_IF(!success, return -1,
+			Severity::Fatal, "Failed to initialize Sensor plugin '%'", plugin.info.name);
+	}
+
+	defer
+	{
+		if (sensorPlugin.functions.Teardown)
+		{
+			SensorPluginAPI::Teardown api = {};
+			api.sensors = sensorPlugin.sensors;
+
+			sensorPlugin.functions.Teardown(context, api);
+		}
+	};
+
+	SensorTable_Store(table.header.state, (u32) SensorTableState::Ready);
+	tableGuard.dismiss = true;
+
+
+	// Main loop
+	// NOTE: Beats happen between updates, so a plugin that hangs inside Update stops the heartbeat
+	// and the simulation will eventually kill and relaunch the host.
+	SensorPluginAPI::Update api = {};
+	api.RegisterSensors   = RegisterSensors;
+	api.UnregisterSensors = UnregisterSensors;
+
+	i64 beatTicks     = Platform_SecondsToTicks(SensorHostBeatInterval);
+	i64 intervalTicks = Platform_SecondsToTicks(Max(sensorPlugin.functions.updateInterval, 1.0f / 60.0f));
+	i64 nextUpdate    = Platform_GetTicks();
+
+	u32 simulationHeartbeat = SensorTable_Load(table.header.simulationHeartbeat);
+	i64 simulationLastBeat  = Platform_GetTicks();
+
+	while (!SensorTable_Load(table.header.quit))
+	{
+		i64 startTicks = Platform_GetTicks();
+		if (startTicks >= nextUpdate && sensorPlugin.functions.Update)
+		{
+			// TODO: try/catch?
+			context.success = true;
+
+			api.sensors = sensorPlugin.sensors;
+			api.values  = sensorPlugin.values;
+			sensorPlugin.functions.Update(context, api);
+
+			SensorTable_WriteValues(table, sensorPlugin.values);
+
+			// NOTE: Skip missed updates rather than running them back to back
+			nextUpdate += intervalTicks;
+			if (nextUpdate <= Platform_GetTicks())
+				nextUpdate = Platform_GetTicks() + intervalTicks;
+		}
+
+		SensorTable_Store(table.header.hostHeartbeat, table.header.hostHeartbeat + 1);
+
+		u32 heartbeat = SensorTable_Load(table.header.simulationHeartbeat);
+		if (heartbeat != simulationHeartbeat)
+		{
+			simulationHeartbeat = heartbeat;
+			simulationLastBeat  = Platform_GetTicks();
+		}
+		else if (Platform_GetElapsedSeconds(simulationLastBeat) > SensorHostTimeout)
+		{
+			LOG(Severity::Warning, "Simulation stopped responding. Shutting down Sensor plugin '%'", plugin.info.name);
+			break;
+		}
+
+		i64 nextBeat = Min(nextUpdate, Platform_GetTicks() + beatTicks);
+		r32 sleepMs  = Platform_GetElapsedMilliseconds(Platform_GetTicks(), nextBeat);
+		if (sleepMs >= 1.0f)
+			Platform_Sleep((u32) sleepMs);
+	}
+
+	return 0;
+}
@@ -6,9 +6,13 @@
 #include "pluginloader.h"
 #include "renderer.h"
 #include "plugin_shared.h"
+#include "sensor_table.hpp"
+#include "layout.hpp"
+#include "jobs.hpp"
 #include "gui_protocol.hpp"
 #include "Solid Colored.ps.h"
 #include "Outline.ps.h"
+#include "pixels.hpp"
 #include "ft232h.h"
 #include "ili9341.hpp"
 #include "simulation.hpp"
@@ -74,8 +78,15 @@ WinMainImpl(HINSTANCE hInstance, HINSTANCE hPrevInstance, c8* pCmdLine, i32 nCmd
 	PreviewWindowState previewState      = {};
 
 
+	// Logging
+	// NOTE: Always torn down so pending records are written before exit
+	b8 success = Platform_InitializeLog(LogOverflow::Drop);
+	LOG_IF(!success, IGNORE, Severity::Warning, "Failed to initialize asynchronous logging");
+	defer { Platform_TeardownLog(); };
+
+
 	// Renderer
-	b8 success = Renderer_Initialize(rendererState);
+	success = Renderer_Initialize(rendererState);
 	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize the renderer");
 	DEFER_TEARDOWN { Renderer_Teardown(rendererState); };
 
@@ -0,0 +1,306 @@
+// NOTE: Frames are rendered in BGRA8 and converted on the CPU to the format the LCD is driven in.
+// Rendering at full precision keeps alpha compositing simple and lets the conversion dither instead
+// of the GPU truncating every intermediate result to 16 bits.
+//
+// The output is tightly packed and in wire order (most significant byte first) so it can be sent
+// as is. RGB565 is 2 bytes per pixel. RGB666 is 3 bytes per pixel with each channel in the top 6
+// bits of its byte, which is what the ILI9341 expects over SPI.
+//
+// Dithering adds a per pixel threshold to each channel before it's truncated. The thresholds come
+// from a 16x16 tile that's expanded into per channel byte offsets once, when the converter is set
+// up, so the inner loop is a saturating add, a few shifts and masks, and a pack.
+//
+// PixelFormat and Dither are in plugin_shared.h so the GUI can change them.
+
+const u32 DitherSize = 16;
+
+// NOTE: 4x4 Bayer matrix. Tiled to fill DitherSize.
+const u8 DitherBayer[4][4] = {
+	{  0,  8,  2, 10 },
+	{ 12,  4, 14,  6 },
+	{  3, 11,  1,  9 },
+	{ 15,  7, 13,  5 },
+};
+
+// NOTE: Ranks 0-255 from void and cluster (sigma 1.5, toroidal)
+const u8 DitherBlueNoise[DitherSize][DitherSize] = {
+	{ 234,  50, 188,  19,  58, 171, 121,  47, 163,   3, 247, 104,  22, 132,  14,  65 },
+	{ 209,   8, 118,  97, 240, 205,  23, 228, 138,  64, 123, 170,  72, 224,  99, 149 },
+	{  85, 139, 229, 165,  78, 146, 111,  84, 176, 216,  30, 231, 153, 201,  42, 180 },
+	{  25,  62, 195,  29,  43, 185,   7, 249,  41, 100, 191,  48,  87,   5, 128, 243 },
+	{ 221, 152, 101, 253, 130, 220,  59, 200, 156,  12, 136, 112, 254, 174,  69, 109 },
+	{  46, 189,   2,  73, 172,  90, 142, 116,  80, 237, 210,  61, 147,  33, 206, 160 },
+	{  81, 124, 217, 113, 208,  15, 241,  27, 168,  45, 178,  20, 193,  96, 225,  18 },
+	{ 242, 164,  60,  35, 157,  53, 181,  68, 223, 105, 125,  83, 236, 131,  55, 141 },
+	{ 197,  10, 227, 134, 246,  95, 126, 198, 148,   1, 244, 161,  71,   9, 182, 106 },
+	{  40,  93, 179,  75, 192,   6, 218,  36,  91,  57, 202,  34, 215, 155, 233,  74 },
+	{ 252, 120, 150,  24, 110,  63, 166, 119, 232, 183, 133, 103,  49, 117,  31, 167 },
+	{  16, 212,  51, 238, 207, 137, 255,  21,  76, 151,  13, 250, 190,  88, 203, 135 },
+	{ 102, 184,  82, 169,  38,  89, 187,  52, 204,  98, 173,  67, 129,   4, 222,  56 },
+	{ 230, 144,   0, 127, 226,  11, 154, 114, 239,  39, 219,  28, 235, 145, 175,  77 },
+	{ 196,  37, 248,  70, 107, 199,  66, 177,  17, 143, 115, 159,  86,  44, 108,  26 },
+	{ 122,  92, 158, 214, 140,  32, 245,  94, 213,  79, 194,  54, 211, 186, 251, 162 },
+};
+
+struct PixelConverter
+{
+	PixelFormat format;
+	Dither      dither;
+	// NOTE: Added to each BGRA byte before truncating. Rows are 64 bytes so SIMD loads never wrap.
+	u8          offsets[DitherSize][DitherSize][4];
+};
+
+inline u32
+PixelFormat_BytesPerPixel(PixelFormat format)
+{
+	switch (format)
+	{
+		default: Assert(false); return 0;
+		case PixelFormat::RGB565: return 2;
+		case PixelFormat::RGB666: return 3;
+	}
+}
+
+inline StringView
+PixelFormat_Name(PixelFormat format)
+{
+	switch (format)
+	{
+		default: Assert(false); return "Unknown";
+		case PixelFormat::RGB565: return "RGB565";
+		case PixelFormat::RGB666: return "RGB666";
+	}
+}
+
+inline StringView
+Dither_Name(Dither dither)
+{
+	switch (dither)
+	{
+		default: Assert(false); return "Unknown";
+		case Dither::Null:      return "None";
+		case Dither::Ordered:   return "Ordered";
+		case Dither::BlueNoise: return "Blue Noise";
+	}
+}
+
+// -------------------------------------------------------------------------------------------------
+// Conversion
+
+inline void
+PixelConverter_Initialize(PixelConverter& converter, PixelFormat format, Dither dither)
+{
+	converter.format = format;
+	converter.dither = dither;
+
+	// NOTE: Distance between representable values of each BGRA byte. Alpha is dropped.
+	u32 steps[4] = {};
+	switch (format)
+	{
+		default: Assert(false); break;
+		case PixelFormat::RGB565: steps[0] = 8; steps[1] = 4; steps[2] = 8; break;
+		case PixelFormat::RGB666: steps[0] = 4; steps[1] = 4; steps[2] = 4; break;
+	}
+
+	for (u32 y = 0; y < DitherSize; y++)
+	{
+		for (u32 x = 0; x < DitherSize; x++)
+		{
+			u32 threshold = 0;
+			switch (dither)
+			{
+				default: Assert(false); break;
+				case Dither::Null:      threshold = 128; break;
+				case Dither::Ordered:   threshold = DitherBayer[y % 4][x % 4] * 16u + 8u; break;
+				case Dither::BlueNoise: threshold = DitherBlueNoise[y][x]; break;
+			}
+
+			for (u32 c = 0; c < 4; c++)
+				converter.offsets[y][x][c] = (u8) ((threshold * steps[c]) >> 8);
+		}
+	}
+}
+
+inline u8
+AddSaturate(u8 lhs, u8 rhs)
+{
+	u32 result = (u32) lhs + rhs;
+	return (u8) (result > 0xFF ? 0xFF : result);
+}
+
+// NOTE: Converts pixels [x, width) of one row. Used for whatever the SIMD loops leave over.
+inline void
+ConvertRowScalar(PixelConverter& converter, u8* dst, u8* src, u32 x, u32 width, u32 y)
+{
+	u32 bpp = PixelFormat_BytesPerPixel(converter.format);
+	for (; x < width; x++)
+	{
+		u8* offsets = converter.offsets[y % DitherSize][x % DitherSize];
+		u8* pixel   = &src[4 * x];
+		u8* out     = &dst[bpp * x];
+
+		u8 b = AddSaturate(pixel[0], offsets[0]);
+		u8 g = AddSaturate(pixel[1], offsets[1]);
+		u8 r = AddSaturate(pixel[2], offsets[2]);
+
+		if (converter.format == PixelFormat::RGB565)
+		{
+			out[0] = (u8) ((r & 0xF8) | (g >> 5));
+			out[1] = (u8) (((g << 3) & 0xE0) | (b >> 3));
+		}
+		else
+		{
+			out[0] = (u8) (r & 0xFC);
+			out[1] = (u8) (g & 0xFC);
+			out[2] = (u8) (b & 0xFC);
+		}
+	}
+}
+
+#if LHM_SIMD
+// NOTE: 4 BGRA pixels to 4 wire order RGB565 values in the low 16 bits of each lane, sign extended
+// so _mm_packs_epi32 doesn't saturate them
+inline __m128i
+SIMD_PackRGB565(__m128i p)
+{
+	__m128i hi = _mm_or_si128(
+		_mm_and_si128(_mm_srli_epi32(p, 16), _mm_set1_epi32(0xF8)),
+		_mm_and_si128(_mm_srli_epi32(p, 13), _mm_set1_epi32(0x07)));
+	__m128i lo = _mm_or_si128(
+		_mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0xE0)),
+		_mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x1F)));
+	__m128i result = _mm_or_si128(hi, _mm_slli_epi32(lo, 8));
+	return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+}
+
+#if LHM_SIMD >= 2
+inline __m256i
+SIMD_PackRGB565(__m256i p)
+{
+	__m256i hi = _mm256_or_si256(
+		_mm256_and_si256(_mm256_srli_epi32(p, 16), _mm256_set1_epi32(0xF8)),
+		_mm256_and_si256(_mm256_srli_epi32(p, 13), _mm256_set1_epi32(0x07)));
+	__m256i lo = _mm256_or_si256(
+		_mm256_and_si256(_mm256_srli_epi32(p, 5), _mm256_set1_epi32(0xE0)),
+		_mm256_and_si256(_mm256_srli_epi32(p, 3), _mm256_set1_epi32(0x1F)));
+	__m256i result = _mm256_or_si256(hi, _mm256_slli_epi32(lo, 8));
+	return _mm256_srai_epi32(_mm256_slli_epi32(result, 16), 16);
+}
+
+// NOTE: Stores the low 12 bytes
+inline void
+SIMD_Store12(u8* dst, __m128i v)
+{
+	_mm_storel_epi64((__m128i*) dst, v);
+	i32 last = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+	memcpy(dst + 8, &last, sizeof(last));
+}
+#endif
+#endif
+
+// NOTE: Returns the number of pixels converted. Always a multiple of 8.
+inline u32
+ConvertRowSIMD(PixelConverter& converter, u8* dst, u8* src, u32 width, u32 y)
+{
+	u32 x = 0;
+	#if LHM_SIMD
+	u8* offsets = converter.offsets[y % DitherSize][0];
+
+	if (converter.format == PixelFormat::RGB565)
+	{
+		#if LHM_SIMD >= 2
+		// NOTE: 16 pixels is exactly one row of offsets
+		__m256i o0 = _mm256_loadu_si256((__m256i*) &offsets[0]);
+		__m256i o1 = _mm256_loadu_si256((__m256i*) &offsets[32]);
+		for (; x + 16 <= width; x += 16)
+		{
+			__m256i p0 = _mm256_adds_epu8(_mm256_loadu_si256((__m256i*) &src[4 * x +  0]), o0);
+			__m256i p1 = _mm256_adds_epu8(_mm256_loadu_si256((__m256i*) &src[4 * x + 32]), o1);
+
+			// NOTE: Packing works within 128 bit lanes, so put the 64 bit halves back in order
+			__m256i packed = _mm256_packs_epi32(SIMD_PackRGB565(p0), SIMD_PackRGB565(p1));
+			packed = _mm256_permute4x64_epi64(packed, 0xD8);
+			_mm256_storeu_si256((__m256i*) &dst[2 * x], packed);
+		}
+		#endif
+
+		for (; x + 8 <= width; x += 8)
+		{
+			u8* o = &offsets[4 * (x % DitherSize)];
+			__m128i p0 = _mm_adds_epu8(_mm_loadu_si128((__m128i*) &src[4 * x +  0]), _mm_loadu_si128((__m128i*) &o[ 0]));
+			__m128i p1 = _mm_adds_epu8(_mm_loadu_si128((__m128i*) &src[4 * x + 16]), _mm_loadu_si128((__m128i*) &o[16]));
+
+			__m128i packed = _mm_packs_epi32(SIMD_PackRGB565(p0), SIMD_PackRGB565(p1));
+			_mm_storeu_si128((__m128i*) &dst[2 * x], packed);
+		}
+	}
+	else
+	{
+		#if LHM_SIMD >= 2
+		// NOTE: BGRA to RGB within each 128 bit lane, keeping the top 6 bits of each channel
+		__m256i mask    = _mm256_set1_epi32(0x00FCFCFC);
+		__m256i shuffle = _mm256_setr_epi8(
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+		for (; x + 8 <= width; x += 8)
+		{
+			__m256i o = _mm256_loadu_si256((__m256i*) &offsets[4 * (x % DitherSize)]);
+			__m256i p = _mm256_adds_epu8(_mm256_loadu_si256((__m256i*) &src[4 * x]), o);
+			p = _mm256_shuffle_epi8(_mm256_and_si256(p, mask), shuffle);
+
+			SIMD_Store12(&dst[3 * x +  0], _mm256_castsi256_si128(p));
+			SIMD_Store12(&dst[3 * x + 12], _mm256_extracti128_si256(p, 1));
+		}
+		#else
+		// NOTE: SSE2 can't shuffle bytes, so only the add and mask are vectorized
+		__m128i mask = _mm_set1_epi32(0x00FCFCFC);
+		for (; x + 8 <= width; x += 8)
+		{
+			u8* o = &offsets[4 * (x % DitherSize)];
+			__m128i p0 = _mm_adds_epu8(_mm_loadu_si128((__m128i*) &src[4 * x +  0]), _mm_loadu_si128((__m128i*) &o[ 0]));
+			__m128i p1 = _mm_adds_epu8(_mm_loadu_si128((__m128i*) &src[4 * x + 16]), _mm_loadu_si128((__m128i*) &o[16]));
+
+			u8 pixels[32];
+			_mm_storeu_si128((__m128i*) &pixels[ 0], _mm_and_si128(p0, mask));
+			_mm_storeu_si128((__m128i*) &pixels[16], _mm_and_si128(p1, mask));
+
+			u8* out = &dst[3 * x];
+			for (u32 i = 0; i < 8; i++)
+			{
+				out[3 * i + 0] = pixels[4 * i + 2];
+				out[3 * i + 1] = pixels[4 * i + 1];
+				out[3 * i + 2] = pixels[4 * i + 0];
+			}
+		}
+		#endif
+	}
+	#else
+	Unused(converter, dst, src, width, y);
+	#endif
+	return x;
+}
+
+// NOTE: Converts a BGRA8 frame into buffer and returns the converted bytes. buffer is reused between
+// frames so this only allocates when the size or format changes.
+inline ByteSlice
+Pixels_Convert(PixelConverter& converter, CPUTextureBytes frame, Bytes& buffer)
+{
+	Assert(frame.pixelStride == 4);
+	Assert(frame.rowStride >= 4 * frame.size.x);
+
+	u32 bpp      = PixelFormat_BytesPerPixel(converter.format);
+	u32 rowBytes = bpp * frame.size.x;
+	List_Reserve(buffer, rowBytes * frame.size.y);
+	buffer.length = rowBytes * frame.size.y;
+
+	for (u32 y = 0; y < frame.size.y; y++)
+	{
+		u8* src = &frame.bytes.data[y * frame.rowStride];
+		u8* dst = &buffer.data[y * rowBytes];
+
+		u32 x = ConvertRowSIMD(converter, dst, src, frame.size.x, y);
+		ConvertRowScalar(converter, dst, src, x, frame.size.x, y);
+	}
+
+	return buffer;
+}
@@ -30,13 +30,67 @@ enum struct PipeState
 	Disconnected,
 };
 
+enum struct PipeTransport
+{
+	Null,
+	NamedPipe,
+	SharedMemory,
+};
+
 struct PipeImpl;
 struct Pipe
 {
-	String    name;
-	PipeState state;
-	b8        isServer;
-	PipeImpl* impl;
+	String        name;
+	PipeState     state;
+	b8            isServer;
+	PipeTransport transport;
+	PipeImpl*     impl;
+};
+
+struct DirectoryWatchImpl;
+struct DirectoryWatch
+{
+	String              path;
+	DirectoryWatchImpl* impl;
+};
+
+struct SharedMemory
+{
+	String name;
+	void*  data;
+	u32    size;
+	b8     isOwner;
+	void*  handle;
+};
+
+struct Process
+{
+	i64   id;
+	void* handle;
+};
+
+struct WorkQueueImpl;
+struct WorkQueue
+{
+	u32            threadCount;
+	WorkQueueImpl* impl;
+};
+
+using WorkFn = void(void* data);
+
+// NOTE: How a mapped file is going to be read. Passed on to the OS as a paging hint.
+enum struct FileAccess
+{
+	Null,
+	Sequential,
+	Random,
+};
+
+enum struct LogOverflow
+{
+	Null,
+	Drop,
+	Block,
 };
 
 enum struct PipeResult
@@ -61,9 +115,17 @@ template<u32 PlaceholderCount, typename... Args>
 inline void
 Platform_LogChecked(Severity severity, Location location, StringView format, Args... args);
 
+b8         Platform_InitializeLog          (LogOverflow overflow);
+void       Platform_TeardownLog            ();
+void       Platform_FlushLog               ();
+u64        Platform_GetDroppedLogCount     ();
+void       Platform_PrintBytes             (StringView prefix, ByteSlice bytes);
+
 b8         Platform_WriteFileBytes         (StringView path, ByteSlice bytes);
 Bytes      Platform_LoadFileBytes          (StringView path);
 String     Platform_LoadFileString         (StringView path);
+ByteSlice  Platform_MapFile                (StringView path, FileAccess access, b8 required);
+void       Platform_UnmapFile              (ByteSlice& bytes);
 i64        Platform_GetTicks               ();
 r32        Platform_TicksToSeconds         (i64 ticks);
 i64        Platform_SecondsToTicks         (r32 seconds);
@@ -74,8 +136,27 @@ r32        Platform_GetElapsedMilliseconds (i64 startTicks, i64 endTicks);
 void       Platform_Sleep                  (u32 ms);
 void       Platform_RequestQuit            ();
 
-PipeResult Platform_CreatePipeServer       (StringView name, Pipe&);
-PipeResult Platform_CreatePipeClient       (StringView name, Pipe&);
+b8         Platform_CreateDirectoryWatch   (StringView path, DirectoryWatch&);
+void       Platform_DestroyDirectoryWatch  (DirectoryWatch&);
+b8         Platform_ReadDirectoryWatch     (DirectoryWatch&, List<String>& changedFiles);
+
+b8         Platform_CreateSharedMemory     (StringView name, u32 size, SharedMemory&);
+b8         Platform_OpenSharedMemory       (StringView name, u32 size, SharedMemory&);
+void       Platform_DestroySharedMemory    (SharedMemory&);
+
+b8         Platform_LaunchProcess          (StringView path, Slice<StringView> args, Process&);
+b8         Platform_IsProcessRunning       (Process&);
+void       Platform_TerminateProcess       (Process&);
+void       Platform_DestroyProcess         (Process&);
+
+u32        Platform_GetProcessorCount      ();
+b8         Platform_CreateWorkQueue        (u32 threadCount, WorkQueue&);
+void       Platform_DestroyWorkQueue       (WorkQueue&);
+void       Platform_PushWork               (WorkQueue&, WorkFn*, void* data);
+void*      Platform_PopFinishedWork        (WorkQueue&, b8 wait);
+
+PipeResult Platform_CreatePipeServer       (StringView name, Pipe&, PipeTransport = PipeTransport::NamedPipe);
+PipeResult Platform_CreatePipeClient       (StringView name, Pipe&, PipeTransport = PipeTransport::NamedPipe);
 void       Platform_DestroyPipe            (Pipe&);
 PipeResult Platform_ConnectPipe            (Pipe&);
 PipeResult Platform_DisconnectPipe         (Pipe&);
@@ -86,8 +167,8 @@ PipeResult Platform_FlushPipe              (Pipe&);
 
 #define LOCATION { __FILE__, __LINE__, __FUNCTION__ }
 #if true
-#define LOG(severity, format, ...) Platform_Log(severity, LOCATION, format, __VA_ARGS__)
-#define LOG_IF(expression, action, severity, format, ...) IF(expression, LOG(severity, format, __VA_ARGS__); action)
+#define LOG(severity, format, ...) Platform_Log(severity, LOCATION, format, ##__VA_ARGS__)
+#define LOG_IF(expression, action, severity, format, ...) IF(expression, LOG(severity, format, ##__VA_ARGS__); action)
 #else
 #define LOG(severity, format, ...)
 #define LOG_IF(expression, action, severity, format, ...)
@@ -95,30 +176,8 @@ PipeResult Platform_FlushPipe              (Pipe&);
 
 // TODO: This belongs in LHMBytes, but it introduces a dependency on platform.h which currently
 // isn't part of the public API.
-void
+inline void
 Bytes_Print(StringView prefix, ByteSlice bytes)
 {
-	if (bytes.length == 0) return;
-
-	String string = {};
-	defer { String_Free(string); };
-
-	for (u32 i = 0; i < 2; i++)
-	{
-		u32 length = 0;
-		length += ToStringf(string, "%s ", prefix.data);
-		length += ToStringf(string, "0x%.2X", bytes[0]);
-		for (u32 j = 1; j < bytes.length; j++)
-			length += ToStringf(string, " 0x%.2X", bytes[j]);
-
-		if (i == 0)
-			String_Reserve(string, length + 2);
-	}
-	string.data[string.length++] = '\n';
-	string.data[string.length] = '\0';
-
-	// TODO: Doesn't work :(
-	//Platform_Print(string);
-
-	Platform_Print("%", string.data);
+	Platform_PrintBytes(prefix, bytes);
 }
@@ -0,0 +1,1533 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+// -------------------------------------------------------------------------------------------------
+// Logging
+
+// NOTE: Unlike Windows, records are formatted and written on the calling thread. Nothing on Linux
+// logs enough to need the record ring yet, so the overflow policy is ignored and nothing is dropped.
+
+static void
+Log_Write(StringView string)
+{
+	fwrite(string.data, 1, string.length, stdout);
+}
+
+void
+Platform_PrintBytes(StringView prefix, ByteSlice bytes)
+{
+	static const c8 hexDigits[] = "0123456789ABCDEF";
+
+	String string = {};
+	defer { String_Free(string); };
+	String_Reserve(string, prefix.length + 5 * bytes.length + 2);
+
+	memcpy(string.data, prefix.data, prefix.length);
+	string.length = prefix.length;
+	for (u32 i = 0; i < bytes.length; i++)
+	{
+		c8* hex = &string.data[string.length];
+		hex[0] = ' ';
+		hex[1] = '0';
+		hex[2] = 'x';
+		hex[3] = hexDigits[bytes[i] >> 4];
+		hex[4] = hexDigits[bytes[i] & 0xF];
+		string.length += 5;
+	}
+	string.data[string.length++] = '\n';
+	string.data[string.length]   = '\0';
+
+	Log_Write(string);
+}
+
+template<u32 PlaceholderCount, typename... Args>
+inline void
+Platform_PrintChecked(StringView format, Args... args)
+{
+	static_assert(PlaceholderCount == sizeof...(Args));
+	Platform_PrintImpl(format, args...);
+}
+
+void
+Platform_PrintImpl(StringView message)
+{
+	Log_Write(message);
+}
+
+template<typename... Args>
+inline void
+Platform_PrintImpl(StringView format, Args... args)
+{
+	String message = String_FormatImpl(format, args...);
+	defer { String_Free(message); };
+
+	Log_Write(message);
+}
+
+template<u32 PlaceholderCount, typename... Args>
+inline void
+Platform_LogChecked(Severity severity, Location location, StringView format, Args... args)
+{
+	static_assert(PlaceholderCount == sizeof...(Args));
+	Platform_LogImpl(severity, location, format, args...);
+}
+
+void
+Platform_LogImpl(Severity severity, Location location, StringView message)
+{
+	AssertOrUnused(severity != Severity::Null);
+
+	String string = String_Format("% - %\n\t%(%)\n", location.function, message, location.file, location.line);
+	defer { String_Free(string); };
+
+	Log_Write(string);
+}
+
+template<typename... Args>
+inline void
+Platform_LogImpl(Severity severity, Location location, StringView format, Args... args)
+{
+	String message = String_FormatImpl(format, args...);
+	defer { String_Free(message); };
+
+	Platform_LogImpl(severity, location, message);
+}
+
+b8
+Platform_InitializeLog(LogOverflow overflow)
+{
+	Unused(overflow);
+	return true;
+}
+
+void
+Platform_TeardownLog()
+{
+	fflush(stdout);
+}
+
+void
+Platform_FlushLog()
+{
+	fflush(stdout);
+}
+
+u64
+Platform_GetDroppedLogCount()
+{
+	return 0;
+}
+
+void
+LogErrno(i32 error, Severity severity, Location location, StringView message)
+{
+	Platform_Log(severity, location, "%: % (%)", message, strerror(error), error);
+}
+
+template<typename... Args>
+inline void
+LogErrno(Severity severity, Location location, StringView format, Args... args)
+{
+	i32 error = errno;
+
+	String message = String_FormatImpl(format, args...);
+	defer { String_Free(message); };
+
+	LogErrno(error, severity, location, message);
+}
+#define LOG_ERRNO(severity, format, ...) LogErrno(severity, LOCATION, format, ##__VA_ARGS__)
+#define LOG_ERRNO_IF(expression, action, severity, format, ...) IF(expression, LOG_ERRNO(severity, format, ##__VA_ARGS__); action)
+
+// -------------------------------------------------------------------------------------------------
+// Directory Watches
+
+// NOTE: Each watch is a non-blocking inotify instance. Only files that were closed after being
+// written or moved into the directory are reported, so a file is never seen half written by a
+// compiler or linker that writes in place, or by one that writes a temporary file and renames it.
+
+struct DirectoryWatchImpl
+{
+	i32 inotify;
+};
+
+static void
+DirectoryWatch_AddChange(List<String>& changedFiles, StringView fileName)
+{
+	for (u32 i = 0; i < changedFiles.length; i++)
+		if (String_Equal(changedFiles[i], fileName))
+			return;
+
+	List_Append(changedFiles, String_FromView(fileName));
+}
+
+b8
+Platform_CreateDirectoryWatch(StringView path, DirectoryWatch& watch)
+{
+	auto cleanupGuard = guard { Platform_DestroyDirectoryWatch(watch); };
+
+	watch = {};
+	watch.path = String_FromView(path);
+	watch.impl = (DirectoryWatchImpl*) AllocChecked(sizeof(DirectoryWatchImpl));
+	*watch.impl = {};
+	watch.impl->inotify = -1;
+
+	watch.impl->inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	LOG_ERRNO_IF(watch.impl->inotify < 0, return false,
+		Severity::Warning, "Failed to create directory watch '%'", path);
+
+	i32 result = inotify_add_watch(watch.impl->inotify, path.data, IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR);
+	LOG_ERRNO_IF(result < 0, return false,
+		Severity::Warning, "Failed to watch directory '%'", path);
+
+	cleanupGuard.dismiss = true;
+	return true;
+}
+
+void
+Platform_DestroyDirectoryWatch(DirectoryWatch& watch)
+{
+	if (watch.impl)
+	{
+		if (watch.impl->inotify >= 0)
+			close(watch.impl->inotify);
+		Free(watch.impl);
+	}
+
+	String_Free(watch.path);
+	watch = {};
+}
+
+b8
+Platform_ReadDirectoryWatch(DirectoryWatch& watch, List<String>& changedFiles)
+{
+	alignas(inotify_event) c8 buffer[4096];
+
+	for (;;)
+	{
+		ssize_t length = read(watch.impl->inotify, buffer, sizeof(buffer));
+		if (length < 0)
+		{
+			if (errno == EAGAIN) return true;
+			LOG_ERRNO(Severity::Warning, "Failed to read directory watch '%'", watch.path);
+			return false;
+		}
+
+		for (c8* cursor = buffer; cursor < buffer + length;)
+		{
+			inotify_event& event = *(inotify_event*) cursor;
+			cursor += sizeof(inotify_event) + event.len;
+
+			LOG_IF(event.mask & IN_Q_OVERFLOW, continue,
+				Severity::Warning, "Directory watch overflowed, changes were lost '%'", watch.path);
+			if (event.len == 0) continue;
+
+			// NOTE: The name is null padded to an alignment boundary
+			StringView fileName = {};
+			fileName.data   = event.name;
+			fileName.length = (u32) strlen(event.name);
+			DirectoryWatch_AddChange(changedFiles, fileName);
+		}
+	}
+}
+
+// -------------------------------------------------------------------------------------------------
+// Files
+
+static String
+GetWorkingDirectory()
+{
+	String result = {};
+	String_Reserve(result, PATH_MAX);
+
+	if (!getcwd(result.data, result.capacity))
+	{
+		LOG_ERRNO(Severity::Warning, "Failed to get working directory");
+		result.data[0] = '\0';
+		return result;
+	}
+
+	result.length = (u32) strlen(result.data);
+	return result;
+}
+
+b8
+Platform_WriteFileBytes(StringView path, ByteSlice bytes)
+{
+	Assert(!Slice_IsSparse(bytes));
+
+	String cwd = {};
+	defer { String_Free(cwd); };
+	auto getCWD = [&cwd]() {
+		cwd = GetWorkingDirectory();
+		return cwd;
+	};
+
+	i32 fd = open(path.data, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	LOG_ERRNO_IF(fd < 0, return false,
+		Severity::Warning, "Failed to open file '%'; CWD: '%'", path, getCWD());
+	defer { close(fd); };
+
+	u32 written = 0;
+	while (written < bytes.length)
+	{
+		ssize_t result = write(fd, &bytes.data[written], bytes.length - written);
+		if (result < 0 && errno == EINTR) continue;
+		LOG_ERRNO_IF(result < 0, return false,
+			Severity::Warning, "Failed to write file '%'; CWD: '%'", path, getCWD());
+
+		written += (u32) result;
+	}
+
+	return true;
+}
+
+static Bytes
+LoadFile(StringView path, u32 padding = 0)
+{
+	Bytes result = {};
+	auto resultGuard = guard { List_Free(result); };
+
+	i32 fd = open(path.data, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		String cwd = GetWorkingDirectory();
+		defer { String_Free(cwd); };
+		LOG_ERRNO(Severity::Warning, "Failed to open file '%'; CWD: '%'", path, cwd);
+		return result;
+	}
+	defer { close(fd); };
+
+	struct stat info = {};
+	i32 error = fstat(fd, &info);
+	LOG_ERRNO_IF(error < 0, return result,
+		Severity::Warning, "Failed to get file size '%'", path);
+	LOG_IF((u64) info.st_size > u32Max - padding, return result,
+		Severity::Warning, "File is too large to load '%'", path);
+
+	u32 size = (u32) info.st_size;
+	List_Reserve(result, size + padding);
+
+	while (result.length < size)
+	{
+		ssize_t length = read(fd, &result.data[result.length], size - result.length);
+		if (length < 0 && errno == EINTR) continue;
+		LOG_ERRNO_IF(length < 0, return result,
+			Severity::Warning, "Failed to read file '%'", path);
+		if (length == 0) break;
+
+		result.length += (u32) length;
+	}
+
+	resultGuard.dismiss = true;
+	return result;
+}
+
+Bytes
+Platform_LoadFileBytes(StringView path)
+{
+	return LoadFile(path, 0);
+}
+
+String
+Platform_LoadFileString(StringView path)
+{
+	String result = {};
+
+	Bytes bytes = LoadFile(path, 1);
+	if (!bytes.data) return result;
+
+	result.length   = bytes.length;
+	result.capacity = bytes.capacity;
+	result.data     = (c8*) bytes.data;
+
+	result[result.length++] = '\0';
+
+	return result;
+}
+
+// NOTE: Files are mapped privately and read only, so pages are shared with the page cache and with
+// any other process mapping the same file. The descriptor isn't needed once the mapping exists. A
+// file that isn't required can be missing without a warning.
+ByteSlice
+Platform_MapFile(StringView path, FileAccess access, b8 required)
+{
+	ByteSlice result = {};
+
+	i32 fd = open(path.data, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		b8 missing = errno == ENOENT || errno == ENOTDIR;
+		if (missing && !required) return result;
+
+		String cwd = GetWorkingDirectory();
+		defer { String_Free(cwd); };
+		LOG_ERRNO(Severity::Warning, "Failed to open file '%'; CWD: '%'", path, cwd);
+		return result;
+	}
+	defer { close(fd); };
+
+	struct stat info = {};
+	i32 error = fstat(fd, &info);
+	LOG_ERRNO_IF(error < 0, return result,
+		Severity::Warning, "Failed to get file size '%'", path);
+	LOG_IF((u64) info.st_size > u32Max, return result,
+		Severity::Warning, "File is too large to map '%'", path);
+	// NOTE: Empty files can't be mapped
+	LOG_IF(info.st_size == 0, return result,
+		Severity::Warning, "File is empty '%'", path);
+
+	void* data = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	LOG_ERRNO_IF(data == MAP_FAILED, return result,
+		Severity::Warning, "Failed to map file '%'", path);
+
+	result.data   = (u8*) data;
+	result.length = (u32) info.st_size;
+
+	// NOTE: Sequential readers consume the whole file, so start reading it in right away
+	i32 advice = access == FileAccess::Random ? MADV_RANDOM : MADV_SEQUENTIAL;
+	error = madvise(data, result.length, advice);
+	LOG_ERRNO_IF(error < 0, IGNORE,
+		Severity::Info, "Failed to advise mapped file '%'", path);
+
+	if (access == FileAccess::Sequential)
+	{
+		error = madvise(data, result.length, MADV_WILLNEED);
+		LOG_ERRNO_IF(error < 0, IGNORE,
+			Severity::Info, "Failed to prefetch mapped file '%'", path);
+	}
+
+	return result;
+}
+
+void
+Platform_UnmapFile(ByteSlice& bytes)
+{
+	if (!bytes.data) return;
+
+	i32 error = munmap(bytes.data, bytes.length);
+	LOG_ERRNO_IF(error < 0, IGNORE,
+		Severity::Warning, "Failed to unmap file");
+
+	bytes = {};
+}
+
+// -------------------------------------------------------------------------------------------------
+// Time
+
+// NOTE: Ticks are nanoseconds of CLOCK_MONOTONIC
+const i64 TicksPerSecond = 1'000'000'000;
+
+i64
+Platform_GetTicks()
+{
+	timespec time = {};
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (i64) time.tv_sec * TicksPerSecond + time.tv_nsec;
+}
+
+r32
+Platform_TicksToSeconds(i64 ticks)
+{
+	return (r32) ((r64) ticks / TicksPerSecond);
+}
+
+i64
+Platform_SecondsToTicks(r32 seconds)
+{
+	return (i64) ((r64) seconds * TicksPerSecond);
+}
+
+r32
+Platform_GetElapsedSeconds(i64 startTicks)
+{
+	i64 elapsedTicks = Platform_GetTicks() - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks);
+}
+
+r32
+Platform_GetElapsedSeconds(i64 startTicks, i64 endTicks)
+{
+	i64 elapsedTicks = endTicks - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks);
+}
+
+r32
+Platform_GetElapsedMilliseconds(i64 startTicks)
+{
+	i64 elapsedTicks = Platform_GetTicks() - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks) * 1000.0f;
+}
+
+r32
+Platform_GetElapsedMilliseconds(i64 startTicks, i64 endTicks)
+{
+	i64 elapsedTicks = endTicks - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks) * 1000.0f;
+}
+
+void
+Platform_Sleep(u32 ms)
+{
+	timespec time = {};
+	time.tv_sec  = ms / 1000;
+	time.tv_nsec = (ms % 1000) * 1'000'000L;
+	while (nanosleep(&time, &time) < 0 && errno == EINTR) {}
+}
+
+// NOTE: There's no message loop to post to. The default SIGTERM action ends the process, and a main
+// that wants to shut down cleanly can catch it.
+void
+Platform_RequestQuit()
+{
+	raise(SIGTERM);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Shared Memory
+
+// NOTE: POSIX shared memory objects outlive every process that maps them, so the owner unlinks the
+// name when it's done and unlinks any stale object left behind by a crash before creating a new one.
+
+static b8
+SharedMemory_Map(SharedMemory& memory, i32 fd)
+{
+	memory.data = mmap(nullptr, memory.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (memory.data == MAP_FAILED)
+	{
+		memory.data = nullptr;
+		LOG_ERRNO(Severity::Warning, "Failed to map shared memory '%'", memory.name);
+		return false;
+	}
+
+	return true;
+}
+
+b8
+Platform_CreateSharedMemory(StringView name, u32 size, SharedMemory& memory)
+{
+	auto cleanupGuard = guard { Platform_DestroySharedMemory(memory); };
+
+	memory = {};
+	memory.name = String_Format("/%", name);
+	memory.size = size;
+
+	shm_unlink(memory.name.data);
+
+	i32 fd = shm_open(memory.name.data, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+	LOG_ERRNO_IF(fd < 0, return false,
+		Severity::Warning, "Failed to create shared memory '%'", name);
+	defer { close(fd); };
+	memory.isOwner = true;
+
+	i32 result = ftruncate(fd, size);
+	LOG_ERRNO_IF(result < 0, return false,
+		Severity::Warning, "Failed to size shared memory '%'", name);
+
+	b8 success = SharedMemory_Map(memory, fd);
+	if (!success) return false;
+
+	cleanupGuard.dismiss = true;
+	return true;
+}
+
+b8
+Platform_OpenSharedMemory(StringView name, u32 size, SharedMemory& memory)
+{
+	auto cleanupGuard = guard { Platform_DestroySharedMemory(memory); };
+
+	memory = {};
+	memory.name = String_Format("/%", name);
+	memory.size = size;
+
+	i32 fd = shm_open(memory.name.data, O_RDWR | O_CLOEXEC, 0);
+	LOG_ERRNO_IF(fd < 0, return false,
+		Severity::Warning, "Failed to open shared memory '%'", name);
+	defer { close(fd); };
+
+	b8 success = SharedMemory_Map(memory, fd);
+	if (!success) return false;
+
+	cleanupGuard.dismiss = true;
+	return true;
+}
+
+void
+Platform_DestroySharedMemory(SharedMemory& memory)
+{
+	if (memory.data)
+		munmap(memory.data, memory.size);
+
+	if (memory.isOwner)
+		shm_unlink(memory.name.data);
+
+	String_Free(memory.name);
+	memory = {};
+}
+
+// -------------------------------------------------------------------------------------------------
+// Processes
+
+b8
+Platform_LaunchProcess(StringView path, Slice<StringView> args, Process& process)
+{
+	process = {};
+
+	List<c8*> argv = {};
+	defer { List_Free(argv); };
+
+	List_Reserve(argv, args.length + 2);
+	List_Append(argv, path.data);
+	for (u32 i = 0; i < args.length; i++)
+		List_Append(argv, args[i].data);
+	List_Append(argv, (c8*) nullptr);
+
+	pid_t pid;
+	i32 result = posix_spawn(&pid, path.data, nullptr, nullptr, argv.data, environ);
+	LOG_IF(result != 0, return false,
+		Severity::Warning, "Failed to launch process '%': %", path, strerror(result));
+
+	process.id = pid;
+	return true;
+}
+
+b8
+Platform_IsProcessRunning(Process& process)
+{
+	if (process.id <= 0) return false;
+
+	// NOTE: Also reaps the process so it doesn't linger as a zombie
+	i32 status;
+	pid_t result = waitpid((pid_t) process.id, &status, WNOHANG);
+	if (result == 0) return true;
+
+	process.id = 0;
+	return false;
+}
+
+void
+Platform_TerminateProcess(Process& process)
+{
+	if (!Platform_IsProcessRunning(process)) return;
+
+	i32 result = kill((pid_t) process.id, SIGKILL);
+	LOG_ERRNO_IF(result < 0, return,
+		Severity::Warning, "Failed to terminate process %", process.id);
+
+	i32 status;
+	waitpid((pid_t) process.id, &status, 0);
+	process.id = 0;
+}
+
+void
+Platform_DestroyProcess(Process& process)
+{
+	// NOTE: The process is left running. Reap it if it has already exited.
+	Platform_IsProcessRunning(process);
+	process = {};
+}
+
+// -------------------------------------------------------------------------------------------------
+// Work Queues
+
+// NOTE: Same design as the Win32 version: a FIFO of pending items and a list of finished ones behind
+// a single mutex.
+
+struct WorkItem
+{
+	WorkFn* function;
+	void*   data;
+};
+
+struct WorkQueueImpl
+{
+	pthread_mutex_t lock;
+	pthread_cond_t  workPushed;
+	pthread_cond_t  workFinished;
+	List<WorkItem>  pending;
+	u32             pendingHead;
+	List<void*>     finished;
+	u32             outstanding;
+	b8              quit;
+	List<pthread_t> threads;
+};
+
+static void*
+WorkQueue_ThreadMain(void* parameter)
+{
+	WorkQueueImpl& impl = *(WorkQueueImpl*) parameter;
+
+	pthread_mutex_lock(&impl.lock);
+	for (;;)
+	{
+		while (!impl.quit && impl.pendingHead == impl.pending.length)
+			pthread_cond_wait(&impl.workPushed, &impl.lock);
+		if (impl.quit) break;
+
+		WorkItem item = impl.pending[impl.pendingHead++];
+		if (impl.pendingHead == impl.pending.length)
+		{
+			List_Clear(impl.pending);
+			impl.pendingHead = 0;
+		}
+
+		pthread_mutex_unlock(&impl.lock);
+		item.function(item.data);
+		pthread_mutex_lock(&impl.lock);
+
+		List_Append(impl.finished, item.data);
+		pthread_cond_signal(&impl.workFinished);
+	}
+	pthread_mutex_unlock(&impl.lock);
+
+	return nullptr;
+}
+
+u32
+Platform_GetProcessorCount()
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (u32) count : 1;
+}
+
+b8
+Platform_CreateWorkQueue(u32 threadCount, WorkQueue& queue)
+{
+	Assert(threadCount > 0);
+
+	queue = {};
+	queue.impl = (WorkQueueImpl*) AllocChecked(sizeof(WorkQueueImpl));
+	*queue.impl = {};
+	auto queueGuard = guard { Platform_DestroyWorkQueue(queue); };
+
+	WorkQueueImpl& impl = *queue.impl;
+	pthread_mutex_init(&impl.lock, nullptr);
+	pthread_cond_init(&impl.workPushed, nullptr);
+	pthread_cond_init(&impl.workFinished, nullptr);
+
+	List_Reserve(impl.threads, threadCount);
+	for (u32 i = 0; i < threadCount; i++)
+	{
+		pthread_t thread;
+		i32 result = pthread_create(&thread, nullptr, WorkQueue_ThreadMain, &impl);
+		LOG_IF(result != 0, return false,
+			Severity::Error, "Failed to create work queue thread: %", strerror(result));
+
+		List_Append(impl.threads, thread);
+	}
+
+	queue.threadCount = threadCount;
+	queueGuard.dismiss = true;
+	return true;
+}
+
+void
+Platform_DestroyWorkQueue(WorkQueue& queue)
+{
+	if (!queue.impl) return;
+
+	WorkQueueImpl& impl = *queue.impl;
+	Assert(impl.outstanding == 0);
+
+	pthread_mutex_lock(&impl.lock);
+	impl.quit = true;
+	pthread_cond_broadcast(&impl.workPushed);
+	pthread_mutex_unlock(&impl.lock);
+
+	for (u32 i = 0; i < impl.threads.length; i++)
+		pthread_join(impl.threads[i], nullptr);
+
+	pthread_cond_destroy(&impl.workFinished);
+	pthread_cond_destroy(&impl.workPushed);
+	pthread_mutex_destroy(&impl.lock);
+
+	List_Free(impl.threads);
+	List_Free(impl.pending);
+	List_Free(impl.finished);
+	Free(queue.impl);
+	queue = {};
+}
+
+void
+Platform_PushWork(WorkQueue& queue, WorkFn* function, void* data)
+{
+	WorkQueueImpl& impl = *queue.impl;
+
+	pthread_mutex_lock(&impl.lock);
+	WorkItem& item = List_Append(impl.pending);
+	item.function = function;
+	item.data     = data;
+	impl.outstanding++;
+	pthread_cond_signal(&impl.workPushed);
+	pthread_mutex_unlock(&impl.lock);
+}
+
+void*
+Platform_PopFinishedWork(WorkQueue& queue, b8 wait)
+{
+	WorkQueueImpl& impl = *queue.impl;
+
+	void* result = nullptr;
+	pthread_mutex_lock(&impl.lock);
+	{
+		Assert(!wait || impl.outstanding > 0);
+		while (wait && impl.finished.length == 0)
+			pthread_cond_wait(&impl.workFinished, &impl.lock);
+
+		if (impl.finished.length)
+		{
+			result = impl.finished[impl.finished.length - 1];
+			List_RemoveLast(impl.finished);
+			impl.outstanding--;
+		}
+	}
+	pthread_mutex_unlock(&impl.lock);
+
+	return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Pipes
+
+// NOTE: Pipes are non-blocking AF_UNIX SOCK_SEQPACKET sockets. They preserve message boundaries the
+// same way message mode named pipes do, so a read always returns exactly one message. Sockets live
+// in the abstract namespace so a crashed server doesn't leave a stale file behind. Readiness and
+// hangups come from a per-pipe epoll set that is polled without waiting once per update, and writes
+// that don't fit in the socket buffer fail transiently instead of blocking the caller.
+
+// NOTE: The shared memory transport uses the socket only to manage the connection. Once a client
+// connects the server sends it a memfd holding one single producer single consumer ring per
+// direction and messages are copied straight into and out of the mapping. Every connection gets a
+// fresh memfd so there's nothing to reset or clean up if either end crashes. Both ends poll once
+// per frame so there's no blocked reader to wake.
+
+const u32 PipeBufferSize         = 1 * Megabyte;
+const u32 SharedPipeRingCapacity = 1 * Megabyte;
+
+struct SharedPipeRing
+{
+	i64 writeCursor;
+	u8  writePadding[56];
+	i64 readCursor;
+	u8  readPadding[56];
+	u8  data[SharedPipeRingCapacity];
+};
+
+struct SharedPipeHeader
+{
+	SharedPipeRing rings[2]; // [0] server to client, [1] client to server
+};
+
+struct PipeImpl
+{
+	String fullName;
+	i32    listener;
+	i32    socket;
+	i32    epoll;
+	b8     readable;
+	b8     hangup;
+
+	// Shared memory transport
+	SharedPipeHeader* shared;
+};
+
+static b8
+IsValidFd(i32 fd)
+{
+	return fd >= 0;
+}
+
+static void
+Pipe_Close(i32& fd)
+{
+	if (IsValidFd(fd))
+		close(fd);
+	fd = -1;
+}
+
+static u32
+Pipe_Address(Pipe& pipe, sockaddr_un& address)
+{
+	// NOTE: A leading null selects the abstract namespace
+	address = {};
+	address.sun_family = AF_UNIX;
+
+	u32 length = Min(pipe.impl->fullName.length, (u32) sizeof(address.sun_path) - 1);
+	memcpy(&address.sun_path[1], pipe.impl->fullName.data, length);
+	return (u32) offsetof(sockaddr_un, sun_path) + 1 + length;
+}
+
+static b8
+Pipe_Watch(Pipe& pipe, i32 fd, u32 events)
+{
+	epoll_event event = {};
+	event.events  = events;
+	event.data.fd = fd;
+
+	i32 result = epoll_ctl(pipe.impl->epoll, EPOLL_CTL_ADD, fd, &event);
+	LOG_ERRNO_IF(result < 0, return false,
+		Severity::Warning, "Failed to watch pipe '%'", pipe.name);
+
+	return true;
+}
+
+static b8
+Pipe_SetBufferSize(Pipe& pipe, i32 fd)
+{
+	i32 size = (i32) PipeBufferSize;
+
+	i32 result = setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+	LOG_ERRNO_IF(result < 0, return false,
+		Severity::Warning, "Failed to set pipe send buffer size '%'", pipe.name);
+
+	result = setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+	LOG_ERRNO_IF(result < 0, return false,
+		Severity::Warning, "Failed to set pipe receive buffer size '%'", pipe.name);
+
+	return true;
+}
+
+static void
+SharedPipe_CopyIn(SharedPipeRing& ring, i64 cursor, const void* data, u32 size)
+{
+	u32 offset = (u32) (cursor & (SharedPipeRingCapacity - 1));
+	u32 first  = Min(size, SharedPipeRingCapacity - offset);
+	memcpy(&ring.data[offset], data, first);
+	memcpy(&ring.data[0], (u8*) data + first, size - first);
+}
+
+static void
+SharedPipe_CopyOut(SharedPipeRing& ring, i64 cursor, void* data, u32 size)
+{
+	u32 offset = (u32) (cursor & (SharedPipeRingCapacity - 1));
+	u32 first  = Min(size, SharedPipeRingCapacity - offset);
+	memcpy(data, &ring.data[offset], first);
+	memcpy((u8*) data + first, &ring.data[0], size - first);
+}
+
+static void
+SharedPipe_Unmap(Pipe& pipe)
+{
+	if (pipe.impl->shared)
+		munmap(pipe.impl->shared, sizeof(SharedPipeHeader));
+	pipe.impl->shared = nullptr;
+}
+
+static b8
+SharedPipe_Map(Pipe& pipe, i32 fd)
+{
+	void* shared = mmap(nullptr, sizeof(SharedPipeHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	LOG_ERRNO_IF(shared == MAP_FAILED, return false,
+		Severity::Warning, "Failed to map shared memory pipe '%'", pipe.name);
+
+	pipe.impl->shared = (SharedPipeHeader*) shared;
+	return true;
+}
+
+static PipeResult
+SharedPipe_Send(Pipe& pipe)
+{
+	i32 fd = memfd_create(pipe.impl->fullName.data, MFD_CLOEXEC);
+	LOG_ERRNO_IF(fd < 0, return PipeResult::UnexpectedFailure,
+		Severity::Warning, "Failed to create shared memory pipe '%'", pipe.name);
+	defer { close(fd); };
+
+	i32 result = ftruncate(fd, sizeof(SharedPipeHeader));
+	LOG_ERRNO_IF(result < 0, return PipeResult::UnexpectedFailure,
+		Severity::Warning, "Failed to size shared memory pipe '%'", pipe.name);
+
+	if (!SharedPipe_Map(pipe, fd)) return PipeResult::UnexpectedFailure;
+
+	u8 payload = 0;
+	iovec io = {};
+	io.iov_base = &payload;
+	io.iov_len  = sizeof(payload);
+
+	alignas(cmsghdr) u8 control[CMSG_SPACE(sizeof(i32))] = {};
+	msghdr message = {};
+	message.msg_iov        = &io;
+	message.msg_iovlen     = 1;
+	message.msg_control    = control;
+	message.msg_controllen = sizeof(control);
+
+	cmsghdr* header = CMSG_FIRSTHDR(&message);
+	header->cmsg_level = SOL_SOCKET;
+	header->cmsg_type  = SCM_RIGHTS;
+	header->cmsg_len   = CMSG_LEN(sizeof(i32));
+	memcpy(CMSG_DATA(header), &fd, sizeof(i32));
+
+	ssize_t sent = sendmsg(pipe.impl->socket, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+	LOG_ERRNO_IF(sent != sizeof(payload), SharedPipe_Unmap(pipe); return PipeResult::UnexpectedFailure,
+		Severity::Warning, "Failed to send shared memory pipe '%'", pipe.name);
+
+	return PipeResult::Success;
+}
+
+static PipeResult
+SharedPipe_Receive(Pipe& pipe)
+{
+	u8 payload;
+	iovec io = {};
+	io.iov_base = &payload;
+	io.iov_len  = sizeof(payload);
+
+	alignas(cmsghdr) u8 control[CMSG_SPACE(sizeof(i32))] = {};
+	msghdr message = {};
+	message.msg_iov        = &io;
+	message.msg_iovlen     = 1;
+	message.msg_control    = control;
+	message.msg_controllen = sizeof(control);
+
+	ssize_t received = recvmsg(pipe.impl->socket, &message, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+	if (received < 0)
+	{
+		switch (errno)
+		{
+			// Server hasn't sent the mapping yet
+			case EAGAIN:
+				return PipeResult::TransientFailure;
+
+			default:
+				LOG_ERRNO(Severity::Warning, "Failed to receive shared memory pipe '%'", pipe.name);
+				return PipeResult::UnexpectedFailure;
+		}
+	}
+
+	cmsghdr* header = CMSG_FIRSTHDR(&message);
+	LOG_IF(!header || header->cmsg_type != SCM_RIGHTS, return PipeResult::UnexpectedFailure,
+		Severity::Error, "Server did not send a shared memory pipe '%'", pipe.name);
+
+	i32 fd;
+	memcpy(&fd, CMSG_DATA(header), sizeof(i32));
+	defer { close(fd); };
+
+	if (!SharedPipe_Map(pipe, fd)) return PipeResult::UnexpectedFailure;
+	return PipeResult::Success;
+}
+
+static PipeResult
+SharedPipe_Write(Pipe& pipe, ByteSlice bytes)
+{
+	Assert(!Slice_IsSparse(bytes));
+	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
+	if (!pipe.impl->shared) return PipeResult::TransientFailure;
+
+	u32 size = sizeof(u32) + bytes.length;
+	LOG_IF(size > SharedPipeRingCapacity, return PipeResult::UnexpectedFailure,
+		Severity::Error, "Message is too large for shared memory pipe '%'", pipe.name);
+
+	SharedPipeRing& ring = pipe.impl->shared->rings[pipe.isServer ? 0 : 1];
+	i64 writeCursor = ring.writeCursor;
+	i64 readCursor  = __atomic_load_n(&ring.readCursor, __ATOMIC_ACQUIRE);
+
+	// Not enough space, try again later
+	if (SharedPipeRingCapacity - (writeCursor - readCursor) < size)
+		return PipeResult::TransientFailure;
+
+	SharedPipe_CopyIn(ring, writeCursor, &bytes.length, sizeof(u32));
+	SharedPipe_CopyIn(ring, writeCursor + sizeof(u32), bytes.data, bytes.length);
+	__atomic_store_n(&ring.writeCursor, writeCursor + size, __ATOMIC_RELEASE);
+
+	return PipeResult::Success;
+}
+
+static PipeResult
+SharedPipe_Read(Pipe& pipe, Bytes& bytes)
+{
+	bytes.length = 0;
+
+	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
+	if (!pipe.impl->shared) return PipeResult::Success;
+
+	SharedPipeRing& ring = pipe.impl->shared->rings[pipe.isServer ? 1 : 0];
+	i64 readCursor  = ring.readCursor;
+	i64 writeCursor = __atomic_load_n(&ring.writeCursor, __ATOMIC_ACQUIRE);
+	if (readCursor == writeCursor) return PipeResult::Success;
+
+	u32 length;
+	SharedPipe_CopyOut(ring, readCursor, &length, sizeof(u32));
+	LOG_IF(writeCursor - readCursor < (i64) (sizeof(u32) + length), return PipeResult::UnexpectedFailure,
+		Severity::Fatal, "Corrupted message in shared memory pipe '%'", pipe.name);
+
+	List_Reserve(bytes, length);
+	SharedPipe_CopyOut(ring, readCursor + sizeof(u32), bytes.data, length);
+	__atomic_store_n(&ring.readCursor, readCursor + sizeof(u32) + length, __ATOMIC_RELEASE);
+
+	bytes.length = length;
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_DisconnectPipe(Pipe& pipe)
+{
+	PipeState state = pipe.state;
+	pipe.state = PipeState::Disconnecting;
+
+	switch (state)
+	{
+		default:
+		case PipeState::Null:
+			Assert(false);
+			break;
+
+		// Nothing to cancel, accept is non-blocking
+		case PipeState::Connecting:
+			Assert(pipe.isServer);
+			break;
+
+		case PipeState::Disconnected:
+			break;
+
+		case PipeState::Connected:
+		case PipeState::Disconnecting:
+		{
+			// NOTE: Closing the socket removes it from the epoll set
+			SharedPipe_Unmap(pipe);
+			Pipe_Close(pipe.impl->socket);
+			pipe.impl->readable = false;
+			pipe.impl->hangup   = false;
+			break;
+		}
+	}
+
+	pipe.state = PipeState::Disconnected;
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_ConnectPipeServer(Pipe& pipe)
+{
+	// Create the platform pipe
+	if (!IsValidFd(pipe.impl->listener))
+	{
+		auto cleanupGuard = guard { Pipe_Close(pipe.impl->listener); };
+
+		pipe.impl->listener = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		LOG_ERRNO_IF(!IsValidFd(pipe.impl->listener), return PipeResult::UnexpectedFailure,
+			Severity::Warning, "Failed to create pipe server '%'", pipe.name);
+
+		sockaddr_un address;
+		u32 addressLength = Pipe_Address(pipe, address);
+		i32 result = bind(pipe.impl->listener, (sockaddr*) &address, addressLength);
+		if (result < 0)
+		{
+			switch (errno)
+			{
+				// Another server has created the pipe
+				case EADDRINUSE:
+					return PipeResult::TransientFailure;
+
+				default:
+					LOG_ERRNO(Severity::Warning, "Failed to bind pipe server '%'", pipe.name);
+					return PipeResult::UnexpectedFailure;
+			}
+		}
+
+		result = listen(pipe.impl->listener, 1);
+		LOG_ERRNO_IF(result < 0, return PipeResult::UnexpectedFailure,
+			Severity::Warning, "Failed to listen on pipe server '%'", pipe.name);
+
+		cleanupGuard.dismiss = true;
+	}
+
+	switch (pipe.state)
+	{
+		default:
+		case PipeState::Null:
+			Assert(false);
+			break;
+
+		case PipeState::Connected:
+			return PipeResult::Success;
+
+		case PipeState::Disconnecting:
+			return PipeResult::TransientFailure;
+
+		// Accept a pending connection
+		case PipeState::Disconnected:
+		case PipeState::Connecting:
+		{
+			pipe.impl->socket = accept4(pipe.impl->listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+			if (!IsValidFd(pipe.impl->socket))
+			{
+				switch (errno)
+				{
+					// No client yet
+					case EAGAIN:
+						pipe.state = PipeState::Connecting;
+						return PipeResult::TransientFailure;
+
+					// Client went away before we accepted it
+					case ECONNABORTED:
+						return PipeResult::TransientFailure;
+
+					default:
+						LOG_ERRNO(Severity::Warning, "Failed to accept pipe connection '%'", pipe.name);
+						return PipeResult::UnexpectedFailure;
+				}
+			}
+
+			pipe.state = PipeState::Connected;
+
+			b8 success = true;
+			success = success && Pipe_SetBufferSize(pipe, pipe.impl->socket);
+			success = success && Pipe_Watch(pipe, pipe.impl->socket, EPOLLIN | EPOLLRDHUP);
+			if (!success)
+			{
+				Platform_DisconnectPipe(pipe);
+				return PipeResult::UnexpectedFailure;
+			}
+
+			if (pipe.transport == PipeTransport::SharedMemory)
+			{
+				PipeResult result = SharedPipe_Send(pipe);
+				if (result != PipeResult::Success)
+				{
+					Platform_DisconnectPipe(pipe);
+					return result;
+				}
+			}
+			break;
+		}
+	}
+
+	pipe.state = PipeState::Connected;
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_ConnectPipeClient(Pipe& pipe)
+{
+	if (IsValidFd(pipe.impl->socket)) return PipeResult::Success;
+
+	auto cleanupGuard = guard { Pipe_Close(pipe.impl->socket); };
+
+	switch (pipe.state)
+	{
+		default:
+		case PipeState::Null:
+			Assert(false);
+			break;
+
+		// Impossible for client pipes
+		case PipeState::Connecting:
+			Assert(false);
+			break;
+
+		case PipeState::Connected:
+			break;
+
+		case PipeState::Disconnecting:
+			return PipeResult::TransientFailure;
+
+		case PipeState::Disconnected:
+		{
+			pipe.impl->socket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+			LOG_ERRNO_IF(!IsValidFd(pipe.impl->socket), return PipeResult::UnexpectedFailure,
+				Severity::Warning, "Failed to create pipe client '%'", pipe.name);
+
+			sockaddr_un address;
+			u32 addressLength = Pipe_Address(pipe, address);
+			i32 result = connect(pipe.impl->socket, (sockaddr*) &address, addressLength);
+			if (result < 0)
+			{
+				switch (errno)
+				{
+					// Server hasn't created the pipe yet
+					case ECONNREFUSED:
+					case ENOENT:
+						return PipeResult::TransientFailure;
+
+					// Max clients already connected
+					case EAGAIN:
+						return PipeResult::TransientFailure;
+
+					default:
+						LOG_ERRNO(Severity::Error, "Failed to connect pipe client '%'", pipe.name);
+						return PipeResult::UnexpectedFailure;
+				}
+			}
+
+			b8 success = true;
+			success = success && Pipe_SetBufferSize(pipe, pipe.impl->socket);
+			success = success && Pipe_Watch(pipe, pipe.impl->socket, EPOLLIN | EPOLLRDHUP);
+			if (!success) return PipeResult::UnexpectedFailure;
+			break;
+		}
+	}
+
+	cleanupGuard.dismiss = true;
+	pipe.state = PipeState::Connected;
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_ConnectPipe(Pipe& pipe)
+{
+	return pipe.isServer
+		? Platform_ConnectPipeServer(pipe)
+		: Platform_ConnectPipeClient(pipe);
+}
+
+PipeResult
+Platform_UpdatePipeConnection(Pipe& pipe)
+{
+	PipeResult result = Platform_ConnectPipe(pipe);
+	if (result != PipeResult::Success) return result;
+
+	epoll_event events[2];
+	i32 count = epoll_wait(pipe.impl->epoll, events, ArrayLength(events), 0);
+	if (count < 0)
+	{
+		switch (errno)
+		{
+			// Try again next update
+			case EINTR:
+				return PipeResult::Success;
+
+			default:
+				LOG_ERRNO(Severity::Warning, "Failed to update pipe connection '%'", pipe.name);
+				return PipeResult::UnexpectedFailure;
+		}
+	}
+
+	pipe.impl->readable = false;
+	pipe.impl->hangup   = false;
+	for (i32 i = 0; i < count; i++)
+	{
+		if (events[i].data.fd != pipe.impl->socket) continue;
+		pipe.impl->readable = events[i].events & EPOLLIN;
+		pipe.impl->hangup   = events[i].events & (EPOLLHUP | EPOLLRDHUP | EPOLLERR);
+	}
+
+	// NOTE: The shared memory transport only reads from the socket to receive the mapping
+	if (pipe.transport == PipeTransport::SharedMemory)
+	{
+		if (!pipe.impl->shared && !pipe.isServer && pipe.impl->readable)
+		{
+			result = SharedPipe_Receive(pipe);
+			if (result == PipeResult::UnexpectedFailure) return result;
+		}
+		pipe.impl->readable = false;
+	}
+
+	// NOTE: Messages sent before the peer closed are drained first. End of stream also reports as
+	// readable so peek to see if there's actually a message left.
+	if (pipe.impl->hangup && pipe.impl->readable)
+	{
+		ssize_t available = recv(pipe.impl->socket, nullptr, 0, MSG_PEEK | MSG_TRUNC | MSG_DONTWAIT);
+		pipe.impl->readable = available > 0;
+	}
+
+	// Pipe has been closed
+	if (pipe.impl->hangup && !pipe.impl->readable)
+	{
+		result = Platform_DisconnectPipe(pipe);
+		return result;
+	}
+
+	return PipeResult::Success;
+}
+
+static PipeResult
+Platform_CreatePipe(StringView name, Pipe& pipe, PipeTransport transport, b8 isServer)
+{
+	// Initialize
+	{
+		pipe = {};
+		pipe.name      = String_FromView(name);
+		pipe.state     = PipeState::Disconnected;
+		pipe.isServer  = isServer;
+		pipe.transport = transport;
+	}
+
+	// Allocate platform data
+	{
+		pipe.impl = (PipeImpl*) AllocChecked(sizeof(PipeImpl));
+		*pipe.impl = {};
+
+		pipe.impl->fullName = String_Format("LCDHardwareMonitor/%", pipe.name);
+		pipe.impl->listener = -1;
+		pipe.impl->socket   = -1;
+	}
+
+	// Create readiness set
+	{
+		pipe.impl->epoll = epoll_create1(EPOLL_CLOEXEC);
+		LOG_ERRNO_IF(!IsValidFd(pipe.impl->epoll), return PipeResult::UnexpectedFailure,
+			Severity::Warning, "Failed to create pipe epoll set '%'", pipe.name);
+	}
+
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_CreatePipeServer(StringView name, Pipe& pipe, PipeTransport transport)
+{
+	auto cleanupGuard = guard { Platform_DestroyPipe(pipe); };
+
+	PipeResult result = Platform_CreatePipe(name, pipe, transport, true);
+	if (result != PipeResult::Success) return result;
+
+	// TODO: Would like to automatically kick off a connection here, but that makes it harder for the
+	// caller to handle connect/disconnect events.
+	cleanupGuard.dismiss = true;
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_CreatePipeClient(StringView name, Pipe& pipe, PipeTransport transport)
+{
+	auto cleanupGuard = guard { Platform_DestroyPipe(pipe); };
+
+	PipeResult result = Platform_CreatePipe(name, pipe, transport, false);
+	if (result != PipeResult::Success) return result;
+
+	// Attempt to connect
+	{
+		cleanupGuard.dismiss = true;
+
+		result = Platform_ConnectPipe(pipe);
+		if (result != PipeResult::Success) return result;
+	}
+
+	return PipeResult::Success;
+}
+
+void
+Platform_DestroyPipe(Pipe& pipe)
+{
+	if (pipe.impl)
+	{
+		SharedPipe_Unmap(pipe);
+		Pipe_Close(pipe.impl->socket);
+		Pipe_Close(pipe.impl->listener);
+		Pipe_Close(pipe.impl->epoll);
+		String_Free(pipe.impl->fullName);
+		Free(pipe.impl);
+	}
+
+	String_Free(pipe.name);
+	pipe = {};
+}
+
+PipeResult
+Platform_WritePipe(Pipe& pipe, ByteSlice bytes)
+{
+	// NOTE: Writes never block. When the socket buffer is full the write fails transiently and the
+	// caller keeps the message queued until the next update.
+
+	if (pipe.transport == PipeTransport::SharedMemory)
+		return SharedPipe_Write(pipe, bytes);
+
+	Assert(!Slice_IsSparse(bytes));
+	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
+
+	ssize_t written = send(pipe.impl->socket, bytes.data, bytes.length, MSG_DONTWAIT | MSG_NOSIGNAL);
+	if (written < 0)
+	{
+		switch (errno)
+		{
+			// Socket buffer is full
+			case EAGAIN:
+				return PipeResult::TransientFailure;
+
+			// The pipe is being closed
+			case EPIPE:
+			case ECONNRESET:
+				// TODO: Would like to set Disconnecting state here, but that makes it harder for the
+				// caller to handle connect/disconnect events.
+				return PipeResult::TransientFailure;
+
+			default:
+				LOG_ERRNO(Severity::Warning, "Writing to pipe failed '%'", pipe.name);
+				return PipeResult::UnexpectedFailure;
+		}
+	}
+
+	// NOTE: Seqpacket sends are atomic so this shouldn't happen. See the Win32 version for why it's
+	// recoverable anyway.
+	LOG_IF((u32) written != bytes.length, return PipeResult::TransientFailure,
+		Severity::Fatal, "Writing to pipe truncated '%'", pipe.name);
+
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_ReadPipe(Pipe& pipe, Bytes& bytes)
+{
+	if (pipe.transport == PipeTransport::SharedMemory)
+		return SharedPipe_Read(pipe, bytes);
+
+	bytes.length = 0;
+
+	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
+	if (!pipe.impl->readable) return PipeResult::Success;
+
+	// NOTE: MSG_TRUNC makes a peek return the full size of the next message
+	ssize_t available = recv(pipe.impl->socket, nullptr, 0, MSG_PEEK | MSG_TRUNC | MSG_DONTWAIT);
+	if (available <= 0)
+	{
+		// Drained until the next update
+		if (available == 0 || errno == EAGAIN)
+		{
+			pipe.impl->readable = false;
+			return PipeResult::Success;
+		}
+
+		switch (errno)
+		{
+			// Pipe has been closed
+			case ECONNRESET:
+			case ENOTCONN:
+				// TODO: Would like to set Disconnecting state here, but that makes it harder for the
+				// caller to handle connect/disconnect events.
+				return PipeResult::TransientFailure;
+
+			default:
+				LOG_ERRNO(Severity::Warning, "Failed to peek pipe '%'", pipe.name);
+				return PipeResult::UnexpectedFailure;
+		}
+	}
+
+	List_Reserve(bytes, (u32) available);
+
+	ssize_t read = recv(pipe.impl->socket, bytes.data, (size_t) available, MSG_DONTWAIT);
+	LOG_ERRNO_IF(read < 0, return PipeResult::UnexpectedFailure,
+		Severity::Warning, "Reading from pipe failed '%'", pipe.name);
+
+	// TODO: Could potentially drop the connection instead of fataling. Or implement an ack for each
+	// message
+	LOG_IF(read != available, return PipeResult::UnexpectedFailure,
+		Severity::Fatal, "Read wrong amount of data from pipe '%'", pipe.name);
+
+	bytes.length = (u32) read;
+	return PipeResult::Success;
+}
+
+PipeResult
+Platform_FlushPipe(Pipe& pipe)
+{
+	// NOTE: Sent messages are already in the peer's receive queue and shared memory writes are
+	// visible as soon as they complete
+	if (!IsValidFd(pipe.impl->socket)) return PipeResult::TransientFailure;
+	return PipeResult::Success;
+}
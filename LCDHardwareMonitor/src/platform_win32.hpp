@@ -9,6 +9,533 @@
 #pragma pop_macro("IGNORE")
 #pragma warning(pop)
 
+// -------------------------------------------------------------------------------------------------
+// Logging
+
+// NOTE: Print and log calls push compact binary records into a lock-free ring and a background
+// thread formats and writes them. Only the raw arguments are copied on the calling thread. Formats
+// and locations are stored by pointer so they must be string literals (which LOG enforces).
+// Argument types without a compact encoding are converted with ToString on the calling thread.
+// Until Platform_InitializeLog is called records are formatted and written synchronously.
+
+enum struct LogRecordKind : u8
+{
+	Null,
+	Print,
+	Log,
+	Bytes,
+};
+
+enum struct LogArgType : u8
+{
+	Null,
+	U64,
+	I64,
+	R64,
+	C8,
+	B8,
+	String,
+};
+
+const u32 LogArgsCapacity = 440;
+const u32 LogSlotCount    = 2048;
+
+struct LogRecord
+{
+	LogRecordKind kind;
+	Severity      severity;
+	b8            truncated;
+	u16           argsSize;
+	Location      location;
+	StringView    format;
+	u8            args[LogArgsCapacity];
+};
+
+struct LogSlot
+{
+	volatile LONG64 sequence;
+	LogRecord       record;
+};
+
+struct LogState
+{
+	LogSlot*        slots;
+	LogOverflow     overflow;
+	volatile LONG64 writePosition;
+	volatile LONG64 readPosition;
+	volatile LONG64 droppedCount;
+	volatile LONG   producers;
+	volatile LONG   flushing;
+	volatile LONG   sleeping;
+	volatile LONG   quit;
+	volatile LONG   running;
+	HANDLE          wakeEvent;
+	HANDLE          idleEvent;
+	HANDLE          flushedEvent;
+	HANDLE          thread;
+};
+static LogState logState = {};
+
+static void
+LogArg_AppendRaw(LogRecord& record, LogArgType type, const void* data, u32 size)
+{
+	if (record.argsSize + 1 + size > LogArgsCapacity)
+	{
+		record.truncated = true;
+		return;
+	}
+
+	record.args[record.argsSize] = (u8) type;
+	memcpy(&record.args[record.argsSize + 1], data, size);
+	record.argsSize += (u16) (1 + size);
+}
+
+static void
+LogArg_AppendString(LogRecord& record, const c8* data, u32 length)
+{
+	u32 available = LogArgsCapacity - record.argsSize;
+	if (available < 1 + sizeof(u16))
+	{
+		record.truncated = true;
+		return;
+	}
+
+	u16 written = (u16) Min(length, available - 1 - (u32) sizeof(u16));
+	record.truncated |= written != length;
+
+	u8* arg = &record.args[record.argsSize];
+	arg[0] = (u8) LogArgType::String;
+	memcpy(&arg[1], &written, sizeof(u16));
+	memcpy(&arg[1 + sizeof(u16)], data, written);
+	record.argsSize += (u16) (1 + sizeof(u16) + written);
+}
+
+// NOTE: Numbers are widened to 64 bits so the log thread only has to handle one size of each
+#define LOG_ARG_APPEND_AS(Type, Stored, ArgType) \
+	inline void \
+	LogArg_Append(LogRecord& record, Type value) \
+	{ \
+		Stored v = value; \
+		LogArg_AppendRaw(record, LogArgType::ArgType, &v, sizeof(v)); \
+	}
+LOG_ARG_APPEND_AS(u8,  u64, U64)
+LOG_ARG_APPEND_AS(u16, u64, U64)
+LOG_ARG_APPEND_AS(u32, u64, U64)
+LOG_ARG_APPEND_AS(u64, u64, U64)
+LOG_ARG_APPEND_AS(i8,  i64, I64)
+LOG_ARG_APPEND_AS(i16, i64, I64)
+LOG_ARG_APPEND_AS(i32, i64, I64)
+LOG_ARG_APPEND_AS(i64, i64, I64)
+LOG_ARG_APPEND_AS(r32, r64, R64)
+LOG_ARG_APPEND_AS(r64, r64, R64)
+LOG_ARG_APPEND_AS(c8,  c8,  C8)
+LOG_ARG_APPEND_AS(b8,  b8,  B8)
+#undef LOG_ARG_APPEND_AS
+
+inline void
+LogArg_Append(LogRecord& record, const c8* value)
+{
+	LogArg_AppendString(record, value, value ? (u32) strlen(value) : 0);
+}
+
+inline void
+LogArg_Append(LogRecord& record, c8* value)
+{
+	LogArg_AppendString(record, value, value ? (u32) strlen(value) : 0);
+}
+
+inline void
+LogArg_Append(LogRecord& record, String value)
+{
+	LogArg_AppendString(record, value.data, value.length);
+}
+
+inline void
+LogArg_Append(LogRecord& record, StringView value)
+{
+	LogArg_AppendString(record, value.data, value.length);
+}
+
+inline void
+LogArg_Append(LogRecord& record, StringSlice value)
+{
+	LogArg_AppendString(record, value.data, value.length);
+}
+
+template<typename T>
+inline void
+LogArg_Append(LogRecord& record, T value)
+{
+	String string = {};
+	defer { String_Free(string); };
+
+	u32 length = ToString(string, value);
+	String_Reserve(string, length + 1);
+	ToString(string, value);
+
+	LogArg_AppendString(record, string.data, string.length);
+}
+
+template<typename T>
+static void
+Log_Append(String& string, T value)
+{
+	String lengthOnly = {};
+	u32 length = ToString(lengthOnly, value);
+	String_Reserve(string, string.length + length + 1);
+	ToString(string, value);
+}
+
+template<typename T>
+static void
+Log_AppendArgAs(String& string, u8* data, u32& cursor)
+{
+	T v;
+	memcpy(&v, data, sizeof(v));
+	Log_Append(string, v);
+	cursor += 1 + sizeof(v);
+}
+
+static void
+Log_AppendArg(String& string, LogRecord& record, u32& cursor)
+{
+	if (cursor >= record.argsSize)
+	{
+		Log_Append(string, StringView("<truncated>"));
+		return;
+	}
+
+	LogArgType type = (LogArgType) record.args[cursor];
+	u8*        data = &record.args[cursor + 1];
+	switch (type)
+	{
+		default:
+		case LogArgType::Null:
+			Assert(false);
+			cursor = record.argsSize;
+			break;
+
+		case LogArgType::U64: Log_AppendArgAs<u64>(string, data, cursor); break;
+		case LogArgType::I64: Log_AppendArgAs<i64>(string, data, cursor); break;
+		case LogArgType::R64: Log_AppendArgAs<r64>(string, data, cursor); break;
+		case LogArgType::C8:  Log_AppendArgAs<c8>(string, data, cursor); break;
+		case LogArgType::B8:  Log_AppendArgAs<b8>(string, data, cursor); break;
+
+		case LogArgType::String:
+		{
+			u16 length;
+			memcpy(&length, data, sizeof(length));
+
+			StringSlice slice = {};
+			slice.length = length;
+			slice.data   = (c8*) &data[sizeof(length)];
+			Log_Append(string, slice);
+
+			cursor += 1 + sizeof(length) + length;
+			break;
+		}
+	}
+}
+
+static void
+Log_AppendFormatted(String& string, LogRecord& record)
+{
+	// NOTE: Mirrors FormatImpl in LHMString.hpp
+	StringView format = record.format;
+	u32 cursor = 0;
+	u32 iFmt   = 0;
+	while (iFmt < format.length)
+	{
+		if (format.data[iFmt] != '%')
+		{
+			u32 len;
+			for (len = 1; iFmt + len < format.length; len++)
+				if (format.data[iFmt + len] == '%') break;
+
+			StringSlice literal = {};
+			literal.length = len;
+			literal.data   = &format.data[iFmt];
+			Log_Append(string, literal);
+			iFmt += len;
+		}
+		else
+		{
+			c8 ahead1 = format.length - iFmt > 1 ? format.data[iFmt + 1] : '\0';
+			c8 ahead2 = format.length - iFmt > 2 ? format.data[iFmt + 2] : '\0';
+
+			if (ahead1 != '!' || ahead2 == '!')
+			{
+				Log_AppendArg(string, record, cursor);
+				iFmt += 1;
+			}
+			else
+			{
+				Log_Append(string, '%');
+				iFmt += 2;
+			}
+		}
+	}
+
+	if (record.truncated)
+		Log_Append(string, StringView(" <truncated>"));
+}
+
+static void
+Log_AppendBytes(String& string, LogRecord& record)
+{
+	// NOTE: Bytes records store the prefix as the format and the raw bytes as a single string arg
+	static const c8 hexDigits[] = "0123456789ABCDEF";
+
+	u16 length = 0;
+	if (record.argsSize) memcpy(&length, &record.args[1], sizeof(length));
+	u8* bytes = &record.args[1 + sizeof(length)];
+
+	String_Reserve(string, string.length + record.format.length + 5 * length + 2);
+	Log_Append(string, record.format);
+	for (u32 i = 0; i < length; i++)
+	{
+		c8 hex[] = " 0x00";
+		hex[3] = hexDigits[bytes[i] >> 4];
+		hex[4] = hexDigits[bytes[i] & 0xF];
+		Log_Append(string, StringView(hex));
+	}
+	Log_Append(string, '\n');
+}
+
+static void
+Log_Write(String& string, LogRecord& record)
+{
+	string.length = 0;
+	if (string.data) string.data[0] = '\0';
+
+	switch (record.kind)
+	{
+		default:
+		case LogRecordKind::Null:
+			Assert(false);
+			return;
+
+		case LogRecordKind::Print:
+			Log_AppendFormatted(string, record);
+			break;
+
+		case LogRecordKind::Log:
+			Log_Append(string, record.location.function);
+			Log_Append(string, StringView(" - "));
+			Log_AppendFormatted(string, record);
+			Log_Append(string, StringView("\n\t"));
+			Log_Append(string, record.location.file);
+			Log_Append(string, '(');
+			Log_Append(string, record.location.line);
+			Log_Append(string, StringView(")\n"));
+			break;
+
+		case LogRecordKind::Bytes:
+			Log_AppendBytes(string, record);
+			break;
+	}
+	if (!string.length) return;
+
+	// NOTE: printf/stdout do not appear in the Visual Studio Output window :(
+	fputs(string.data, stdout);
+	if (IsDebuggerPresent())
+		OutputDebugStringA(string.data);
+}
+
+static b8
+Log_ProcessRecord(LogState& log, String& string)
+{
+	i64      position = log.readPosition;
+	LogSlot& slot     = log.slots[position & (LogSlotCount - 1)];
+	if (slot.sequence != position + 1) return false;
+
+	Log_Write(string, slot.record);
+
+	InterlockedExchange64(&slot.sequence, position + LogSlotCount);
+	InterlockedExchange64(&log.readPosition, position + 1);
+	return true;
+}
+
+static DWORD WINAPI
+Log_ThreadMain(void* parameter)
+{
+	LogState& log = *(LogState*) parameter;
+
+	String string = {};
+	defer { String_Free(string); };
+
+	i64 reportedDrops = 0;
+	for (;;)
+	{
+		b8 processed = false;
+		while (Log_ProcessRecord(log, string))
+			processed = true;
+
+		if (processed && log.flushing)
+			SetEvent(log.flushedEvent);
+
+		i64 drops = log.droppedCount;
+		if (drops != reportedDrops)
+		{
+			LogRecord record = {};
+			record.kind   = LogRecordKind::Print;
+			record.format = "[log] Dropped % records\n";
+			LogArg_Append(record, (u64) (drops - reportedDrops));
+			Log_Write(string, record);
+			reportedDrops = drops;
+		}
+
+		if (processed) continue;
+		if (log.quit) break;
+
+		InterlockedExchange(&log.sleeping, 1);
+		LogSlot& next = log.slots[log.readPosition & (LogSlotCount - 1)];
+		if (next.sequence != log.readPosition + 1)
+			WaitForSingleObject(log.wakeEvent, 100);
+		InterlockedExchange(&log.sleeping, 0);
+	}
+
+	return 0;
+}
+
+static void
+Log_ReleaseProducer(LogState& log)
+{
+	if (InterlockedDecrement(&log.producers) == 0 && !log.running && log.idleEvent)
+		SetEvent(log.idleEvent);
+}
+
+// NOTE: Returns nullptr if the record was dropped. position is -1 when the record should be written
+// synchronously. Otherwise the caller is counted as a producer until Log_Commit so teardown can wait
+// for the record before freeing the ring.
+static LogRecord*
+Log_Acquire(LogRecord& localRecord, i64& position, Severity severity)
+{
+	LogState& log = logState;
+
+	position = -1;
+	InterlockedIncrement(&log.producers);
+	if (!log.running)
+	{
+		Log_ReleaseProducer(log);
+		localRecord.truncated = false;
+		localRecord.argsSize  = 0;
+		return &localRecord;
+	}
+
+	b8 canDrop = log.overflow == LogOverflow::Drop && severity <= Severity::Info;
+
+	i64 pos = log.writePosition;
+	for (;;)
+	{
+		LogSlot& slot     = log.slots[pos & (LogSlotCount - 1)];
+		i64      sequence = slot.sequence;
+		i64      delta    = sequence - pos;
+
+		if (delta == 0)
+		{
+			i64 previous = InterlockedCompareExchange64(&log.writePosition, pos + 1, pos);
+			if (previous == pos)
+			{
+				position = pos;
+				slot.record.truncated = false;
+				slot.record.argsSize  = 0;
+				return &slot.record;
+			}
+			pos = previous;
+		}
+		else if (delta < 0)
+		{
+			// Full
+			if (canDrop)
+			{
+				InterlockedIncrement64(&log.droppedCount);
+				Log_ReleaseProducer(log);
+				return nullptr;
+			}
+
+			SetEvent(log.wakeEvent);
+			YieldProcessor();
+			pos = log.writePosition;
+		}
+		else
+		{
+			pos = log.writePosition;
+		}
+	}
+}
+
+static void
+Log_Commit(LogRecord& record, i64 position)
+{
+	LogState& log = logState;
+
+	if (position == -1)
+	{
+		String string = {};
+		defer { String_Free(string); };
+		Log_Write(string, record);
+	}
+	else
+	{
+		LogSlot& slot = log.slots[position & (LogSlotCount - 1)];
+		InterlockedExchange64(&slot.sequence, position + 1);
+		if (log.sleeping)
+			SetEvent(log.wakeEvent);
+		Log_ReleaseProducer(log);
+	}
+
+	if (record.kind == LogRecordKind::Log && record.severity > Severity::Info && IsDebuggerPresent())
+	{
+		Platform_FlushLog();
+		__debugbreak();
+	}
+}
+
+template<typename... Args>
+inline void
+Log_Push(LogRecordKind kind, Severity severity, Location location, StringView format, Args... args)
+{
+	i64        position;
+	LogRecord  localRecord;
+	LogRecord* record = Log_Acquire(localRecord, position, severity);
+	if (!record) return;
+
+	record->kind     = kind;
+	record->severity = severity;
+	record->location = location;
+	record->format   = format;
+	(LogArg_Append(*record, args), ...);
+
+	Log_Commit(*record, position);
+}
+
+void
+Platform_PrintBytes(StringView prefix, ByteSlice bytes)
+{
+	// NOTE: Large payloads are split across multiple records, one line each
+	u32 chunkSize = LogArgsCapacity - 1 - (u32) sizeof(u16);
+
+	u8 chunk[LogArgsCapacity];
+	for (u32 first = 0; first < bytes.length; first += chunkSize)
+	{
+		u32 count = Min(chunkSize, bytes.length - first);
+		for (u32 i = 0; i < count; i++)
+			chunk[i] = bytes[first + i];
+
+		i64        position;
+		LogRecord  localRecord;
+		LogRecord* record = Log_Acquire(localRecord, position, Severity::Info);
+		if (!record) return;
+
+		record->kind   = LogRecordKind::Bytes;
+		record->format = prefix;
+		LogArg_AppendString(*record, (c8*) chunk, count);
+
+		Log_Commit(*record, position);
+	}
+}
+
 template<u32 PlaceholderCount, typename... Args>
 inline void
 Platform_PrintChecked(StringView format, Args... args)
@@ -20,20 +547,14 @@ Platform_PrintChecked(StringView format, Args... args)
 void
 Platform_PrintImpl(StringView message)
 {
-	// NOTE: printf/stdout do not appear in the Visual Studio Output window :(
-	printf(message.data);
-	if (IsDebuggerPresent())
-		OutputDebugStringA(message.data);
+	Log_Push(LogRecordKind::Print, Severity::Info, {}, "%", message);
 }
 
 template<typename... Args>
 inline void
 Platform_PrintImpl(StringView format, Args... args)
 {
-	String message = String_FormatImpl(format, args...);
-	defer { String_Free(message); };
-
-	Platform_PrintImpl(message);
+	Log_Push(LogRecordKind::Print, Severity::Info, {}, format, args...);
 }
 
 template<u32 PlaceholderCount, typename... Args>
@@ -48,23 +569,15 @@ void
 Platform_LogImpl(Severity severity, Location location, StringView message)
 {
 	Assert(severity != Severity::Null);
-
-	String fullMessage = String_FormatImpl("% - %\n\t%(%)\n", location.function, message, location.file, location.line);
-	defer { String_Free(fullMessage); };
-
-	Platform_PrintImpl(fullMessage);
-	if (severity > Severity::Info && IsDebuggerPresent())
-		__debugbreak();
+	Log_Push(LogRecordKind::Log, severity, location, "%", message);
 }
 
 template<typename... Args>
 inline void
 Platform_LogImpl(Severity severity, Location location, StringView format, Args... args)
 {
-	String message = String_FormatImpl(format, args...);
-	defer { String_Free(message); };
-
-	Platform_LogImpl(severity, location, message);
+	Assert(severity != Severity::Null);
+	Log_Push(LogRecordKind::Log, severity, location, format, args...);
 }
 
 void
@@ -149,6 +662,85 @@ LogLastError(Severity severity, Location location, StringView format, Args... ar
 #define LOG_LAST_ERROR(severity, format, ...) LogLastError(severity, LOCATION, format, ##__VA_ARGS__)
 #define LOG_LAST_ERROR_IF(expression, action, severity, format, ...) IF(expression, LOG_LAST_ERROR(severity, format, ##__VA_ARGS__); action)
 
+b8
+Platform_InitializeLog(LogOverflow overflow)
+{
+	LogState& log = logState;
+	Assert(!log.running);
+
+	log.overflow = overflow;
+	log.slots    = (LogSlot*) AllocChecked(sizeof(LogSlot) * LogSlotCount);
+	for (u32 i = 0; i < LogSlotCount; i++)
+		log.slots[i].sequence = i;
+
+	log.wakeEvent    = CreateEventA(nullptr, false, false, nullptr);
+	log.idleEvent    = CreateEventA(nullptr, false, false, nullptr);
+	log.flushedEvent = CreateEventA(nullptr, false, false, nullptr);
+	b8 created = log.wakeEvent && log.idleEvent && log.flushedEvent;
+	LOG_LAST_ERROR_IF(!created, Platform_TeardownLog(); return false,
+		Severity::Error, "Failed to create log events");
+
+	log.thread = CreateThread(nullptr, 0, Log_ThreadMain, &log, 0, nullptr);
+	LOG_LAST_ERROR_IF(!log.thread, Platform_TeardownLog(); return false,
+		Severity::Error, "Failed to create log thread");
+
+	log.running = true;
+	return true;
+}
+
+void
+Platform_TeardownLog()
+{
+	LogState& log = logState;
+
+	// NOTE: New records are written synchronously from here on. Records already acquired still point
+	// into the ring, so wait for them to be committed, then let the thread write them out.
+	InterlockedExchange(&log.running, false);
+	if (log.idleEvent)
+	{
+		while (log.producers)
+			WaitForSingleObject(log.idleEvent, INFINITE);
+	}
+
+	if (log.thread)
+	{
+		InterlockedExchange(&log.quit, true);
+		SetEvent(log.wakeEvent);
+		WaitForSingleObject(log.thread, INFINITE);
+		CloseHandle(log.thread);
+	}
+	if (log.wakeEvent)    CloseHandle(log.wakeEvent);
+	if (log.idleEvent)    CloseHandle(log.idleEvent);
+	if (log.flushedEvent) CloseHandle(log.flushedEvent);
+
+	Free(log.slots);
+	log = {};
+}
+
+void
+Platform_FlushLog()
+{
+	LogState& log = logState;
+	if (!log.running) return;
+
+	// NOTE: The log thread signals after every batch while someone is flushing. The timeout covers a
+	// second flusher that lost the signal to the first.
+	i64 target = log.writePosition;
+	InterlockedIncrement(&log.flushing);
+	while (log.readPosition < target)
+	{
+		SetEvent(log.wakeEvent);
+		WaitForSingleObject(log.flushedEvent, 100);
+	}
+	InterlockedDecrement(&log.flushing);
+}
+
+u64
+Platform_GetDroppedLogCount()
+{
+	return (u64) logState.droppedCount;
+}
+
 // TODO: RAII wrapper
 static String
 GetWorkingDirectory()
@@ -221,146 +813,1048 @@ LoadFile(StringView path, u32 padding = 0)
 		return cwd;
 	};
 
-	{
-		HANDLE file = CreateFileA(
-			path.data,
-			GENERIC_READ,
-			FILE_SHARE_READ,
-			nullptr,
-			OPEN_EXISTING,
-			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
-			nullptr
-		);
-		defer { CloseHandle(file); };
-		LOG_LAST_ERROR_IF(file == INVALID_HANDLE_VALUE, return result,
-			Severity::Warning, "Failed to create file handle '%'; CWD: '%'", path, getCWD());
+	{
+		HANDLE file = CreateFileA(
+			path.data,
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			nullptr
+		);
+		defer { CloseHandle(file); };
+		LOG_LAST_ERROR_IF(file == INVALID_HANDLE_VALUE, return result,
+			Severity::Warning, "Failed to create file handle '%'; CWD: '%'", path, getCWD());
+
+		LARGE_INTEGER size_win32;
+		b8 success = GetFileSizeEx(file, &size_win32);
+		LOG_LAST_ERROR_IF(!success, return result,
+			Severity::Warning, "Failed to get file size '%'", path);
+		LOG_IF(size_win32.QuadPart > u32Max - padding, return result,
+			Severity::Warning, "File is too large to load '%'", path);
+
+		u32 size = (u32) size_win32.QuadPart;
+		List_Reserve(result, size + padding);
+
+		success = ReadFile(file, result.data, size, (DWORD*) &result.length, nullptr);
+		LOG_LAST_ERROR_IF(!success, return result,
+			Severity::Warning, "Failed to read file '%'", path);
+	}
+
+	resultGuard.dismiss = true;
+	return result;
+}
+
+Bytes
+Platform_LoadFileBytes(StringView path)
+{
+	return LoadFile(path, 0);
+}
+
+String
+Platform_LoadFileString(StringView path)
+{
+	String result = {};
+
+	Bytes bytes = LoadFile(path, 1);
+	if (!bytes.data) return result;
+
+	result.length   = bytes.length;
+	result.capacity = bytes.capacity;
+	result.data     = (c8*) bytes.data;
+
+	result[result.length++] = '\0';
+
+	return result;
+}
+
+// NOTE: The view keeps the file and the mapping alive so both handles are closed right away. Pages
+// come straight from the file cache, so mapping the same file again (or in another process) costs no
+// copy. Sequential access prefetches the whole view since asset consumers read all of it. A file
+// that isn't required can be missing without a warning.
+ByteSlice
+Platform_MapFile(StringView path, FileAccess access, b8 required)
+{
+	ByteSlice result = {};
+
+	HANDLE file = CreateFileA(
+		path.data,
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | (access == FileAccess::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN),
+		nullptr
+	);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		DWORD error = GetLastError();
+		b8 missing = error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND;
+		if (missing && !required) return result;
+
+		String cwd = GetWorkingDirectory();
+		defer { String_Free(cwd); };
+		LOG_LAST_ERROR(Severity::Warning, "Failed to create file handle '%'; CWD: '%'", path, cwd);
+		return result;
+	}
+	defer { CloseHandle(file); };
+
+	LARGE_INTEGER size_win32;
+	b8 success = GetFileSizeEx(file, &size_win32);
+	LOG_LAST_ERROR_IF(!success, return result,
+		Severity::Warning, "Failed to get file size '%'", path);
+	LOG_IF(size_win32.QuadPart > u32Max, return result,
+		Severity::Warning, "File is too large to map '%'", path);
+	// NOTE: Empty files can't be mapped
+	LOG_IF(size_win32.QuadPart == 0, return result,
+		Severity::Warning, "File is empty '%'", path);
+
+	HANDLE fileMap = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	LOG_LAST_ERROR_IF(!fileMap, return result,
+		Severity::Warning, "Failed to create file mapping '%'", path);
+	defer { CloseHandle(fileMap); };
+
+	u8* data = (u8*) MapViewOfFile(fileMap, FILE_MAP_READ, 0, 0, 0);
+	LOG_LAST_ERROR_IF(!data, return result,
+		Severity::Warning, "Failed to map view of file '%'", path);
+
+	result.data   = data;
+	result.length = (u32) size_win32.QuadPart;
+
+	if (access == FileAccess::Sequential)
+	{
+		WIN32_MEMORY_RANGE_ENTRY range = {};
+		range.VirtualAddress = result.data;
+		range.NumberOfBytes  = result.length;
+
+		success = PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		LOG_LAST_ERROR_IF(!success, IGNORE,
+			Severity::Info, "Failed to prefetch mapped file '%'", path);
+	}
+
+	return result;
+}
+
+void
+Platform_UnmapFile(ByteSlice& bytes)
+{
+	if (!bytes.data) return;
+
+	b8 success = UnmapViewOfFile(bytes.data);
+	LOG_LAST_ERROR_IF(!success, IGNORE,
+		Severity::Warning, "Failed to unmap view of file");
+
+	bytes = {};
+}
+
+i64
+Platform_GetTicks()
+{
+	// NOTE: Never fails above XP
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	return (i64) counter.QuadPart;
+}
+
+r32
+Platform_TicksToSeconds(i64 ticks)
+{
+	// NOTE: Never fails above XP
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return (r32) ticks / (r32) frequency.QuadPart;
+}
+
+i64
+Platform_SecondsToTicks(r32 seconds)
+{
+	// NOTE: Never fails above XP
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return (i64) (seconds * (r32) frequency.QuadPart);
+}
+
+r32
+Platform_GetElapsedSeconds(i64 startTicks)
+{
+	i64 elapsedTicks = Platform_GetTicks() - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks);
+}
+
+r32
+Platform_GetElapsedSeconds(i64 startTicks, i64 endTicks)
+{
+	i64 elapsedTicks = endTicks - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks);
+}
+
+r32
+Platform_GetElapsedMilliseconds(i64 startTicks)
+{
+	i64 elapsedTicks = Platform_GetTicks() - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks) * 1000.0f;
+}
+
+r32
+Platform_GetElapsedMilliseconds(i64 startTicks, i64 endTicks)
+{
+	i64 elapsedTicks = endTicks - startTicks;
+	return Platform_TicksToSeconds(elapsedTicks) * 1000.0f;
+}
+
+void
+Platform_Sleep(u32 ms)
+{
+	Sleep(ms);
+}
+
+void
+Platform_RequestQuit()
+{
+	PostQuitMessage(0);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Directory Watches
+
+// NOTE: A single overlapped ReadDirectoryChangesW is kept in flight per watch. Reading a watch checks
+// whether it completed without waiting, collects the changed file names, and issues the next read.
+// Changes that happen between completion and the next read are buffered by the system.
+
+struct DirectoryWatchImpl
+{
+	HANDLE     directory;
+	OVERLAPPED overlapped;
+	// NOTE: FILE_NOTIFY_INFORMATION must be DWORD aligned
+	DWORD      buffer[4096];
+};
+
+static b8
+DirectoryWatch_Issue(DirectoryWatch& watch)
+{
+	DirectoryWatchImpl& impl = *watch.impl;
+
+	b8 success = ReadDirectoryChangesW(
+		impl.directory,
+		impl.buffer,
+		sizeof(impl.buffer),
+		false,
+		FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE,
+		nullptr,
+		&impl.overlapped,
+		nullptr
+	);
+	LOG_LAST_ERROR_IF(!success, return false,
+		Severity::Warning, "Failed to read directory changes '%'", watch.path);
+
+	return true;
+}
+
+static void
+DirectoryWatch_AddChange(List<String>& changedFiles, StringView fileName)
+{
+	for (u32 i = 0; i < changedFiles.length; i++)
+		if (String_Equal(changedFiles[i], fileName))
+			return;
+
+	List_Append(changedFiles, String_FromView(fileName));
+}
+
+b8
+Platform_CreateDirectoryWatch(StringView path, DirectoryWatch& watch)
+{
+	auto cleanupGuard = guard { Platform_DestroyDirectoryWatch(watch); };
+
+	watch = {};
+	watch.path = String_FromView(path);
+	watch.impl = (DirectoryWatchImpl*) AllocChecked(sizeof(DirectoryWatchImpl));
+	*watch.impl = {};
+	watch.impl->directory = INVALID_HANDLE_VALUE;
+
+	watch.impl->directory = CreateFileA(
+		path.data,
+		FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+		nullptr
+	);
+	LOG_LAST_ERROR_IF(watch.impl->directory == INVALID_HANDLE_VALUE, return false,
+		Severity::Warning, "Failed to open watched directory '%'", path);
+
+	watch.impl->overlapped.hEvent = CreateEventA(nullptr, true, false, nullptr);
+	LOG_LAST_ERROR_IF(!watch.impl->overlapped.hEvent, return false,
+		Severity::Warning, "Failed to create directory watch event '%'", path);
+
+	b8 success = DirectoryWatch_Issue(watch);
+	if (!success) return false;
+
+	cleanupGuard.dismiss = true;
+	return true;
+}
+
+void
+Platform_DestroyDirectoryWatch(DirectoryWatch& watch)
+{
+	if (watch.impl)
+	{
+		DirectoryWatchImpl& impl = *watch.impl;
+		if (impl.directory != INVALID_HANDLE_VALUE)
+		{
+			// NOTE: Wait for the cancellation so the system is done writing into the buffer
+			DWORD bytesRead;
+			CancelIoEx(impl.directory, &impl.overlapped);
+			GetOverlappedResult(impl.directory, &impl.overlapped, &bytesRead, true);
+			CloseHandle(impl.directory);
+		}
+		if (impl.overlapped.hEvent)
+			CloseHandle(impl.overlapped.hEvent);
+		Free(watch.impl);
+	}
+
+	String_Free(watch.path);
+	watch = {};
+}
+
+b8
+Platform_ReadDirectoryWatch(DirectoryWatch& watch, List<String>& changedFiles)
+{
+	DirectoryWatchImpl& impl = *watch.impl;
+
+	DWORD bytesRead;
+	b8 success = GetOverlappedResult(impl.directory, &impl.overlapped, &bytesRead, false);
+	if (!success)
+	{
+		if (GetLastError() == ERROR_IO_INCOMPLETE) return true;
+		LOG_LAST_ERROR(Severity::Warning, "Failed to get directory changes '%'", watch.path);
+		return false;
+	}
+
+	// NOTE: Zero bytes means the system buffer overflowed and the changes were discarded
+	LOG_IF(bytesRead == 0, IGNORE,
+		Severity::Warning, "Directory watch overflowed, changes were lost '%'", watch.path);
+
+	u8* cursor = (u8*) impl.buffer;
+	while (bytesRead != 0)
+	{
+		FILE_NOTIFY_INFORMATION& info = *(FILE_NOTIFY_INFORMATION*) cursor;
+
+		b8 isWrite = false;
+		isWrite |= info.Action == FILE_ACTION_ADDED;
+		isWrite |= info.Action == FILE_ACTION_MODIFIED;
+		isWrite |= info.Action == FILE_ACTION_RENAMED_NEW_NAME;
+		if (isWrite)
+		{
+			i32 wideLength = (i32) (info.FileNameLength / sizeof(WCHAR));
+
+			c8 fileName[MAX_PATH];
+			i32 length = WideCharToMultiByte(CP_UTF8, 0, info.FileName, wideLength, fileName, sizeof(fileName) - 1, nullptr, nullptr);
+			if (length > 0)
+			{
+				fileName[length] = '\0';
+
+				StringView view = {};
+				view.data   = fileName;
+				view.length = (u32) length;
+				DirectoryWatch_AddChange(changedFiles, view);
+			}
+		}
+
+		if (info.NextEntryOffset == 0) break;
+		cursor += info.NextEntryOffset;
+	}
+
+	return DirectoryWatch_Issue(watch);
+}
+
+struct SharedPipeHeader;
+struct PipeImpl
+{
+	String     fullName;
+	HANDLE     handle;
+	OVERLAPPED connect;
+
+	// Shared memory transport
+	SharedPipeHeader* shared;
+	HANDLE            peerProcess;
+	LONG              generation;
+};
+
+inline b8
+IsValidHandle(HANDLE handle)
+{
+	// NOTE: Some Win32 functions return nullptr and some return INVALID_HANDLE_VALUE on failure.
+	// Things would be fine if that were the end of it. But some functions take 'pseudohandles' and
+	// INVALID_HANDLE_VALUE can be a valid pseudohandle. Fuck you, Microsoft.
+	return handle != nullptr && handle != INVALID_HANDLE_VALUE;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Shared Memory
+
+// NOTE: Page file backed mappings in the session namespace. The mapping lives until every process
+// has closed it, so unlike Linux there's nothing for the owner to clean up.
+
+static b8
+SharedMemory_Map(SharedMemory& memory)
+{
+	memory.data = MapViewOfFile(memory.handle, FILE_MAP_ALL_ACCESS, 0, 0, memory.size);
+	LOG_LAST_ERROR_IF(!memory.data, return false,
+		Severity::Warning, "Failed to map shared memory '%'", memory.name);
+
+	return true;
+}
+
+b8
+Platform_CreateSharedMemory(StringView name, u32 size, SharedMemory& memory)
+{
+	auto cleanupGuard = guard { Platform_DestroySharedMemory(memory); };
+
+	memory = {};
+	memory.name    = String_FromView(name);
+	memory.size    = size;
+	memory.isOwner = true;
+
+	String fullName = String_Format("Local\\%", name);
+	defer { String_Free(fullName); };
+
+	memory.handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, size, fullName.data);
+	LOG_LAST_ERROR_IF(!IsValidHandle(memory.handle), return false,
+		Severity::Warning, "Failed to create shared memory '%'", name);
+	LOG_IF(GetLastError() == ERROR_ALREADY_EXISTS, return false,
+		Severity::Warning, "Shared memory already exists '%'", name);
+
+	b8 success = SharedMemory_Map(memory);
+	if (!success) return false;
+
+	cleanupGuard.dismiss = true;
+	return true;
+}
+
+b8
+Platform_OpenSharedMemory(StringView name, u32 size, SharedMemory& memory)
+{
+	auto cleanupGuard = guard { Platform_DestroySharedMemory(memory); };
+
+	memory = {};
+	memory.name = String_FromView(name);
+	memory.size = size;
+
+	String fullName = String_Format("Local\\%", name);
+	defer { String_Free(fullName); };
+
+	memory.handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, false, fullName.data);
+	LOG_LAST_ERROR_IF(!IsValidHandle(memory.handle), return false,
+		Severity::Warning, "Failed to open shared memory '%'", name);
+
+	b8 success = SharedMemory_Map(memory);
+	if (!success) return false;
+
+	cleanupGuard.dismiss = true;
+	return true;
+}
+
+void
+Platform_DestroySharedMemory(SharedMemory& memory)
+{
+	if (memory.data)
+	{
+		b8 success = UnmapViewOfFile(memory.data);
+		LOG_LAST_ERROR_IF(!success, IGNORE,
+			Severity::Warning, "Failed to unmap shared memory '%'", memory.name);
+	}
+
+	if (IsValidHandle(memory.handle))
+		CloseHandle(memory.handle);
+
+	String_Free(memory.name);
+	memory = {};
+}
+
+// -------------------------------------------------------------------------------------------------
+// Processes
+
+b8
+Platform_LaunchProcess(StringView path, Slice<StringView> args, Process& process)
+{
+	process = {};
+
+	// NOTE: Arguments are quoted so paths with spaces survive. Quotes inside arguments aren't handled.
+	String commandLine = String_Format("\"%\"", path);
+	defer { String_Free(commandLine); };
+	for (u32 i = 0; i < args.length; i++)
+	{
+		String previous = commandLine;
+		commandLine = String_Format("% \"%\"", previous, args[i]);
+		String_Free(previous);
+	}
+
+	STARTUPINFOA startupInfo = {};
+	startupInfo.cb = sizeof(startupInfo);
+
+	PROCESS_INFORMATION processInfo = {};
+	b8 success = CreateProcessA(
+		path.data,
+		commandLine.data,
+		nullptr,
+		nullptr,
+		false,
+		CREATE_NO_WINDOW,
+		nullptr,
+		nullptr,
+		&startupInfo,
+		&processInfo
+	);
+	LOG_LAST_ERROR_IF(!success, return false,
+		Severity::Warning, "Failed to launch process '%'", path);
+
+	CloseHandle(processInfo.hThread);
+	process.id     = processInfo.dwProcessId;
+	process.handle = processInfo.hProcess;
+	return true;
+}
+
+b8
+Platform_IsProcessRunning(Process& process)
+{
+	if (!IsValidHandle(process.handle)) return false;
+	return WaitForSingleObject(process.handle, 0) == WAIT_TIMEOUT;
+}
+
+void
+Platform_TerminateProcess(Process& process)
+{
+	if (!Platform_IsProcessRunning(process)) return;
+
+	b8 success = TerminateProcess(process.handle, 1);
+	LOG_LAST_ERROR_IF(!success, return,
+		Severity::Warning, "Failed to terminate process %", process.id);
+
+	// NOTE: Termination is asynchronous. Wait so the process is really gone when this returns.
+	WaitForSingleObject(process.handle, INFINITE);
+}
+
+void
+Platform_DestroyProcess(Process& process)
+{
+	if (IsValidHandle(process.handle))
+		CloseHandle(process.handle);
+	process = {};
+}
+
+// -------------------------------------------------------------------------------------------------
+// Work Queues
+
+// NOTE: A fixed set of worker threads pulling from a FIFO. Finished items are posted to a second list
+// so the thread that pushed the work can collect them one at a time. Both lists share a single lock.
+// Work items are coarse (file reads, library loads) so contention doesn't matter.
+
+struct WorkItem
+{
+	WorkFn* function;
+	void*   data;
+};
+
+struct WorkQueueImpl
+{
+	SRWLOCK            lock;
+	CONDITION_VARIABLE workPushed;
+	CONDITION_VARIABLE workFinished;
+	List<WorkItem>     pending;
+	u32                pendingHead;
+	List<void*>        finished;
+	u32                outstanding;
+	b8                 quit;
+	List<HANDLE>       threads;
+};
+
+static DWORD WINAPI
+WorkQueue_ThreadMain(void* parameter)
+{
+	WorkQueueImpl& impl = *(WorkQueueImpl*) parameter;
+
+	AcquireSRWLockExclusive(&impl.lock);
+	for (;;)
+	{
+		while (!impl.quit && impl.pendingHead == impl.pending.length)
+			SleepConditionVariableSRW(&impl.workPushed, &impl.lock, INFINITE, 0);
+		if (impl.quit) break;
+
+		WorkItem item = impl.pending[impl.pendingHead++];
+		if (impl.pendingHead == impl.pending.length)
+		{
+			List_Clear(impl.pending);
+			impl.pendingHead = 0;
+		}
+
+		ReleaseSRWLockExclusive(&impl.lock);
+		item.function(item.data);
+		AcquireSRWLockExclusive(&impl.lock);
+
+		List_Append(impl.finished, item.data);
+		WakeConditionVariable(&impl.workFinished);
+	}
+	ReleaseSRWLockExclusive(&impl.lock);
+
+	return 0;
+}
+
+u32
+Platform_GetProcessorCount()
+{
+	SYSTEM_INFO systemInfo = {};
+	GetSystemInfo(&systemInfo);
+	return Max((u32) systemInfo.dwNumberOfProcessors, 1u);
+}
+
+b8
+Platform_CreateWorkQueue(u32 threadCount, WorkQueue& queue)
+{
+	Assert(threadCount > 0);
+
+	queue = {};
+	queue.impl = (WorkQueueImpl*) AllocChecked(sizeof(WorkQueueImpl));
+	*queue.impl = {};
+	auto queueGuard = guard { Platform_DestroyWorkQueue(queue); };
 
-		LARGE_INTEGER size_win32;
-		b8 success = GetFileSizeEx(file, &size_win32);
-		LOG_LAST_ERROR_IF(!success, return result,
-			Severity::Warning, "Failed to get file size '%'", path);
-		LOG_IF(size_win32.QuadPart > u32Max - padding, return result,
-			Severity::Warning, "File is too large to load '%'", path);
+	WorkQueueImpl& impl = *queue.impl;
+	InitializeSRWLock(&impl.lock);
+	InitializeConditionVariable(&impl.workPushed);
+	InitializeConditionVariable(&impl.workFinished);
 
-		u32 size = (u32) size_win32.QuadPart;
-		List_Reserve(result, size + padding);
+	List_Reserve(impl.threads, threadCount);
+	for (u32 i = 0; i < threadCount; i++)
+	{
+		HANDLE thread = CreateThread(nullptr, 0, WorkQueue_ThreadMain, &impl, 0, nullptr);
+		LOG_LAST_ERROR_IF(!thread, return false,
+			Severity::Error, "Failed to create work queue thread");
 
-		success = ReadFile(file, result.data, size, (DWORD*) &result.length, nullptr);
-		LOG_LAST_ERROR_IF(!success, return result,
-			Severity::Warning, "Failed to read file '%'", path);
+		List_Append(impl.threads, thread);
 	}
 
-	resultGuard.dismiss = true;
-	return result;
+	queue.threadCount = threadCount;
+	queueGuard.dismiss = true;
+	return true;
 }
 
-Bytes
-Platform_LoadFileBytes(StringView path)
+void
+Platform_DestroyWorkQueue(WorkQueue& queue)
 {
-	return LoadFile(path, 0);
+	if (!queue.impl) return;
+
+	WorkQueueImpl& impl = *queue.impl;
+	Assert(impl.outstanding == 0);
+
+	AcquireSRWLockExclusive(&impl.lock);
+	impl.quit = true;
+	ReleaseSRWLockExclusive(&impl.lock);
+	WakeAllConditionVariable(&impl.workPushed);
+
+	for (u32 i = 0; i < impl.threads.length; i++)
+	{
+		WaitForSingleObject(impl.threads[i], INFINITE);
+		CloseHandle(impl.threads[i]);
+	}
+
+	List_Free(impl.threads);
+	List_Free(impl.pending);
+	List_Free(impl.finished);
+	Free(queue.impl);
+	queue = {};
 }
 
-String
-Platform_LoadFileString(StringView path)
+void
+Platform_PushWork(WorkQueue& queue, WorkFn* function, void* data)
 {
-	String result = {};
+	WorkQueueImpl& impl = *queue.impl;
 
-	Bytes bytes = LoadFile(path, 1);
-	if (!bytes.data) return result;
+	AcquireSRWLockExclusive(&impl.lock);
+	WorkItem& item = List_Append(impl.pending);
+	item.function = function;
+	item.data     = data;
+	impl.outstanding++;
+	ReleaseSRWLockExclusive(&impl.lock);
 
-	result.length   = bytes.length;
-	result.capacity = bytes.capacity;
-	result.data     = (c8*) bytes.data;
+	WakeConditionVariable(&impl.workPushed);
+}
 
-	result[result.length++] = '\0';
+// NOTE: Returns the data of a finished work item, or nullptr if nothing has finished and wait is false
+void*
+Platform_PopFinishedWork(WorkQueue& queue, b8 wait)
+{
+	WorkQueueImpl& impl = *queue.impl;
+
+	void* result = nullptr;
+	AcquireSRWLockExclusive(&impl.lock);
+	{
+		Assert(!wait || impl.outstanding > 0);
+		while (wait && impl.finished.length == 0)
+			SleepConditionVariableSRW(&impl.workFinished, &impl.lock, INFINITE, 0);
+
+		if (impl.finished.length)
+		{
+			result = impl.finished[impl.finished.length - 1];
+			List_RemoveLast(impl.finished);
+			impl.outstanding--;
+		}
+	}
+	ReleaseSRWLockExclusive(&impl.lock);
 
 	return result;
 }
 
-i64
-Platform_GetTicks()
+// -------------------------------------------------------------------------------------------------
+// Shared Memory Pipes
+
+// NOTE: An alternative transport to named pipes. The server creates a page file backed mapping that
+// holds a single producer single consumer ring for each direction. Messages are framed with a u32
+// size and copied directly into and out of the mapping so reads and writes never enter the kernel.
+// Both ends poll once per frame so there's no blocked reader to wake. Peer liveness is tracked with
+// process handles so a crashed peer is noticed the same way a broken named pipe is.
+
+const u32  SharedPipeMagic        = 0x50484D4C;
+const u32  SharedPipeRingCapacity = 1 * Megabyte;
+const LONG SharedPipeListening    = 0;
+const LONG SharedPipeClaimed      = 1;
+const LONG SharedPipeConnected    = 2;
+const LONG SharedPipeClosed       = 3;
+
+struct SharedPipeRing
 {
-	// NOTE: Never fails above XP
-	LARGE_INTEGER counter;
-	QueryPerformanceCounter(&counter);
+	volatile LONG64 writeCursor;
+	u8              writePadding[56];
+	volatile LONG64 readCursor;
+	u8              readPadding[56];
+	u8              data[SharedPipeRingCapacity];
+};
 
-	return (i64) counter.QuadPart;
-}
+struct SharedPipeHeader
+{
+	u32            magic;
+	u32            serverProcessId;
+	volatile LONG  clientProcessId;
+	volatile LONG  state;
+	volatile LONG  generation;
+	SharedPipeRing rings[2]; // [0] server to client, [1] client to server
+};
 
-r32
-Platform_TicksToSeconds(i64 ticks)
+static void
+SharedPipe_CopyIn(SharedPipeRing& ring, i64 cursor, const void* data, u32 size)
 {
-	// NOTE: Never fails above XP
-	LARGE_INTEGER frequency;
-	QueryPerformanceFrequency(&frequency);
-	return (r32) ticks / (r32) frequency.QuadPart;
+	u32 offset = (u32) (cursor & (SharedPipeRingCapacity - 1));
+	u32 first  = Min(size, SharedPipeRingCapacity - offset);
+	memcpy(&ring.data[offset], data, first);
+	memcpy(&ring.data[0], (u8*) data + first, size - first);
 }
 
-i64
-Platform_SecondsToTicks(r32 seconds)
+static void
+SharedPipe_CopyOut(SharedPipeRing& ring, i64 cursor, void* data, u32 size)
 {
-	// NOTE: Never fails above XP
-	LARGE_INTEGER frequency;
-	QueryPerformanceFrequency(&frequency);
-	return (i64) (seconds * (r32) frequency.QuadPart);
+	u32 offset = (u32) (cursor & (SharedPipeRingCapacity - 1));
+	u32 first  = Min(size, SharedPipeRingCapacity - offset);
+	memcpy(data, &ring.data[offset], first);
+	memcpy((u8*) data + first, &ring.data[0], size - first);
 }
 
-r32
-Platform_GetElapsedSeconds(i64 startTicks)
+static void
+SharedPipe_Unmap(Pipe& pipe)
 {
-	i64 elapsedTicks = Platform_GetTicks() - startTicks;
-	return Platform_TicksToSeconds(elapsedTicks);
+	if (pipe.impl->shared)
+		UnmapViewOfFile(pipe.impl->shared);
+	if (IsValidHandle(pipe.impl->handle))
+		CloseHandle(pipe.impl->handle);
+	if (IsValidHandle(pipe.impl->peerProcess))
+		CloseHandle(pipe.impl->peerProcess);
+
+	pipe.impl->shared      = nullptr;
+	pipe.impl->handle      = nullptr;
+	pipe.impl->peerProcess = nullptr;
 }
 
-r32
-Platform_GetElapsedSeconds(i64 startTicks, i64 endTicks)
+static b8
+SharedPipe_IsPeerAlive(Pipe& pipe)
 {
-	i64 elapsedTicks = endTicks - startTicks;
-	return Platform_TicksToSeconds(elapsedTicks);
+	if (!IsValidHandle(pipe.impl->peerProcess)) return false;
+	return WaitForSingleObject(pipe.impl->peerProcess, 0) == WAIT_TIMEOUT;
 }
 
-r32
-Platform_GetElapsedMilliseconds(i64 startTicks)
+static PipeResult
+SharedPipe_Disconnect(Pipe& pipe)
 {
-	i64 elapsedTicks = Platform_GetTicks() - startTicks;
-	return Platform_TicksToSeconds(elapsedTicks) * 1000.0f;
+	PipeState state = pipe.state;
+	pipe.state = PipeState::Disconnecting;
+
+	if (IsValidHandle(pipe.impl->peerProcess))
+		CloseHandle(pipe.impl->peerProcess);
+	pipe.impl->peerProcess = nullptr;
+
+	SharedPipeHeader* shared = pipe.impl->shared;
+	if (pipe.isServer)
+	{
+		// NOTE: Reset the rings before listening so a new client never sees stale messages
+		if (shared && state != PipeState::Disconnected)
+		{
+			InterlockedIncrement(&shared->generation);
+			for (u32 i = 0; i < ArrayLength(shared->rings); i++)
+			{
+				shared->rings[i].writeCursor = 0;
+				shared->rings[i].readCursor  = 0;
+			}
+			InterlockedExchange(&shared->clientProcessId, 0);
+			InterlockedExchange(&shared->state, SharedPipeListening);
+		}
+	}
+	else
+	{
+		if (shared && shared->generation == pipe.impl->generation)
+			InterlockedExchange(&shared->state, SharedPipeClosed);
+
+		// NOTE: The client reopens the mapping on every connection in case the server restarted
+		SharedPipe_Unmap(pipe);
+	}
+
+	pipe.state = PipeState::Disconnected;
+	return PipeResult::Success;
 }
 
-r32
-Platform_GetElapsedMilliseconds(i64 startTicks, i64 endTicks)
+static PipeResult
+SharedPipe_ConnectServer(Pipe& pipe)
 {
-	i64 elapsedTicks = endTicks - startTicks;
-	return Platform_TicksToSeconds(elapsedTicks) * 1000.0f;
+	// Create the mapping
+	if (!pipe.impl->shared)
+	{
+		u64 mappingSize = sizeof(SharedPipeHeader);
+		pipe.impl->handle = CreateFileMappingA(
+			INVALID_HANDLE_VALUE,
+			nullptr,
+			PAGE_READWRITE,
+			(u32) (mappingSize >> 32),
+			(u32) (mappingSize >>  0),
+			pipe.impl->fullName.data
+		);
+		LOG_LAST_ERROR_IF(!IsValidHandle(pipe.impl->handle), return PipeResult::UnexpectedFailure,
+			Severity::Warning, "Failed to create shared memory pipe server '%'", pipe.name);
+
+		// Another server has created the pipe
+		if (GetLastError() == ERROR_ALREADY_EXISTS)
+		{
+			SharedPipe_Unmap(pipe);
+			return PipeResult::TransientFailure;
+		}
+
+		pipe.impl->shared = (SharedPipeHeader*) MapViewOfFile(pipe.impl->handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+		LOG_LAST_ERROR_IF(!pipe.impl->shared, SharedPipe_Unmap(pipe); return PipeResult::UnexpectedFailure,
+			Severity::Warning, "Failed to map shared memory pipe server '%'", pipe.name);
+
+		SharedPipeHeader& shared = *pipe.impl->shared;
+		shared.serverProcessId = GetCurrentProcessId();
+		shared.generation      = 1;
+		shared.state           = SharedPipeListening;
+		InterlockedExchange((volatile LONG*) &shared.magic, SharedPipeMagic);
+	}
+
+	SharedPipeHeader& shared = *pipe.impl->shared;
+	switch (pipe.state)
+	{
+		default:
+		case PipeState::Null:
+			Assert(false);
+			break;
+
+		case PipeState::Connected:
+			return PipeResult::Success;
+
+		case PipeState::Disconnecting:
+			return PipeResult::TransientFailure;
+
+		// Wait for a client to claim the pipe
+		case PipeState::Disconnected:
+		case PipeState::Connecting:
+		{
+			pipe.state = PipeState::Connecting;
+			if (shared.state != SharedPipeClaimed) return PipeResult::TransientFailure;
+
+			pipe.impl->peerProcess = OpenProcess(SYNCHRONIZE, false, (u32) shared.clientProcessId);
+			if (!IsValidHandle(pipe.impl->peerProcess))
+			{
+				// Client exited before we noticed it
+				pipe.state = PipeState::Connected;
+				return SharedPipe_Disconnect(pipe) == PipeResult::Success
+					? PipeResult::TransientFailure
+					: PipeResult::UnexpectedFailure;
+			}
+
+			pipe.impl->generation = shared.generation;
+			InterlockedExchange(&shared.state, SharedPipeConnected);
+			break;
+		}
+	}
+
+	pipe.state = PipeState::Connected;
+	return PipeResult::Success;
 }
 
-void
-Platform_Sleep(u32 ms)
+static PipeResult
+SharedPipe_ConnectClient(Pipe& pipe)
 {
-	Sleep(ms);
+	switch (pipe.state)
+	{
+		default:
+		case PipeState::Null:
+			Assert(false);
+			break;
+
+		// Impossible for client pipes
+		case PipeState::Connecting:
+			Assert(false);
+			break;
+
+		case PipeState::Connected:
+			return PipeResult::Success;
+
+		case PipeState::Disconnecting:
+			return PipeResult::TransientFailure;
+
+		case PipeState::Disconnected:
+			break;
+	}
+
+	auto cleanupGuard = guard { SharedPipe_Unmap(pipe); };
+
+	pipe.impl->handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, false, pipe.impl->fullName.data);
+	if (!IsValidHandle(pipe.impl->handle))
+	{
+		u32 error = GetLastError();
+		switch (error)
+		{
+			// Server hasn't created the pipe yet
+			case ERROR_FILE_NOT_FOUND:
+				return PipeResult::TransientFailure;
+
+			default:
+				LOG_LAST_ERROR(Severity::Error, "Failed to open shared memory pipe client '%'", pipe.name);
+				return PipeResult::UnexpectedFailure;
+		}
+	}
+
+	pipe.impl->shared = (SharedPipeHeader*) MapViewOfFile(pipe.impl->handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+	LOG_LAST_ERROR_IF(!pipe.impl->shared, return PipeResult::UnexpectedFailure,
+		Severity::Warning, "Failed to map shared memory pipe client '%'", pipe.name);
+
+	SharedPipeHeader& shared = *pipe.impl->shared;
+
+	// Server is still initializing
+	if (shared.magic != SharedPipeMagic) return PipeResult::TransientFailure;
+
+	// Server exited
+	pipe.impl->peerProcess = OpenProcess(SYNCHRONIZE, false, shared.serverProcessId);
+	if (!SharedPipe_IsPeerAlive(pipe)) return PipeResult::TransientFailure;
+
+	// Another client is connected
+	LONG processId = (LONG) GetCurrentProcessId();
+	if (InterlockedCompareExchange(&shared.clientProcessId, processId, 0) != 0)
+		return PipeResult::TransientFailure;
+
+	pipe.impl->generation = shared.generation;
+	InterlockedExchange(&shared.state, SharedPipeClaimed);
+
+	cleanupGuard.dismiss = true;
+	pipe.state = PipeState::Connected;
+	return PipeResult::Success;
 }
 
-void
-Platform_RequestQuit()
+static PipeResult
+SharedPipe_UpdateConnection(Pipe& pipe)
 {
-	PostQuitMessage(0);
+	PipeResult result = pipe.isServer
+		? SharedPipe_ConnectServer(pipe)
+		: SharedPipe_ConnectClient(pipe);
+	if (result != PipeResult::Success) return result;
+
+	SharedPipeHeader& shared = *pipe.impl->shared;
+
+	b8 closed = false;
+	closed |= !SharedPipe_IsPeerAlive(pipe);
+	closed |= shared.generation != pipe.impl->generation;
+	closed |= pipe.isServer && shared.state == SharedPipeClosed;
+
+	// Pipe has been closed
+	if (closed)
+		return SharedPipe_Disconnect(pipe);
+
+	return PipeResult::Success;
 }
 
-struct PipeImpl
+static PipeResult
+SharedPipe_Write(Pipe& pipe, ByteSlice bytes)
 {
-	String     fullName;
-	HANDLE     handle;
-	OVERLAPPED connect;
-};
+	Assert(!Slice_IsSparse(bytes));
+	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
 
-inline b8
-IsValidHandle(HANDLE handle)
+	SharedPipeHeader& shared = *pipe.impl->shared;
+	if (shared.generation != pipe.impl->generation) return PipeResult::TransientFailure;
+
+	u32 size = sizeof(u32) + bytes.length;
+	LOG_IF(size > SharedPipeRingCapacity, return PipeResult::UnexpectedFailure,
+		Severity::Error, "Message is too large for shared memory pipe '%'", pipe.name);
+
+	SharedPipeRing& ring = shared.rings[pipe.isServer ? 0 : 1];
+	i64 writeCursor = ring.writeCursor;
+	i64 readCursor  = ring.readCursor;
+
+	// Not enough space, try again later
+	if (SharedPipeRingCapacity - (writeCursor - readCursor) < size)
+		return PipeResult::TransientFailure;
+
+	SharedPipe_CopyIn(ring, writeCursor, &bytes.length, sizeof(u32));
+	SharedPipe_CopyIn(ring, writeCursor + sizeof(u32), bytes.data, bytes.length);
+
+	// NOTE: The server resets the rings for the next client after bumping the generation. If that
+	// happened during the copy the message is dropped rather than published into the new ring.
+	// Publishing with a compare exchange catches a reset that lands after the check.
+	if (InterlockedCompareExchange(&shared.generation, 0, 0) != pipe.impl->generation)
+		return PipeResult::TransientFailure;
+
+	i64 previous = InterlockedCompareExchange64(&ring.writeCursor, writeCursor + size, writeCursor);
+	if (previous != writeCursor) return PipeResult::TransientFailure;
+
+	return PipeResult::Success;
+}
+
+static PipeResult
+SharedPipe_Read(Pipe& pipe, Bytes& bytes)
 {
-	// NOTE: Some Win32 functions return nullptr and some return INVALID_HANDLE_VALUE on failure.
-	// Things would be fine if that were the end of it. But some functions take 'pseudohandles' and
-	// INVALID_HANDLE_VALUE can be a valid pseudohandle. Fuck you, Microsoft.
-	return handle != nullptr && handle != INVALID_HANDLE_VALUE;
+	bytes.length = 0;
+
+	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
+
+	SharedPipeHeader& shared = *pipe.impl->shared;
+	if (shared.generation != pipe.impl->generation) return PipeResult::TransientFailure;
+
+	SharedPipeRing& ring = shared.rings[pipe.isServer ? 1 : 0];
+	i64 readCursor  = ring.readCursor;
+	i64 writeCursor = ring.writeCursor;
+	if (readCursor == writeCursor) return PipeResult::Success;
+
+	u32 length;
+	SharedPipe_CopyOut(ring, readCursor, &length, sizeof(u32));
+	LOG_IF(writeCursor - readCursor < (i64) (sizeof(u32) + length), return PipeResult::UnexpectedFailure,
+		Severity::Fatal, "Corrupted message in shared memory pipe '%'", pipe.name);
+
+	List_Reserve(bytes, length);
+	SharedPipe_CopyOut(ring, readCursor + sizeof(u32), bytes.data, length);
+	InterlockedExchange64(&ring.readCursor, readCursor + sizeof(u32) + length);
+
+	bytes.length = length;
+	return PipeResult::Success;
 }
 
+// -------------------------------------------------------------------------------------------------
+// Named Pipes
+
 PipeResult
 Platform_DisconnectPipeServer(Pipe& pipe)
 {
@@ -442,6 +1936,9 @@ Platform_DisconnectPipeClient(Pipe& pipe)
 PipeResult
 Platform_DisconnectPipe(Pipe& pipe)
 {
+	if (pipe.transport == PipeTransport::SharedMemory)
+		return SharedPipe_Disconnect(pipe);
+
 	return pipe.isServer
 		? Platform_DisconnectPipeServer(pipe)
 		: Platform_DisconnectPipeClient(pipe);
@@ -644,6 +2141,11 @@ Platform_ConnectPipeClient(Pipe& pipe)
 PipeResult
 Platform_ConnectPipe(Pipe& pipe)
 {
+	if (pipe.transport == PipeTransport::SharedMemory)
+		return pipe.isServer
+			? SharedPipe_ConnectServer(pipe)
+			: SharedPipe_ConnectClient(pipe);
+
 	return pipe.isServer
 		? Platform_ConnectPipeServer(pipe)
 		: Platform_ConnectPipeClient(pipe);
@@ -652,6 +2154,9 @@ Platform_ConnectPipe(Pipe& pipe)
 PipeResult
 Platform_UpdatePipeConnection(Pipe& pipe)
 {
+	if (pipe.transport == PipeTransport::SharedMemory)
+		return SharedPipe_UpdateConnection(pipe);
+
 	PipeResult result = Platform_ConnectPipe(pipe);
 	if (result != PipeResult::Success) return result;
 
@@ -687,16 +2192,17 @@ Platform_UpdatePipeConnection(Pipe& pipe)
 }
 
 PipeResult
-Platform_CreatePipeServer(StringView name, Pipe& pipe)
+Platform_CreatePipeServer(StringView name, Pipe& pipe, PipeTransport transport)
 {
 	auto cleanupGuard = guard { Platform_DestroyPipe(pipe); };
 
 	// Initialize
 	{
 		pipe = {};
-		pipe.name     = String_FromView(name);
-		pipe.state    = PipeState::Disconnected;
-		pipe.isServer = true;
+		pipe.name      = String_FromView(name);
+		pipe.state     = PipeState::Disconnected;
+		pipe.isServer  = true;
+		pipe.transport = transport;
 	}
 
 	// Allocate platform data
@@ -704,10 +2210,13 @@ Platform_CreatePipeServer(StringView name, Pipe& pipe)
 		pipe.impl = (PipeImpl*) AllocChecked(sizeof(PipeImpl));
 		*pipe.impl = {};
 
-		pipe.impl->fullName = String_Format("\\\\.\\pipe\\%", pipe.name);
+		pipe.impl->fullName = transport == PipeTransport::SharedMemory
+			? String_Format("Local\\%", pipe.name)
+			: String_Format("\\\\.\\pipe\\%", pipe.name);
 	}
 
 	// Create connection event
+	if (transport == PipeTransport::NamedPipe)
 	{
 		// TODO: This is crazy town. Find confirmation for this behavior.
 		// NOTE: Windows holds the pointer to the overlapped struct and will update the Internal
@@ -725,16 +2234,17 @@ Platform_CreatePipeServer(StringView name, Pipe& pipe)
 }
 
 PipeResult
-Platform_CreatePipeClient(StringView name, Pipe& pipe)
+Platform_CreatePipeClient(StringView name, Pipe& pipe, PipeTransport transport)
 {
 	auto cleanupGuard = guard { Platform_DestroyPipe(pipe); };
 
 	// Initialize
 	{
 		pipe = {};
-		pipe.name     = String_FromView(name);
-		pipe.state    = PipeState::Disconnected;
-		pipe.isServer = false;
+		pipe.name      = String_FromView(name);
+		pipe.state     = PipeState::Disconnected;
+		pipe.isServer  = false;
+		pipe.transport = transport;
 	}
 
 	// Allocate platform data
@@ -742,14 +2252,16 @@ Platform_CreatePipeClient(StringView name, Pipe& pipe)
 		pipe.impl = (PipeImpl*) AllocChecked(sizeof(PipeImpl));
 		*pipe.impl = {};
 
-		pipe.impl->fullName = String_Format("\\\\.\\pipe\\%", pipe.name);
+		pipe.impl->fullName = transport == PipeTransport::SharedMemory
+			? String_Format("Local\\%", pipe.name)
+			: String_Format("\\\\.\\pipe\\%", pipe.name);
 	}
 
 	// Attempt to connect
 	{
 		cleanupGuard.dismiss = true;
 
-		PipeResult result = Platform_ConnectPipeClient(pipe);
+		PipeResult result = Platform_ConnectPipe(pipe);
 		if (result != PipeResult::Success) return result;
 	}
 
@@ -759,6 +2271,22 @@ Platform_CreatePipeClient(StringView name, Pipe& pipe)
 void
 Platform_DestroyPipe(Pipe& pipe)
 {
+	if (pipe.transport == PipeTransport::SharedMemory)
+	{
+		// NOTE: Clients notice the generation change and disconnect
+		SharedPipeHeader* shared = pipe.impl->shared;
+		if (shared && pipe.isServer)
+		{
+			shared->serverProcessId = 0;
+			InterlockedIncrement(&shared->generation);
+		}
+
+		if (!pipe.isServer && pipe.state == PipeState::Connected)
+			SharedPipe_Disconnect(pipe);
+
+		SharedPipe_Unmap(pipe);
+	}
+
 	String_Free(pipe.name);
 	String_Free(pipe.impl->fullName);
 	// TODO: Handle failure?
@@ -777,6 +2305,9 @@ Platform_WritePipe(Pipe& pipe, ByteSlice bytes)
 
 	// NOTE: Synchronous writes will begin blocking once the pipes internal buffer is full.
 
+	if (pipe.transport == PipeTransport::SharedMemory)
+		return SharedPipe_Write(pipe, bytes);
+
 	Assert(!Slice_IsSparse(bytes));
 	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
 
@@ -821,6 +2352,9 @@ Platform_WritePipe(Pipe& pipe, ByteSlice bytes)
 PipeResult
 Platform_ReadPipe(Pipe& pipe, Bytes& bytes)
 {
+	if (pipe.transport == PipeTransport::SharedMemory)
+		return SharedPipe_Read(pipe, bytes);
+
 	bytes.length = 0;
 
 	if (pipe.state != PipeState::Connected) return PipeResult::TransientFailure;
@@ -893,6 +2427,9 @@ Platform_ReadPipe(Pipe& pipe, Bytes& bytes)
 PipeResult
 Platform_FlushPipe(Pipe& pipe)
 {
+	// NOTE: Shared memory writes are visible to the reader as soon as they complete
+	if (pipe.transport == PipeTransport::SharedMemory) return PipeResult::Success;
+
 	if (!IsValidHandle(pipe.impl->handle)) return PipeResult::TransientFailure;
 
 	b8 success = FlushFileBuffers(pipe.impl->handle);
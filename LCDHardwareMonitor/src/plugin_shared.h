@@ -32,6 +32,24 @@ enum struct PluginLoadState
 	Broken,
 };
 
+// NOTE: How frames are converted before they're sent to the LCD. See pixels.hpp.
+enum struct PixelFormat
+{
+	Null,
+	RGB565,
+	RGB666,
+	Count
+};
+
+// NOTE: Null means no dithering. Channels are rounded to the nearest value instead.
+enum struct Dither
+{
+	Null,
+	Ordered,
+	BlueNoise,
+	Count
+};
+
 struct Plugin
 {
 	Handle<Plugin>  handle;
@@ -42,6 +60,16 @@ struct Plugin
 	String          fileName;
 	String          directory;
 	void*           loaderData;
+	b8              outOfProcess;
+};
+
+struct SensorPluginSchedule
+{
+	i64 nextUpdate;
+	u32 updates;
+	u32 overruns;
+	r32 worstJitter;
+	r32 worstDuration;
 };
 
 struct SensorPlugin
@@ -50,12 +78,30 @@ struct SensorPlugin
 	Handle<Plugin>        pluginHandle;
 	StringSlice           name;
 	SensorPluginFunctions functions;
+	SensorPluginSchedule  schedule;
 	List<Sensor>          sensors;
 	//List<Handle<Sensor>> activeSensors;
+
+	// NOTE: Hot sensor data is kept in columns parallel to sensors. values is written by the plugin,
+	// the rest is maintained by the application after each update. changed is set for sensors whose
+	// value differs from the previous update and changeTicks is when that last happened.
+	List<r32>             values;
+	List<r32>             lastValues;
+	List<i64>             changeTicks;
+	List<b8>              changed;
 };
 
 struct WidgetPlugin;
 
+// NOTE: Where a widget's sensor value lives, so values can be gathered straight from the hot column
+// without touching Sensor. sensorHandle is the handle it was resolved from.
+struct SensorBinding
+{
+	Handle<Sensor> sensorHandle;
+	u32            sensorPluginIndex;
+	u32            valueIndex;
+};
+
 struct WidgetType
 {
 	using InitializeFn = b8  (PluginContext&, WidgetAPI::Initialize);
@@ -68,6 +114,10 @@ struct WidgetType
 	u32                  userDataSize;
 	List<Widget>         widgets;
 	Bytes                widgetsUserData;
+	List<Matrix>         wvps;      // NOTE: Parallel to widgets
+	b8                   wvpsDirty; // NOTE: Set when widgets are added, removed, or moved, or the camera changes
+	List<SensorBinding>  sensorBindings;        // NOTE: Parallel to widgets
+	u32                  sensorBindingsVersion; // NOTE: Stale when it doesn't match SimulationState's
 	InitializeFn*        Initialize;
 	UpdateFn*            Update;
 	TeardownFn*          Teardown;
@@ -80,4 +130,5 @@ struct WidgetPlugin
 	StringSlice           name;
 	WidgetPluginFunctions functions;
 	List<WidgetType>      widgetTypes;
+	List<PixelShader>     pixelShaders; // NOTE: Loaded by the current library, destroyed with it
 };
@@ -0,0 +1,319 @@
+#include <dlfcn.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+
+// NOTE: Only native plugins are supported on Linux. Plugins are shared objects that export the
+// same GetSensorPluginInfo / GetWidgetPluginInfo entry points as the Windows DLLs. The function
+// table a plugin fills in is stored directly in SensorPlugin / WidgetPlugin, so calls into a
+// plugin are a single indirect call with no lookup or thunk in between.
+
+// NOTE: RTLD_NOW binds every symbol at load time so the first call into a plugin doesn't take a
+// detour through the lazy binding resolver. RTLD_LOCAL keeps plugin symbols out of the global
+// namespace so plugins can't collide with each other. RTLD_DEEPBIND makes a plugin prefer its own
+// symbols over the host's, but it breaks interposition, which sanitizers rely on, so it's skipped
+// in sanitized builds.
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+	#define LHM_RTLD_DEEPBIND 0
+#elif defined(__has_feature)
+	#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+		#define LHM_RTLD_DEEPBIND 0
+	#endif
+#endif
+#ifndef LHM_RTLD_DEEPBIND
+	#define LHM_RTLD_DEEPBIND RTLD_DEEPBIND
+#endif
+
+struct PluginLoaderState
+{
+	i32 dlopenFlags;
+};
+
+b8
+PluginLoader_Initialize(PluginLoaderState& s)
+{
+	s.dlopenFlags = RTLD_NOW | RTLD_LOCAL | LHM_RTLD_DEEPBIND;
+	return true;
+}
+
+void
+PluginLoader_Teardown(PluginLoaderState& s)
+{
+	s = {};
+}
+
+static b8
+DetectPluginLanguage(Plugin& plugin)
+{
+	String pluginPath = String_Format("%/%", plugin.directory, plugin.fileName);
+	defer { String_Free(pluginPath); };
+
+	i32 fd = open(pluginPath.data, O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		c8 cwd[PATH_MAX] = {};
+		if (!getcwd(cwd, sizeof(cwd))) cwd[0] = '\0';
+		LOG_ERRNO(Severity::Error, "Failed to open plugin file '%'; CWD: '%'", pluginPath, (const c8*) cwd);
+		return false;
+	}
+	defer { close(fd); };
+
+	// NOTE: Only the ELF header is needed, so a plain read is cheaper than mapping the file
+	Elf64_Ehdr header = {};
+	ssize_t length = read(fd, &header, sizeof(header));
+	LOG_ERRNO_IF(length < 0, return false,
+		Severity::Error, "Failed to read plugin file '%'", plugin.fileName);
+
+	b8 isElf = (size_t) length >= EI_NIDENT && memcmp(header.e_ident, ELFMAG, SELFMAG) == 0;
+	LOG_IF(!isElf, return false,
+		Severity::Error, "Plugin file does not have a proper ELF header '%'", plugin.fileName);
+	LOG_IF((size_t) length < sizeof(header) || header.e_ident[EI_CLASS] != ELFCLASS64, return false,
+		Severity::Error, "Plugin file is not a 64-bit ELF '%'", plugin.fileName);
+	LOG_IF(header.e_type != ET_DYN, return false,
+		Severity::Error, "Plugin file is not a shared object '%'", plugin.fileName);
+
+	plugin.language = PluginLanguage::Native;
+	return true;
+}
+
+static b8
+ValidatePluginDesc(PluginDesc& pluginDesc)
+{
+	b8 valid = true;
+	valid = valid && pluginDesc.name.length > 0;
+	valid = valid && pluginDesc.author.length > 0;
+	valid = valid && pluginDesc.version;
+	valid = valid && pluginDesc.lhmVersion == LHMVersion;
+	return valid;
+}
+
+static void*
+LoadSharedObject(PluginLoaderState& s, Plugin& plugin, StringView kind)
+{
+	// NOTE: Using the full path means dlopen won't search LD_LIBRARY_PATH for the plugin itself.
+	// Dependencies next to the plugin are found through the plugin's own RUNPATH ($ORIGIN).
+	String pluginPath = String_Format("%/%", plugin.directory, plugin.fileName);
+	defer { String_Free(pluginPath); };
+
+	void* module = dlopen(pluginPath.data, s.dlopenFlags);
+	LOG_IF(!module, return nullptr,
+		Severity::Error, "Failed to load unmanaged % plugin '%': %", kind, plugin.fileName, dlerror());
+
+	return module;
+}
+
+static b8
+UnloadSharedObject(Plugin& plugin, StringView kind)
+{
+	i32 result = dlclose(plugin.loaderData);
+	LOG_IF(result != 0, return false,
+		Severity::Error, "Failed to unload unmanaged % plugin '%': %", kind, plugin.fileName, dlerror());
+
+	plugin.loaderData = nullptr;
+	return true;
+}
+
+b8
+PluginLoader_LoadSensorPlugin(PluginLoaderState& s, Plugin& plugin, SensorPlugin& sensorPlugin)
+{
+	auto pluginGuard = guard { plugin.loadState = PluginLoadState::Broken; };
+
+	// NOTE: Anything that fails after dlopen leaves the module loaded otherwise
+	auto moduleGuard = guard { if (plugin.loaderData) UnloadSharedObject(plugin, "Sensor"); };
+
+	if (plugin.language != PluginLanguage::Builtin)
+	{
+		b8 success = DetectPluginLanguage(plugin);
+		if (!success) return false;
+	}
+
+	PluginDesc pluginDesc = {};
+
+	b8 success = false;
+	switch (plugin.language)
+	{
+		default:
+		case PluginLanguage::Null:
+			success = false;
+			break;
+
+		case PluginLanguage::Builtin:
+		{
+			sensorPlugin.functions.GetPluginInfo(pluginDesc, sensorPlugin.functions);
+			success = true;
+			break;
+		}
+
+		case PluginLanguage::Native:
+		{
+			success = false;
+
+			plugin.loaderData = LoadSharedObject(s, plugin, "Sensor");
+			if (!plugin.loaderData) break;
+
+			sensorPlugin.functions.GetPluginInfo = (SensorPluginFunctions::GetPluginInfoFn*) dlsym(plugin.loaderData, "GetSensorPluginInfo");
+			LOG_IF(!sensorPlugin.functions.GetPluginInfo, break,
+				Severity::Error, "Failed to find unmanaged GetSensorPluginInfo '%'", plugin.fileName);
+
+			sensorPlugin.functions.GetPluginInfo(pluginDesc, sensorPlugin.functions);
+
+			success = true;
+			break;
+		}
+
+		case PluginLanguage::Managed:
+			LOG(Severity::Error, "Managed Sensor plugins are not supported on Linux '%'", plugin.fileName);
+			success = false;
+			break;
+	}
+	if (!success) return false;
+
+	success = ValidatePluginDesc(pluginDesc);
+	LOG_IF(!success, return false,
+		Severity::Error, "Sensor plugin provided invalid description '%'", plugin.fileName);
+
+	plugin.loadState       = PluginLoadState::Loaded;
+	plugin.info.name       = String_FromView(pluginDesc.name);
+	plugin.info.author     = String_FromView(pluginDesc.author);
+	plugin.info.version    = pluginDesc.version;
+	plugin.info.lhmVersion = pluginDesc.lhmVersion;
+
+	moduleGuard.dismiss = true;
+	pluginGuard.dismiss = true;
+	return true;
+}
+
+b8
+PluginLoader_UnloadSensorPlugin(PluginLoaderState& s, Plugin& plugin, SensorPlugin& sensorPlugin)
+{
+	Unused(s, sensorPlugin);
+
+	b8 success = false;
+
+	auto pluginGuard = guard { plugin.loadState = PluginLoadState::Broken; };
+
+	switch (plugin.language)
+	{
+		default:
+		case PluginLanguage::Null:
+		case PluginLanguage::Managed:
+			success = false;
+			break;
+
+		case PluginLanguage::Builtin:
+			success = true;
+			break;
+
+		case PluginLanguage::Native:
+			success = UnloadSharedObject(plugin, "Sensor");
+			break;
+	}
+	if (!success) return false;
+
+	pluginGuard.dismiss = true;
+	plugin.loadState = PluginLoadState::Unloaded;
+	return true;
+}
+
+b8
+PluginLoader_LoadWidgetPlugin(PluginLoaderState& s, Plugin& plugin, WidgetPlugin& widgetPlugin)
+{
+	auto pluginGuard = guard { plugin.loadState = PluginLoadState::Broken; };
+
+	// NOTE: Anything that fails after dlopen leaves the module loaded otherwise
+	auto moduleGuard = guard { if (plugin.loaderData) UnloadSharedObject(plugin, "Widget"); };
+
+	if (plugin.language != PluginLanguage::Builtin)
+	{
+		b8 success = DetectPluginLanguage(plugin);
+		if (!success) return false;
+	}
+
+	PluginDesc pluginDesc = {};
+
+	b8 success = false;
+	switch (plugin.language)
+	{
+		default:
+		case PluginLanguage::Null:
+			success = false;
+			break;
+
+		case PluginLanguage::Builtin:
+		{
+			widgetPlugin.functions.GetPluginInfo(pluginDesc, widgetPlugin.functions);
+			success = true;
+			break;
+		}
+
+		case PluginLanguage::Native:
+		{
+			success = false;
+
+			plugin.loaderData = LoadSharedObject(s, plugin, "Widget");
+			if (!plugin.loaderData) break;
+
+			widgetPlugin.functions.GetPluginInfo = (WidgetPluginFunctions::GetPluginInfoFn*) dlsym(plugin.loaderData, "GetWidgetPluginInfo");
+			LOG_IF(!widgetPlugin.functions.GetPluginInfo, break,
+				Severity::Error, "Failed to find unmanaged GetWidgetPluginInfo '%'", plugin.fileName);
+
+			widgetPlugin.functions.GetPluginInfo(pluginDesc, widgetPlugin.functions);
+
+			success = true;
+			break;
+		}
+
+		case PluginLanguage::Managed:
+			LOG(Severity::Error, "Managed Widget plugins are not supported on Linux '%'", plugin.fileName);
+			success = false;
+			break;
+	}
+	if (!success) return false;
+
+	success = ValidatePluginDesc(pluginDesc);
+	LOG_IF(!success, return false,
+		Severity::Error, "Widget plugin provided invalid description '%'", plugin.fileName);
+
+	plugin.loadState       = PluginLoadState::Loaded;
+	plugin.info.name       = String_FromView(pluginDesc.name);
+	plugin.info.author     = String_FromView(pluginDesc.author);
+	plugin.info.version    = pluginDesc.version;
+	plugin.info.lhmVersion = pluginDesc.lhmVersion;
+
+	moduleGuard.dismiss = true;
+	pluginGuard.dismiss = true;
+	return true;
+}
+
+b8
+PluginLoader_UnloadWidgetPlugin(PluginLoaderState& s, Plugin& plugin, WidgetPlugin& widgetPlugin)
+{
+	Unused(s, widgetPlugin);
+
+	b8 success = false;
+
+	auto pluginGuard = guard { plugin.loadState = PluginLoadState::Broken; };
+
+	switch (plugin.language)
+	{
+		default:
+		case PluginLanguage::Null:
+		case PluginLanguage::Managed:
+			success = false;
+			break;
+
+		case PluginLanguage::Builtin:
+			success = true;
+			break;
+
+		case PluginLanguage::Native:
+			success = UnloadSharedObject(plugin, "Widget");
+			break;
+	}
+	if (!success) return false;
+
+	pluginGuard.dismiss = true;
+	plugin.loadState = PluginLoadState::Unloaded;
+	return true;
+}
@@ -40,11 +40,15 @@ struct LHMHostControl final : public IHostControl
 	ComPtr<ILHMPluginLoader> lhmPluginLoader;
 };
 
+// NOTE: Plugins can be loaded from worker threads during startup. Native plugins are loaded with
+// LoadLibraryEx and an explicit search path instead of SetDllDirectory, which is process wide. The
+// managed loader isn't thread safe so calls into it are serialized with managedLock.
 struct PluginLoaderState
 {
 	ComPtr<ICLRRuntimeHost> clrHost;
 	LHMHostControl          lhmHostControl;
 	ILHMPluginLoader*       lhmPluginLoader;
+	SRWLOCK                 managedLock;
 };
 
 b8
@@ -130,61 +134,28 @@ PluginLoader_Teardown(PluginLoaderState& s)
 static b8
 DetectPluginLanguage(Plugin& plugin)
 {
-	// TODO: Move memory mapping to platform API?
-
 	String pluginPath = String_Format("%\\%", plugin.directory, plugin.fileName);
 	defer { String_Free(pluginPath); };
 
-	HANDLE pluginFile = CreateFileA(
-		pluginPath.data,
-		GENERIC_READ,
-		FILE_SHARE_READ,
-		nullptr,
-		OPEN_EXISTING,
-		FILE_ATTRIBUTE_NORMAL,
-		nullptr
-	);
-	defer { CloseHandle(pluginFile); };
-	if (pluginFile == INVALID_HANDLE_VALUE)
-	{
-		String cwd = GetWorkingDirectory();
-		defer { String_Free(cwd); };
-		LOG_LAST_ERROR(Severity::Error, "Failed to open plugin file '%'; CWD: '%'", pluginPath, cwd);
-		return false;
-	}
-
-	HANDLE pluginFileMap = CreateFileMappingA(
-		pluginFile,
-		nullptr,
-		PAGE_READONLY,
-		0, 0,
-		nullptr
-	);
-	LOG_LAST_ERROR_IF(!pluginFileMap, return false,
-		Severity::Error, "Failed to create plugin file mapping '%'", plugin.fileName);
-	defer { CloseHandle(pluginFileMap); };
-
 	// TODO: We could map the DOS header, get the PE offset, then remap starting there
 	// NOTE: Can't map a fixed number of bytes because the DOS stub is of unknown length
-	u8* pluginFileMemory = (u8*) MapViewOfFile(pluginFileMap, FILE_MAP_READ, 0, 0, 0);
-	LOG_LAST_ERROR_IF(!pluginFileMemory, return false,
-		Severity::Error, "Failed to map view of plugin file '%'", plugin.fileName);
-	defer {
-		if (pluginFileMemory)
-		{
-			// BUG: Failures here will not propagate back to the calling function
-			// TODO: What happens if Unmap is called with null? Can we drop the check?
-			b8 success = UnmapViewOfFile(pluginFileMemory);
-			LOG_IF(!success, IGNORE,
-				Severity::Error, "Failed to unmap view of plugin file '%'", plugin.fileName);
-		}
-	};
+	ByteSlice pluginFile = Platform_MapFile(pluginPath, FileAccess::Random, true);
+	LOG_IF(!pluginFile.data, return false,
+		Severity::Error, "Failed to map plugin file '%'", plugin.fileName);
+	defer { Platform_UnmapFile(pluginFile); };
+
+	LOG_IF(pluginFile.length < sizeof(IMAGE_DOS_HEADER), return false,
+		Severity::Error, "Plugin file does not have a proper DOS header '%'", plugin.fileName);
 
-	IMAGE_DOS_HEADER& dosHeader = *(IMAGE_DOS_HEADER*) pluginFileMemory;
+	IMAGE_DOS_HEADER& dosHeader = *(IMAGE_DOS_HEADER*) pluginFile.data;
 	LOG_IF(dosHeader.e_magic != IMAGE_DOS_SIGNATURE, return false,
 		Severity::Error, "Plugin file does not have a proper DOS header '%'", plugin.fileName);
 
-	IMAGE_NT_HEADERS& ntHeader = (IMAGE_NT_HEADERS&) pluginFileMemory[dosHeader.e_lfanew];
+	b8 ntHeaderFits = dosHeader.e_lfanew >= 0 && (u64) dosHeader.e_lfanew + sizeof(IMAGE_NT_HEADERS) <= pluginFile.length;
+	LOG_IF(!ntHeaderFits, return false,
+		Severity::Error, "Plugin file does not have a proper NT header '%'", plugin.fileName);
+
+	IMAGE_NT_HEADERS& ntHeader = (IMAGE_NT_HEADERS&) pluginFile.data[dosHeader.e_lfanew];
 	LOG_IF(ntHeader.Signature != IMAGE_NT_SIGNATURE, return false,
 		Severity::Error, "Plugin file does not have a proper NT header '%'", plugin.fileName);
 
@@ -211,6 +182,23 @@ DetectPluginLanguage(Plugin& plugin)
 	return true;
 }
 
+// NOTE: Dependencies are searched for next to the plugin, then in the default directories. The DLL
+// load directory flag requires a fully qualified path.
+// TODO: Will this work with delay loaded dependencies?
+static HMODULE
+LoadNativePlugin(Plugin& plugin)
+{
+	String pluginPath = String_Format("%\\%", plugin.directory, plugin.fileName);
+	defer { String_Free(pluginPath); };
+
+	c8 fullPath[MAX_PATH];
+	u32 length = GetFullPathNameA(pluginPath.data, (DWORD) ArrayLength(fullPath), fullPath, nullptr);
+	if (length == 0 || length >= ArrayLength(fullPath)) return nullptr;
+
+	DWORD flags = LOAD_LIBRARY_SEARCH_DLL_LOAD_DIR | LOAD_LIBRARY_SEARCH_DEFAULT_DIRS;
+	return LoadLibraryExA(fullPath, nullptr, flags);
+}
+
 static b8
 ValidatePluginDesc(PluginDesc& pluginDesc)
 {
@@ -254,19 +242,10 @@ PluginLoader_LoadSensorPlugin(PluginLoaderState& s, Plugin& plugin, SensorPlugin
 		{
 			success = false;
 
-			// TODO: Will this work with delay loaded dependencies?
-			success = SetDllDirectoryA(plugin.directory.data);
-			LOG_IF(!success, break,
-				Severity::Error, "Failed to set Sensor plugin DLL directory '%'", plugin.directory);
-
-			plugin.loaderData = LoadLibraryA(plugin.fileName.data);
-			LOG_IF(!plugin.loaderData, break,
+			plugin.loaderData = LoadNativePlugin(plugin);
+			LOG_LAST_ERROR_IF(!plugin.loaderData, break,
 				Severity::Error, "Failed to load unmanaged Sensor plugin '%'", plugin.fileName);
 
-			success = SetDllDirectoryA("");
-			LOG_IF(!success, break,
-				Severity::Error, "Failed to unset Sensor plugin DLL directory '%'", plugin.directory);
-
 			HMODULE pluginModule = (HMODULE) plugin.loaderData;
 			sensorPlugin.functions.GetPluginInfo = (SensorPluginFunctions::GetPluginInfoFn*) (void*) GetProcAddress(pluginModule, "GetSensorPluginInfo");
 			LOG_IF(!sensorPlugin.functions.GetPluginInfo, break,
@@ -282,7 +261,9 @@ PluginLoader_LoadSensorPlugin(PluginLoaderState& s, Plugin& plugin, SensorPlugin
 		{
 			// NOTE: fuslogvw is great for debugging managed assembly loading.
 			// TODO: Do we need to try/catch the managed code?
+			AcquireSRWLockExclusive(&s.managedLock);
 			success = (b8) s.lhmPluginLoader->LoadSensorPlugin(&plugin, &sensorPlugin, &pluginDesc);
+			ReleaseSRWLockExclusive(&s.managedLock);
 			LOG_IF(!success, IGNORE,
 				Severity::Error, "Failed to load managed Sensor plugin '%'", plugin.fileName);
 			break;
@@ -374,19 +355,10 @@ PluginLoader_LoadWidgetPlugin(PluginLoaderState& s, Plugin& plugin, WidgetPlugin
 		{
 			success = false;
 
-			// TODO: Will this work with delay loaded dependencies?
-			success = SetDllDirectoryA(plugin.directory.data);
-			LOG_IF(!success, break,
-				Severity::Error, "Failed to set Widget plugin DLL directory '%'", plugin.directory);
-
-			plugin.loaderData = LoadLibraryA(plugin.fileName.data);
-			LOG_IF(!plugin.loaderData, break,
+			plugin.loaderData = LoadNativePlugin(plugin);
+			LOG_LAST_ERROR_IF(!plugin.loaderData, break,
 				Severity::Error, "Failed to load unmanaged Widget plugin '%'", plugin.fileName);
 
-			success = SetDllDirectoryA("");
-			LOG_IF(!success, break,
-				Severity::Error, "Failed to set Widget plugin DLL directory '%'", plugin.directory);
-
 			HMODULE pluginModule = (HMODULE) plugin.loaderData;
 			widgetPlugin.functions.GetPluginInfo = (WidgetPluginFunctions::GetPluginInfoFn*) (void*) GetProcAddress(pluginModule, "GetWidgetPluginInfo");
 			LOG_IF(!widgetPlugin.functions.GetPluginInfo, break,
@@ -402,7 +374,9 @@ PluginLoader_LoadWidgetPlugin(PluginLoaderState& s, Plugin& plugin, WidgetPlugin
 		{
 			// NOTE: fuslogvw is great for debugging managed assembly loading.
 			// TODO: Do we need to try/catch the managed code?
+			AcquireSRWLockExclusive(&s.managedLock);
 			success = (b8) s.lhmPluginLoader->LoadWidgetPlugin(&plugin, &widgetPlugin, &pluginDesc);
+			ReleaseSRWLockExclusive(&s.managedLock);
 			LOG_IF(!success, IGNORE,
 				Severity::Error, "Failed to load managed Widget plugin '%'", plugin.fileName);
 			break;
@@ -56,13 +56,16 @@ b8              Renderer_Render                         (RendererState&);
 void            Renderer_SetRenderSize                  (RendererState&, v2u renderSize);
 b8              Renderer_FinalizeResourceCreation       (RendererState&);
 Mesh            Renderer_CreateMesh                     (RendererState&, StringView name, Slice<Vertex> vertices, Slice<Index> indices);
+VertexShader    Renderer_CreateVertexShader             (RendererState&, StringView name, ByteSlice bytes, Slice<VertexAttribute> attributes, Slice<u32> cBufSizes);
 VertexShader    Renderer_LoadVertexShader               (RendererState&, StringView name, StringView path, Slice<VertexAttribute> attributes, Slice<u32> cBufSizes);
+PixelShader     Renderer_CreatePixelShader              (RendererState&, StringView name, ByteSlice bytes, Slice<u32> cBufSizes);
 PixelShader     Renderer_LoadPixelShader                (RendererState&, StringView name, StringView path, Slice<u32> cBufSizes);
 RenderTarget    Renderer_CreateRenderTarget             (RendererState&, StringView name, b8 resource);
 RenderTarget    Renderer_CreateRenderTargetWithAlpha    (RendererState&, StringView name, b8 resource);
 RenderTarget    Renderer_CreateSharedRenderTarget       (RendererState&, StringView name, b8 resource);
 CPUTexture      Renderer_CreateCPUTexture               (RendererState&, StringView name);
 DepthBuffer     Renderer_CreateDepthBuffer              (RendererState&, StringView name, b8 resource);
+void            Renderer_DestroyPixelShader             (RendererState&, PixelShader);
 
 void            Renderer_SetMarker                      (RendererState&, StringView name);
 void            Renderer_PushEvent                      (RendererState&, StringView name);
@@ -990,8 +990,10 @@ Renderer_CreateMesh(RendererState& s, StringView name, Slice<Vertex> vertices, S
 }
 
 VertexShader
-Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Slice<VertexAttribute> attributes, Slice<u32> cBufSizes)
+Renderer_CreateVertexShader(RendererState& s, StringView name, ByteSlice vsBytes, Slice<VertexAttribute> attributes, Slice<u32> cBufSizes)
 {
+	Assert(!Slice_IsSparse(vsBytes));
+
 	// Vertex Shader
 	VertexShaderData& vs = List_Append(s.vertexShaders);
 	vs.ref = List_GetLastRef(s.vertexShaders);
@@ -1003,19 +1005,11 @@ Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Sl
 
 	vs.name = String_FromView(name);
 
-	// Load
-	Bytes vsBytes = {};
-	defer { List_Free(vsBytes); };
-	{
-		vsBytes = Platform_LoadFileBytes(path);
-		if (!vsBytes.data) return VertexShader::Null;
-	}
-
 	// Create
 	{
 		HRESULT hr = s.d3dDevice->CreateVertexShader(vsBytes.data, vsBytes.length, nullptr, &vs.d3dVertexShader);
 		LOG_HRESULT_IF_FAILED(hr, return VertexShader::Null,
-			Severity::Error, "Failed to create vertex shader '%'", path);
+			Severity::Error, "Failed to create vertex shader '%'", name);
 		SetDebugObjectName(vs.d3dVertexShader, "Vertex Shader: %", name);
 	}
 
@@ -1030,7 +1024,7 @@ Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Sl
 
 			b8 success = CreateConstantBuffer(s, name, i, cBuf);
 			LOG_IF(!success, return VertexShader::Null,
-				Severity::Error, "Failed to create VS constant buffer % for '%'", i, path);
+				Severity::Error, "Failed to create VS constant buffer % for '%'", i, name);
 		}
 	}
 
@@ -1050,7 +1044,7 @@ Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Sl
 				default:
 				case VertexAttributeSemantic::Null:
 				case VertexAttributeSemantic::Count:
-					LOG(Severity::Error, "Unrecognized VS attribute semantic % '%'", (i32) attributes[i].semantic, path);
+					LOG(Severity::Error, "Unrecognized VS attribute semantic % '%'", (i32) attributes[i].semantic, name);
 					return VertexShader::Null;
 			}
 
@@ -1064,7 +1058,7 @@ Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Sl
 				default:
 				case VertexAttributeFormat::Null:
 				case VertexAttributeFormat::Count:
-					LOG(Severity::Error, "Unrecognized VS attribute format % '%'", (i32) attributes[i].format, path);
+					LOG(Severity::Error, "Unrecognized VS attribute format % '%'", (i32) attributes[i].format, name);
 					return VertexShader::Null;
 			}
 
@@ -1081,7 +1075,7 @@ Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Sl
 
 		HRESULT hr = s.d3dDevice->CreateInputLayout(vsInputDescs.data, vsInputDescs.length, vsBytes.data, vsBytes.length, &vs.d3dInputLayout);
 		LOG_HRESULT_IF_FAILED(hr, return VertexShader::Null,
-			Severity::Error, "Failed to create VS input layout '%'", path);
+			Severity::Error, "Failed to create VS input layout '%'", name);
 		SetDebugObjectName(vs.d3dInputLayout, "Input Layout: %", name);
 
 		vs.d3dPrimitveTopology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
@@ -1091,9 +1085,21 @@ Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Sl
 	return vs.ref;
 }
 
+VertexShader
+Renderer_LoadVertexShader(RendererState& s, StringView name, StringView path, Slice<VertexAttribute> attributes, Slice<u32> cBufSizes)
+{
+	ByteSlice vsBytes = Platform_MapFile(path, FileAccess::Sequential, true);
+	defer { Platform_UnmapFile(vsBytes); };
+	if (!vsBytes.data) return VertexShader::Null;
+
+	return Renderer_CreateVertexShader(s, name, vsBytes, attributes, cBufSizes);
+}
+
 PixelShader
-Renderer_LoadPixelShader(RendererState& s, StringView name, StringView path, Slice<u32> cBufSizes)
+Renderer_CreatePixelShader(RendererState& s, StringView name, ByteSlice psBytes, Slice<u32> cBufSizes)
 {
+	Assert(!Slice_IsSparse(psBytes));
+
 	PixelShaderData& ps = List_Append(s.pixelShaders);
 	ps.ref = List_GetLastRef(s.pixelShaders);
 
@@ -1104,19 +1110,11 @@ Renderer_LoadPixelShader(RendererState& s, StringView name, StringView path, Sli
 
 	ps.name = String_FromView(name);
 
-	// Load
-	Bytes psBytes = {};
-	defer { List_Free(psBytes); };
-	{
-		psBytes = Platform_LoadFileBytes(path);
-		if (!psBytes.data) return PixelShader::Null;
-	}
-
 	// Create
 	{
 		HRESULT hr = s.d3dDevice->CreatePixelShader(psBytes.data, (u64) psBytes.length, nullptr, &ps.d3dPixelShader);
 		LOG_HRESULT_IF_FAILED(hr, return PixelShader::Null,
-			Severity::Error, "Failed to create pixel shader '%'", path);
+			Severity::Error, "Failed to create pixel shader '%'", name);
 		SetDebugObjectName(ps.d3dPixelShader, "Pixel Shader: %", name);
 	}
 
@@ -1131,7 +1129,7 @@ Renderer_LoadPixelShader(RendererState& s, StringView name, StringView path, Sli
 
 			b8 success = CreateConstantBuffer(s, name, i, cBuf);
 			LOG_IF(!success, return PixelShader::Null,
-				Severity::Error, "Failed to create PS constant buffer % for '%'", i, path);
+				Severity::Error, "Failed to create PS constant buffer % for '%'", i, name);
 		}
 	}
 
@@ -1139,6 +1137,31 @@ Renderer_LoadPixelShader(RendererState& s, StringView name, StringView path, Sli
 	return ps.ref;
 }
 
+PixelShader
+Renderer_LoadPixelShader(RendererState& s, StringView name, StringView path, Slice<u32> cBufSizes)
+{
+	ByteSlice psBytes = Platform_MapFile(path, FileAccess::Sequential, true);
+	defer { Platform_UnmapFile(psBytes); };
+	if (!psBytes.data) return PixelShader::Null;
+
+	return Renderer_CreatePixelShader(s, name, psBytes, cBufSizes);
+}
+
+// NOTE: The slot is left empty so other pixel shader refs stay valid. Empty slots at the end are
+// reclaimed, which covers the usual case of a plugin reloading the shaders it just created.
+void
+Renderer_DestroyPixelShader(RendererState& s, PixelShader pixelShader)
+{
+	Assert(Renderer_ValidatePixelShader(s, pixelShader));
+	Assert(pixelShader != StandardPixelShader::Null);
+
+	PixelShaderData& ps = s.pixelShaders[pixelShader];
+	DestroyPixelShader(s, ps);
+
+	while (s.pixelShaders.length && !List_GetLast(s.pixelShaders).ref)
+		List_RemoveLast(s.pixelShaders);
+}
+
 b8
 Renderer_FinalizeResourceCreation(RendererState& s)
 {
@@ -1453,7 +1476,7 @@ Renderer_PopVertexShader(RendererState& s)
 b8
 Renderer_ValidatePixelShader(RendererState& s, PixelShader ps)
 {
-	return List_IsRefValid(s.pixelShaders, ps);
+	return List_IsRefValid(s.pixelShaders, ps) && s.pixelShaders[ps].ref == ps;
 }
 
 void
@@ -1628,9 +1651,9 @@ Renderer_GetCPUTextureBytes(RendererState& s, CPUTexture ct)
 	textureBytes.bytes.length = cpuTextureData.mappedResource.DepthPitch;
 	textureBytes.size         = s.renderSize;
 	textureBytes.rowStride    = cpuTextureData.mappedResource.RowPitch;
-	textureBytes.pixelStride  = 2;
+	textureBytes.pixelStride  = 4;
 
-	Assert(s.renderFormat == DXGI_FORMAT_B5G6R5_UNORM);
+	Assert(s.renderFormat == DXGI_FORMAT_B8G8R8A8_UNORM);
 	return textureBytes;
 }
 
@@ -1640,7 +1663,8 @@ Renderer_GetCPUTextureBytes(RendererState& s, CPUTexture ct)
 b8
 Renderer_Initialize(RendererState& s)
 {
-	s.renderFormat     = DXGI_FORMAT_B5G6R5_UNORM;
+	// NOTE: Rendering is done at full precision. The LCD format is produced on the CPU (see Pixels_Convert).
+	s.renderFormat     = DXGI_FORMAT_B8G8R8A8_UNORM;
 	s.sharedFormat     = DXGI_FORMAT_B8G8R8A8_UNORM;
 	s.multisampleCount = 1;
 
@@ -0,0 +1,209 @@
+// NOTE: Shared memory layout used to run a sensor plugin in a separate host process. The simulation
+// creates the table and launches the host. The host loads the plugin, appends sensor descriptions,
+// and writes sensor values after each update. The simulation reads values straight out of the
+// mapping every frame without any syscalls, so a plugin that crashes or stalls only takes down or
+// stalls the host.
+//
+// Descriptions are append-only: a description is fully written before sensorCount is published.
+// Values are grouped into cache line sized blocks, each protected by a sequence lock. The writer
+// makes the sequence odd, writes the values, and makes it even again. A reader that sees an odd
+// sequence, or a different sequence after copying the values, raced the writer and tries again
+// (or keeps the previous values). There's exactly one writer so no locking is needed.
+
+const u32 SensorTableMagic      = 0x53484D4C; // LHMS
+const u32 SensorTableVersion    = 1;
+const u32 SensorBlockValueCount = 15;
+const u32 SensorTableCapacity   = 64 * SensorBlockValueCount;
+const u32 SensorTableReadTries  = 4;
+
+// NOTE: The host beats at least every SensorHostBeatInterval seconds regardless of the plugin's
+// updateInterval. Either side gives up on the other after SensorHostTimeout seconds without a beat.
+const r32 SensorHostBeatInterval = 0.1f;
+const r32 SensorHostTimeout      = 10.0f;
+
+const StringView SensorHostPath = "LCDHardwareMonitor Sensor Host.exe";
+
+enum struct SensorTableState : u32
+{
+	Null,
+	Starting,
+	Ready,
+	Failed,
+};
+
+struct SensorTableDesc
+{
+	c8 name[64];
+	c8 identifier[128];
+	c8 format[32];
+};
+
+struct alignas(64) SensorTableBlock
+{
+	volatile u32 sequence;
+	volatile r32 values[SensorBlockValueCount];
+};
+
+struct alignas(64) SensorTableHeader
+{
+	u32          magic;
+	u32          version;
+	volatile u32 state;
+	volatile u32 quit;
+	volatile u32 sensorCount;
+	volatile u32 hostHeartbeat;
+	volatile u32 simulationHeartbeat;
+	r32          updateInterval;
+	u32          pluginVersion;
+	c8           pluginName[64];
+	c8           pluginAuthor[64];
+};
+
+struct SensorTable
+{
+	SensorTableHeader header;
+	SensorTableDesc   descs[SensorTableCapacity];
+	SensorTableBlock  blocks[SensorTableCapacity / SensorBlockValueCount];
+};
+
+// -------------------------------------------------------------------------------------------------
+// Atomics
+
+// NOTE: x64 doesn't reorder loads with loads or stores with stores, so on MSVC (where volatile
+// accesses are also acquire/release with the default /volatile:ms) only the compiler needs fencing.
+#if _MSC_VER
+	#include <intrin.h>
+	#define SensorTable_Fence() _ReadWriteBarrier()
+#else
+	#define SensorTable_Fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+inline u32
+SensorTable_Load(volatile u32& value)
+{
+	#if _MSC_VER
+	return value;
+	#else
+	return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+	#endif
+}
+
+inline void
+SensorTable_Store(volatile u32& value, u32 newValue)
+{
+	#if _MSC_VER
+	value = newValue;
+	#else
+	__atomic_store_n(&value, newValue, __ATOMIC_RELEASE);
+	#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+// Table
+
+inline void
+SensorTable_CopyText(c8* dst, u32 capacity, StringView src)
+{
+	u32 length = Min(src.length, capacity - 1);
+	memcpy(dst, src.data, length);
+	dst[length] = '\0';
+}
+
+inline void
+SensorTable_Initialize(SensorTable& table)
+{
+	memset(&table, 0, sizeof(SensorTable));
+	table.header.magic   = SensorTableMagic;
+	table.header.version = SensorTableVersion;
+	SensorTable_Store(table.header.state, (u32) SensorTableState::Starting);
+}
+
+inline b8
+SensorTable_IsValid(SensorTable& table)
+{
+	return table.header.magic == SensorTableMagic && table.header.version == SensorTableVersion;
+}
+
+// NOTE: Host only
+inline b8
+SensorTable_AppendDescs(SensorTable& table, Slice<SensorDesc> sensorDescs)
+{
+	u32 count = table.header.sensorCount;
+	if (count + sensorDescs.length > SensorTableCapacity) return false;
+
+	for (u32 i = 0; i < sensorDescs.length; i++)
+	{
+		SensorDesc&      sensorDesc = sensorDescs[i];
+		SensorTableDesc& tableDesc  = table.descs[count + i];
+		SensorTable_CopyText(tableDesc.name,       ArrayLength(tableDesc.name),       sensorDesc.name);
+		SensorTable_CopyText(tableDesc.identifier, ArrayLength(tableDesc.identifier), sensorDesc.identifier);
+		SensorTable_CopyText(tableDesc.format,     ArrayLength(tableDesc.format),     sensorDesc.format);
+	}
+
+	SensorTable_Store(table.header.sensorCount, count + sensorDescs.length);
+	return true;
+}
+
+// NOTE: Host only
+inline void
+SensorTable_WriteValues(SensorTable& table, Slice<r32> sensorValues)
+{
+	u32 count = Min(sensorValues.length, (u32) table.header.sensorCount);
+	for (u32 first = 0; first < count; first += SensorBlockValueCount)
+	{
+		SensorTableBlock& block = table.blocks[first / SensorBlockValueCount];
+		u32 blockCount = Min(count - first, SensorBlockValueCount);
+
+		u32 sequence = block.sequence;
+		SensorTable_Store(block.sequence, sequence + 1);
+		SensorTable_Fence();
+
+		for (u32 i = 0; i < blockCount; i++)
+			block.values[i] = sensorValues[first + i];
+
+		SensorTable_Store(block.sequence, sequence + 2);
+	}
+}
+
+// NOTE: Simulation only. Returns the number of blocks that couldn't be read consistently. Those
+// sensors keep their previous values.
+inline u32
+SensorTable_ReadValues(SensorTable& table, Slice<r32> sensorValues)
+{
+	u32 tornBlocks = 0;
+
+	u32 count = Min(sensorValues.length, SensorTable_Load(table.header.sensorCount));
+	for (u32 first = 0; first < count; first += SensorBlockValueCount)
+	{
+		SensorTableBlock& block = table.blocks[first / SensorBlockValueCount];
+		u32 blockCount = Min(count - first, SensorBlockValueCount);
+
+		r32 values[SensorBlockValueCount];
+		b8 consistent = false;
+		for (u32 tries = 0; tries < SensorTableReadTries && !consistent; tries++)
+		{
+			// NOTE: A zero sequence means the host hasn't written the block yet (e.g. it was just
+			// relaunched). Keep the previous values rather than reading zeros.
+			u32 sequence = SensorTable_Load(block.sequence);
+			if (sequence == 0) break;
+			if (sequence & 1) continue;
+
+			for (u32 i = 0; i < blockCount; i++)
+				values[i] = block.values[i];
+
+			SensorTable_Fence();
+			consistent = block.sequence == sequence;
+		}
+
+		if (!consistent)
+		{
+			tornBlocks += block.sequence != 0;
+			continue;
+		}
+
+		for (u32 i = 0; i < blockCount; i++)
+			sensorValues[first + i] = values[i];
+	}
+
+	return tornBlocks;
+}
@@ -79,6 +79,16 @@ struct HandleTable
 		generation = (generation + 1) % GenerationMask;
 	}
 
+	// NOTE: Unlike Update, existing handles stay valid
+	template <typename T>
+	inline void Relocate(Handle<T> handle, T* pointer)
+	{
+		u32 index = HandleToIndex(handle.value);
+
+		Element& element = elements[index];
+		element.pointer = pointer;
+	}
+
 	template <typename T>
 	inline b8 IsValid(Handle<T> handle)
 	{
@@ -115,6 +125,37 @@ struct OutlineAnimation
 	Outline::PSPerPass   psPerPass;
 };
 
+enum struct FramePhase
+{
+	Null,
+	GUIReceive,
+	GUISend,
+	Sensors,
+	Render,
+	Transmit,
+	Count
+};
+
+struct FramePhaseStats
+{
+	r32 share;
+	i64 deadline;
+	u32 overruns;
+	r32 worstOverrun;
+};
+
+struct FrameBudget
+{
+	r32             targetMilliseconds;
+	r32             reportInterval;
+	i64             frameStart;
+	i64             lastReport;
+	FramePhase      phase;
+	u32             frameOverruns;
+	r32             worstFrame;
+	FramePhaseStats phases[(u32) FramePhase::Count];
+};
+
 struct SimulationState
 {
 	PluginLoaderState*     pluginLoader;
@@ -124,6 +165,8 @@ struct SimulationState
 	List<Plugin>           plugins;
 	List<SensorPlugin>     sensorPlugins;
 	List<WidgetPlugin>     widgetPlugins;
+	List<DirectoryWatch>   pluginWatches;
+	List<String>           pluginChanges;
 
 	v2u                    renderSize;
 	v3                     cameraPos;
@@ -133,7 +176,11 @@ struct SimulationState
 	Matrix                 iview;
 	i64                    startTime;
 	r32                    currentTime;
+	FrameBudget            frameBudget;
+	i64                    sensorLastReport;
 	Handle<Sensor>         nullSensorHandle;
+	HashMap<StringView, Handle<Sensor>> sensorsByIdentifier; // NOTE: Keys point into Sensor::identifier
+	u32                    sensorBindingsVersion; // NOTE: Bumped whenever sensors or sensor plugins move
 
 	// Hardware
 	CPUTexture             renderTargetCPUCopy;
@@ -141,6 +188,11 @@ struct SimulationState
 	ILI9341State*          ili9341;
 	b8                     ft232hInitialized;
 	u32                    ft232hRetryCount;
+	i64                    ft232hLastReport;
+	PixelFormat            lcdPixelFormat; // NOTE: Set by the GUI at any time. Applied before the next frame.
+	Dither                 lcdDither;
+	PixelConverter         lcdConverter;
+	Bytes                  lcdFrame;
 
 	// GUI
 	RenderTarget           renderTargetGUICopy;
@@ -155,6 +207,12 @@ struct SimulationState
 	v2                     cameraRotStart;
 	List<Handle<Widget>>   selected;
 	List<Handle<Widget>>   hovered;
+	r32                    guiSensorInterval;
+	r32                    guiSensorThreshold;
+	i64                    guiSensorLastSend;
+	List<Handle<Sensor>>   guiSensorHandles;
+	List<r32>              guiSensorValues;
+	List<r32>              widgetSensorValues;
 
 	// Post Process
 	RenderTarget           tempRenderTargets[2];
@@ -168,12 +226,22 @@ struct SimulationState
 	Outline::PSPerPass     outlinePSPerPassHovered;
 };
 
+// NOTE: Sensors registered by a plugin that's being initialized on a worker thread. They're copied
+// so the plugin's strings can go away and registered for real on the main thread.
+struct DeferredSensor
+{
+	String name;
+	String identifier;
+	String format;
+};
+
 struct PluginContext
 {
-	SimulationState* s;
-	SensorPlugin*    sensorPlugin;
-	WidgetPlugin*    widgetPlugin;
-	b8               success;
+	SimulationState*      s;
+	SensorPlugin*         sensorPlugin;
+	WidgetPlugin*         widgetPlugin;
+	List<DeferredSensor>* deferredSensors;
+	b8                    success;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -182,30 +250,238 @@ struct PluginContext
 template <typename T>
 static T& ListWithHandles_Append(HandleTable&, List<T>&, u32 = 1);
 static String GetNameFromPath(StringView);
+static void TeardownSensor(Sensor&);
 static void RemoveSensorReferences(SimulationState&, Slice<Handle<Sensor>>);
 static void RemoveWidgetReferences(SimulationState&, Slice<Handle<Widget>>);
 static void RemoveHoverAnimation(SimulationState&, u32);
+static void WatchPluginDirectory(SimulationState&, Plugin&);
+
+// -------------------------------------------------------------------------------------------------
+// Frame Budget
+
+// NOTE: Each frame is split into phases that get a share of the target frame time. Time a phase
+// doesn't use rolls forward to the phases after it, but an overrun never eats into a later phase's
+// own share. Deferrable work (GUI messages, sensor streaming) checks FrameBudget_TimeLeft and
+// carries over to the next frame. Everything else is only measured. Overruns are collected and
+// reported periodically.
+
+static StringView
+FramePhase_Name(FramePhase phase)
+{
+	switch (phase)
+	{
+		default: Assert(false); return "Unknown";
+		case FramePhase::GUIReceive: return "GUI Receive";
+		case FramePhase::GUISend:    return "GUI Send";
+		case FramePhase::Sensors:    return "Sensors";
+		case FramePhase::Render:     return "Render";
+		case FramePhase::Transmit:   return "Transmit";
+	}
+}
+
+static void
+FrameBudget_Initialize(FrameBudget& budget, r32 targetMilliseconds)
+{
+	budget = {};
+	budget.targetMilliseconds = targetMilliseconds;
+	budget.reportInterval     = 5.0f;
+	budget.lastReport         = Platform_GetTicks();
+
+	budget.phases[(u32) FramePhase::GUIReceive].share = 0.10f;
+	budget.phases[(u32) FramePhase::GUISend   ].share = 0.10f;
+	budget.phases[(u32) FramePhase::Sensors   ].share = 0.20f;
+	budget.phases[(u32) FramePhase::Render    ].share = 0.30f;
+	budget.phases[(u32) FramePhase::Transmit  ].share = 0.30f;
+}
+
+static void
+FrameBudget_BeginFrame(FrameBudget& budget)
+{
+	budget.frameStart = Platform_GetTicks();
+	budget.phase      = FramePhase::Null;
+}
+
+static void
+FrameBudget_EndPhase(FrameBudget& budget)
+{
+	if (budget.phase == FramePhase::Null) return;
+
+	i64 currentTicks = Platform_GetTicks();
+	FramePhaseStats& stats = budget.phases[(u32) budget.phase];
+	if (currentTicks > stats.deadline)
+	{
+		r32 overrun = Platform_GetElapsedMilliseconds(stats.deadline, currentTicks);
+		stats.overruns++;
+		stats.worstOverrun = Max(stats.worstOverrun, overrun);
+	}
+
+	budget.phase = FramePhase::Null;
+}
+
+static void
+FrameBudget_BeginPhase(FrameBudget& budget, FramePhase phase)
+{
+	FrameBudget_EndPhase(budget);
+
+	r32 frameShare = 0.0f;
+	for (u32 i = 1; i <= (u32) phase; i++)
+		frameShare += budget.phases[i].share;
+
+	FramePhaseStats& stats = budget.phases[(u32) phase];
+	r32 toSeconds = budget.targetMilliseconds / 1000.0f;
+
+	i64 currentTicks  = Platform_GetTicks();
+	i64 phaseDeadline = currentTicks      + Platform_SecondsToTicks(stats.share * toSeconds);
+	i64 frameDeadline = budget.frameStart + Platform_SecondsToTicks(frameShare  * toSeconds);
+
+	stats.deadline = Max(phaseDeadline, frameDeadline);
+	budget.phase   = phase;
+}
+
+static b8
+FrameBudget_TimeLeft(FrameBudget& budget)
+{
+	Assert(budget.phase != FramePhase::Null);
+	return Platform_GetTicks() < budget.phases[(u32) budget.phase].deadline;
+}
+
+static void
+FrameBudget_EndFrame(FrameBudget& budget)
+{
+	FrameBudget_EndPhase(budget);
+
+	r32 frameTime = Platform_GetElapsedMilliseconds(budget.frameStart);
+	if (frameTime > budget.targetMilliseconds)
+	{
+		budget.frameOverruns++;
+		budget.worstFrame = Max(budget.worstFrame, frameTime);
+	}
+
+	// Report
+	if (Platform_GetElapsedSeconds(budget.lastReport) < budget.reportInterval) return;
+	budget.lastReport = Platform_GetTicks();
+
+	if (budget.frameOverruns != 0)
+	{
+		LOG(Severity::Info, "% frames exceeded % ms in the last % s (worst % ms)",
+			budget.frameOverruns, budget.targetMilliseconds, budget.reportInterval, budget.worstFrame);
+	}
+
+	for (u32 i = 1; i < (u32) FramePhase::Count; i++)
+	{
+		FramePhaseStats& stats = budget.phases[i];
+		if (stats.overruns == 0) continue;
+
+		LOG(Severity::Info, "Frame phase '%' overran % times in the last % s (worst % ms over)",
+			FramePhase_Name((FramePhase) i), stats.overruns, budget.reportInterval, stats.worstOverrun);
+
+		stats.overruns     = 0;
+		stats.worstOverrun = 0.0f;
+	}
+
+	budget.frameOverruns = 0;
+	budget.worstFrame    = 0.0f;
+}
 
 // -------------------------------------------------------------------------------------------------
 // Sensor API
 
+// NOTE: Widgets bound to these read 0
+const SensorBinding NullSensorBinding = { Handle<Sensor>::Null, u32Max, 0 };
+
+static void
+InvalidateSensorBindings(SimulationState& s)
+{
+	s.sensorBindingsVersion++;
+}
+
+static SensorBinding
+ResolveSensorBinding(SimulationState& s, Handle<Sensor> sensorHandle)
+{
+	if (!sensorHandle || !s.handleTable.IsValid(sensorHandle)) return NullSensorBinding;
+
+	Sensor&       sensor       = *s.handleTable[sensorHandle];
+	SensorPlugin& sensorPlugin = *s.handleTable[sensor.sensorPluginHandle];
+
+	SensorBinding result = {};
+	result.sensorHandle      = sensorHandle;
+	result.sensorPluginIndex = List_PointerToIndex(s.sensorPlugins, sensorPlugin);
+	result.valueIndex        = List_PointerToIndex(sensorPlugin.sensors, sensor);
+	return result;
+}
+
+static void
+UpdateSensorText(Sensor& sensor, r32 value)
+{
+	i64 textValue = QuantizeFixed(value, sensor.textFormat.precision);
+	if (sensor.text.data && sensor.textValue == textValue) return;
+
+	sensor.textValue = textValue;
+	String_FormatNumber(sensor.text, sensor.format, sensor.textFormat, textValue);
+}
+
 static void
 RegisterSensors(PluginContext& context, Slice<SensorDesc> sensorDescs)
 {
 	if (!context.success) return;
 
+	if (context.deferredSensors)
+	{
+		for (u32 i = 0; i < sensorDescs.length; i++)
+		{
+			SensorDesc&     desc   = sensorDescs[i];
+			DeferredSensor& sensor = List_Append(*context.deferredSensors);
+			sensor.name       = String_FromView(desc.name);
+			sensor.identifier = String_FromView(desc.identifier);
+			sensor.format     = String_FromView(desc.format);
+		}
+		return;
+	}
+
 	SensorPlugin& sensorPlugin = *context.sensorPlugin;
 
-	List_Grow(sensorPlugin. sensors, sensorDescs.length);
+	List_Grow(sensorPlugin.sensors, sensorDescs.length);
+	List_AppendRange(sensorPlugin.values,      sensorDescs.length);
+	List_AppendRange(sensorPlugin.lastValues,  sensorDescs.length);
+	List_AppendRange(sensorPlugin.changeTicks, sensorDescs.length);
+	List_AppendRange(sensorPlugin.changed,     sensorDescs.length);
 	for (u32 i = 0; i < sensorDescs.length; i++)
 	{
 		SensorDesc& desc = sensorDescs[i];
 
 		Sensor& sensor = ListWithHandles_Append(context.s->handleTable, sensorPlugin.sensors);
-		sensor.name       = String_FromView(desc.name);
-		sensor.identifier = String_FromView(desc.identifier);
-		sensor.format     = String_FromView(desc.format);
+		sensor.name               = String_FromView(desc.name);
+		sensor.identifier         = String_FromView(desc.identifier);
+		sensor.format             = String_FromView(desc.format);
+		sensor.sensorPluginHandle = sensorPlugin.handle;
+		sensor.textFormat         = NumberFormat_Parse(sensor.format);
+
+		if (sensor.textFormat.kind == NumberKind::Null)
+		{
+			LOG(Severity::Warning, "Unsupported sensor format '%' from plugin '%'", sensor.format, sensorPlugin.name);
+			sensor.textFormat.kind        = NumberKind::Fixed;
+			sensor.textFormat.precision   = 2;
+			sensor.textFormat.suffixIndex = sensor.format.length;
+		}
+
+		UpdateSensorText(sensor, 0.0f);
 	}
+
+	Slice<Sensor> newSensors = List_Slice(sensorPlugin.sensors, sensorPlugin.sensors.length - sensorDescs.length);
+	u32 added = HashMap_SetRange(context.s->sensorsByIdentifier,
+		Slice_MemberSlice(newSensors, &Sensor::identifier),
+		Slice_MemberSlice(newSensors, &Sensor::handle));
+	LOG_IF(added != sensorDescs.length, IGNORE,
+		Severity::Warning, "Sensor plugin '%' registered % sensors with identifiers that are already in use",
+		sensorPlugin.name, sensorDescs.length - added);
+}
+
+// NOTE: Identifiers are stable across runs, handles aren't
+static Handle<Sensor>
+FindSensor(SimulationState& s, StringView identifier)
+{
+	Handle<Sensor>* sensorHandle = HashMap_Find(s.sensorsByIdentifier, identifier);
+	return sensorHandle ? *sensorHandle : Handle<Sensor>::Null;
 }
 
 static void
@@ -231,19 +507,344 @@ UnregisterSensors(PluginContext& context, Slice<Handle<Sensor>> sensorHandles)
 		Handle<Sensor> sensorHandle = sensorHandles[i];
 		Sensor&        sensor       = *context.s->handleTable[sensorHandle];
 
+		TeardownSensor(sensor);
+		context.s->handleTable.Remove(sensorHandle);
+
 		u32 sensorIndex = List_PointerToIndex(sensorPlugin.sensors, sensor);
-		List_RemoveFast(sensorPlugin.sensors, sensorIndex);
+		List_RemoveFast(sensorPlugin.sensors,     sensorIndex);
+		List_RemoveFast(sensorPlugin.values,      sensorIndex);
+		List_RemoveFast(sensorPlugin.lastValues,  sensorIndex);
+		List_RemoveFast(sensorPlugin.changeTicks, sensorIndex);
+		List_RemoveFast(sensorPlugin.changed,     sensorIndex);
 
-		if (sensorPlugin.sensors.length)
+		if (sensorIndex < sensorPlugin.sensors.length)
 		{
 			Sensor& movedSensor = sensorPlugin.sensors[sensorIndex];
-			context.s->handleTable.Update(movedSensor.handle, &movedSensor);
+			context.s->handleTable.Relocate(movedSensor.handle, &movedSensor);
 		}
 	}
+	InvalidateSensorBindings(*context.s);
 
 	context.success = true;
 }
 
+// NOTE: Runs after each plugin update. The first pass only touches the hot columns and is written
+// without branches so it vectorizes. Text is only rebuilt for sensors that actually changed.
+static void
+CommitSensorValues(SensorPlugin& sensorPlugin, i64 ticks)
+{
+	r32* values      = sensorPlugin.values.data;
+	r32* lastValues  = sensorPlugin.lastValues.data;
+	i64* changeTicks = sensorPlugin.changeTicks.data;
+	b8*  changed     = sensorPlugin.changed.data;
+
+	u32 count = sensorPlugin.values.length;
+	for (u32 i = 0; i < count; i++)
+	{
+		// NOTE: A sensor that stays NaN hasn't changed. x == x is false only for NaN and, unlike
+		// isnan, keeps the loop vectorizable.
+		b8 bothNaN   = !(values[i] == values[i]) & !(lastValues[i] == lastValues[i]);
+		b8 isChanged = (values[i] != lastValues[i]) & !bothNaN;
+		changed[i]     = isChanged;
+		changeTicks[i] = isChanged ? ticks : changeTicks[i];
+		lastValues[i]  = values[i];
+	}
+
+	for (u32 i = 0; i < count; i++)
+	{
+		if (!changed[i]) continue;
+		UpdateSensorText(sensorPlugin.sensors[i], values[i]);
+	}
+}
+
+// -------------------------------------------------------------------------------------------------
+// Sensor Scheduling
+
+// NOTE: Sensor plugins are updated at their own updateInterval instead of every frame. Updates only
+// happen on frame boundaries so an update can start up to a frame late; that's tracked as jitter.
+// Deadlines advance by whole intervals so jitter doesn't accumulate. An update that finishes after
+// its next deadline has already passed is an overrun and the schedule restarts from the end of that
+// update. There are only ever a handful of sensor plugins so a linear scan of deadlines is enough.
+
+static void
+SensorSchedule_Update(SimulationState& s)
+{
+	PluginContext context = {};
+	context.s = &s;
+
+	SensorPluginAPI::Update api = {};
+	api.RegisterSensors   = RegisterSensors;
+	api.UnregisterSensors = UnregisterSensors;
+
+	for (u32 i = 0; i < s.sensorPlugins.length; i++)
+	{
+		SensorPlugin&         sensorPlugin = s.sensorPlugins[i];
+		SensorPluginSchedule& schedule     = sensorPlugin.schedule;
+		if (!sensorPlugin.functions.Update) continue;
+
+		i64 startTicks = Platform_GetTicks();
+		if (startTicks < schedule.nextUpdate) continue;
+
+		// TODO: try/catch?
+		context.sensorPlugin = &sensorPlugin;
+		context.success      = true;
+
+		api.sensors = sensorPlugin.sensors;
+		api.values  = sensorPlugin.values;
+		sensorPlugin.functions.Update(context, api);
+
+		i64 endTicks = Platform_GetTicks();
+		CommitSensorValues(sensorPlugin, endTicks);
+
+		schedule.updates++;
+		schedule.worstDuration = Max(schedule.worstDuration, Platform_GetElapsedMilliseconds(startTicks, endTicks));
+
+		r32 interval = sensorPlugin.functions.updateInterval;
+		if (interval <= 0.0f) continue;
+
+		// NOTE: The first update doesn't have a deadline to be late for
+		i64 intervalTicks = Platform_SecondsToTicks(interval);
+		if (schedule.nextUpdate != 0)
+		{
+			r32 jitter = Platform_GetElapsedMilliseconds(schedule.nextUpdate, startTicks);
+			schedule.worstJitter = Max(schedule.worstJitter, jitter);
+			schedule.nextUpdate += intervalTicks;
+		}
+		else
+		{
+			schedule.nextUpdate = startTicks + intervalTicks;
+		}
+
+		if (schedule.nextUpdate <= endTicks)
+		{
+			schedule.overruns++;
+			schedule.nextUpdate = endTicks + intervalTicks;
+		}
+	}
+}
+
+static void
+SensorSchedule_Report(SimulationState& s)
+{
+	if (Platform_GetElapsedSeconds(s.sensorLastReport) < s.frameBudget.reportInterval) return;
+	s.sensorLastReport = Platform_GetTicks();
+
+	for (u32 i = 0; i < s.sensorPlugins.length; i++)
+	{
+		SensorPlugin&         sensorPlugin = s.sensorPlugins[i];
+		SensorPluginSchedule& schedule     = sensorPlugin.schedule;
+
+		if (schedule.overruns != 0)
+		{
+			LOG(Severity::Info, "Sensor plugin '%' overran its % s interval % times in % updates (worst update % ms, worst jitter % ms)",
+				sensorPlugin.name, sensorPlugin.functions.updateInterval, schedule.overruns, schedule.updates,
+				schedule.worstDuration, schedule.worstJitter);
+		}
+
+		schedule.updates       = 0;
+		schedule.overruns      = 0;
+		schedule.worstJitter   = 0.0f;
+		schedule.worstDuration = 0.0f;
+	}
+}
+
+// -------------------------------------------------------------------------------------------------
+// Sensor Hosts
+
+// NOTE: Out of process sensor plugins are run by a separate host process (main_sensorhost_win32.cpp)
+// and show up here as a regular SensorPlugin whose functions read from the shared sensor table (see
+// sensor_table.hpp). Reading values is just loads from the mapping. The host is only checked on when
+// its heartbeat stops: a host that exited or stopped beating is killed and relaunched. A relaunched
+// plugin is expected to register its sensors in the same order, so existing sensors (and the widgets
+// using them) carry on and only sensors beyond the previous count are added.
+
+struct SensorHost
+{
+	SharedMemory     memory;
+	SensorTable*     table;
+	Process          process;
+	u32              sensorCount;
+	List<SensorDesc> sensorDescs;
+	u32              hostHeartbeat;
+	i64              hostLastBeat;
+	i64              lastLaunch;
+};
+
+const r32 SensorHostLaunchTimeout = 5.0f;
+const r32 SensorHostQuitTimeout   = 1.0f;
+const r32 SensorHostCheckInterval = 1.0f;
+const r32 SensorHostRelaunchDelay = 5.0f;
+
+static SensorHost&
+SensorHost_Get(PluginContext& context)
+{
+	Plugin& plugin = *context.s->handleTable[context.sensorPlugin->pluginHandle];
+	return *(SensorHost*) plugin.loaderData;
+}
+
+static b8
+SensorHost_Launch(SensorHost& host, Plugin& plugin)
+{
+	SensorTable_Initialize(*host.table);
+	host.hostHeartbeat = 0;
+	host.hostLastBeat  = Platform_GetTicks();
+	host.lastLaunch    = Platform_GetTicks();
+
+	StringView args[] = { plugin.directory, plugin.fileName, host.memory.name };
+	b8 success = Platform_LaunchProcess(SensorHostPath, args, host.process);
+	LOG_IF(!success, return false,
+		Severity::Error, "Failed to launch sensor host for '%'", plugin.fileName);
+
+	return true;
+}
+
+static void
+SensorHost_RegisterSensors(SensorHost& host, PluginContext& context, SensorPluginAPI::Update::RegisterSensorsFn* registerSensors)
+{
+	SensorTable& table = *host.table;
+
+	u32 sensorCount = Min(SensorTable_Load(table.header.sensorCount), SensorTableCapacity);
+	if (sensorCount <= host.sensorCount) return;
+
+	List_Clear(host.sensorDescs);
+	for (u32 i = host.sensorCount; i < sensorCount; i++)
+	{
+		SensorTableDesc& tableDesc  = table.descs[i];
+		SensorDesc&      sensorDesc = List_Append(host.sensorDescs);
+		sensorDesc.name       = String_ViewCString(tableDesc.name);
+		sensorDesc.identifier = String_ViewCString(tableDesc.identifier);
+		sensorDesc.format     = String_ViewCString(tableDesc.format);
+	}
+
+	registerSensors(context, host.sensorDescs);
+	host.sensorCount = sensorCount;
+}
+
+static b8
+SensorHost_Initialize(PluginContext& context, SensorPluginAPI::Initialize api)
+{
+	SensorHost& host = SensorHost_Get(context);
+	SensorHost_RegisterSensors(host, context, api.RegisterSensors);
+	SensorTable_ReadValues(*host.table, context.sensorPlugin->values);
+	return true;
+}
+
+static void
+SensorHost_Update(PluginContext& context, SensorPluginAPI::Update api)
+{
+	SensorHost&  host  = SensorHost_Get(context);
+	SensorTable& table = *host.table;
+
+	SensorTable_Store(table.header.simulationHeartbeat, table.header.simulationHeartbeat + 1);
+
+	// NOTE: Registering can grow the value column, so api.values isn't used
+	SensorHost_RegisterSensors(host, context, api.RegisterSensors);
+	SensorTable_ReadValues(table, context.sensorPlugin->values);
+
+	u32 hostHeartbeat = SensorTable_Load(table.header.hostHeartbeat);
+	if (hostHeartbeat != host.hostHeartbeat)
+	{
+		host.hostHeartbeat = hostHeartbeat;
+		host.hostLastBeat  = Platform_GetTicks();
+		return;
+	}
+
+	r32 silence = Platform_GetElapsedSeconds(host.hostLastBeat);
+	if (silence < SensorHostCheckInterval) return;
+	if (Platform_GetElapsedSeconds(host.lastLaunch) < SensorHostRelaunchDelay) return;
+
+	b8 running = Platform_IsProcessRunning(host.process);
+	if (running && silence < SensorHostTimeout) return;
+
+	Plugin& plugin = *context.s->handleTable[context.sensorPlugin->pluginHandle];
+	if (running)
+		LOG(Severity::Warning, "Sensor host for '%' stopped responding. Relaunching.", plugin.info.name);
+	else
+		LOG(Severity::Warning, "Sensor host for '%' exited. Relaunching.", plugin.info.name);
+
+	Platform_TerminateProcess(host.process);
+	Platform_DestroyProcess(host.process);
+	SensorHost_Launch(host, plugin);
+}
+
+static b8
+SensorHost_Unload(Plugin& plugin)
+{
+	SensorHost* host = (SensorHost*) plugin.loaderData;
+	if (host)
+	{
+		// NOTE: Give the host a chance to exit cleanly so the plugin's Teardown runs
+		if (host->table)
+		{
+			SensorTable_Store(host->table->header.quit, true);
+
+			i64 quitStart = Platform_GetTicks();
+			while (Platform_IsProcessRunning(host->process) && Platform_GetElapsedSeconds(quitStart) < SensorHostQuitTimeout)
+				Platform_Sleep(1);
+		}
+
+		Platform_TerminateProcess(host->process);
+		Platform_DestroyProcess(host->process);
+		Platform_DestroySharedMemory(host->memory);
+		List_Free(host->sensorDescs);
+		Free(host);
+	}
+
+	plugin.loaderData = nullptr;
+	plugin.loadState  = PluginLoadState::Unloaded;
+	return true;
+}
+
+static b8
+SensorHost_Load(Plugin& plugin, SensorPlugin& sensorPlugin)
+{
+	auto pluginGuard = guard { plugin.loadState = PluginLoadState::Broken; };
+
+	SensorHost* host = (SensorHost*) AllocChecked(sizeof(SensorHost));
+	*host = {};
+	plugin.loaderData = host;
+	auto hostGuard = guard { SensorHost_Unload(plugin); };
+
+	String tableName = String_Format("LCDHardwareMonitor Sensor Table %", plugin.handle.value);
+	defer { String_Free(tableName); };
+
+	b8 success = Platform_CreateSharedMemory(tableName, sizeof(SensorTable), host->memory);
+	LOG_IF(!success, return false,
+		Severity::Error, "Failed to create sensor table for '%'", plugin.fileName);
+	host->table = (SensorTable*) host->memory.data;
+
+	success = SensorHost_Launch(*host, plugin);
+	if (!success) return false;
+
+	// NOTE: Wait for the plugin to load so failures are reported the same way as in process plugins
+	SensorTable& table = *host->table;
+	while (SensorTable_Load(table.header.state) == (u32) SensorTableState::Starting)
+	{
+		LOG_IF(!Platform_IsProcessRunning(host->process), return false,
+			Severity::Error, "Sensor host for '%' exited while loading", plugin.fileName);
+		LOG_IF(Platform_GetElapsedSeconds(host->lastLaunch) > SensorHostLaunchTimeout, return false,
+			Severity::Error, "Sensor host for '%' timed out while loading", plugin.fileName);
+		Platform_Sleep(1);
+	}
+	LOG_IF(SensorTable_Load(table.header.state) != (u32) SensorTableState::Ready, return false,
+		Severity::Error, "Sensor host failed to load '%'", plugin.fileName);
+
+	plugin.loadState       = PluginLoadState::Loaded;
+	plugin.info.name       = String_FromView(String_ViewCString(table.header.pluginName));
+	plugin.info.author     = String_FromView(String_ViewCString(table.header.pluginAuthor));
+	plugin.info.version    = table.header.pluginVersion;
+	plugin.info.lhmVersion = LHMVersion;
+
+	// NOTE: Reading the table is cheap and the host paces the plugin, so check it every frame
+	sensorPlugin.functions.Initialize     = SensorHost_Initialize;
+	sensorPlugin.functions.Update         = SensorHost_Update;
+	sensorPlugin.functions.updateInterval = 0.0f;
+
+	hostGuard.dismiss   = true;
+	pluginGuard.dismiss = true;
+	return true;
+}
+
 // -------------------------------------------------------------------------------------------------
 // Widget API
 
@@ -270,6 +871,8 @@ RegisterWidgetTypes(PluginContext& context, Slice<WidgetDesc> widgetDescs)
 
 		List_Reserve(widgetType.widgets, 8);
 		List_Reserve(widgetType.widgetsUserData, 8 * widgetDesc.userDataSize);
+		List_Reserve(widgetType.wvps, 8);
+		widgetType.wvpsDirty = true;
 	}
 }
 
@@ -291,6 +894,7 @@ LoadPixelShader(PluginContext& context, StringView relPath, Slice<u32> cBufSizes
 	PixelShader ps = Renderer_LoadPixelShader(rendererState, psName, path, cBufSizes);
 	LOG_IF(!ps, return PixelShader::Null,
 		Severity::Error, "Failed to load pixel shader '%'", path);
+	List_Append(context.widgetPlugin->pixelShaders, ps);
 
 	context.success = true;
 	return ps;
@@ -307,9 +911,75 @@ GetSensor(PluginContext& context, Handle<Sensor> sensorHandle)
 	LOG_IF(!context.s->handleTable.IsValid(sensorHandle), return nullptr,
 		Severity::Warning, "Attempting to get an invalid sensor from plugin '%'", widgetPlugin.name);
 
-	Sensor& sensor = *context.s->handleTable[sensorHandle];
-	context.success = true;
-	return &sensor;
+	Sensor& sensor = *context.s->handleTable[sensorHandle];
+	context.success = true;
+	return &sensor;
+}
+
+// NOTE: Bindings are resolved when sensors move and when a widget's sensor changes. Otherwise this
+// only compares handles and reads values. The returned slice is only valid until the next call.
+static Slice<r32>
+GatherSensorValues(SimulationState& s, WidgetType& widgetType, u32 first, u32 count)
+{
+	List<SensorBinding>& bindings = widgetType.sensorBindings;
+	if (widgetType.sensorBindingsVersion != s.sensorBindingsVersion || bindings.length != widgetType.widgets.length)
+	{
+		bindings.length = 0;
+		List_AppendRange(bindings, widgetType.widgets.length);
+
+		for (u32 i = 0; i < widgetType.widgets.length; i++)
+			bindings[i] = ResolveSensorBinding(s, widgetType.widgets[i].sensorHandle);
+
+		widgetType.sensorBindingsVersion = s.sensorBindingsVersion;
+	}
+
+	s.widgetSensorValues.length = 0;
+	List_AppendRange(s.widgetSensorValues, count);
+
+	for (u32 i = 0; i < count; i++)
+	{
+		Handle<Sensor> sensorHandle = widgetType.widgets[first + i].sensorHandle;
+		SensorBinding& binding      = bindings[first + i];
+		if (binding.sensorHandle != sensorHandle)
+			binding = ResolveSensorBinding(s, sensorHandle);
+
+		s.widgetSensorValues[i] = binding.sensorPluginIndex == u32Max
+			? 0.0f
+			: s.sensorPlugins[binding.sensorPluginIndex].values[binding.valueIndex];
+	}
+
+	return s.widgetSensorValues;
+}
+
+// NOTE: World matrices only depend on the widget and the view projection only changes with the
+// camera, so the products are rebuilt in one batch when either changes and reused otherwise.
+static Slice<Matrix>
+GatherWidgetTransforms(SimulationState& s, WidgetType& widgetType)
+{
+	if (widgetType.wvpsDirty || widgetType.wvps.length != widgetType.widgets.length)
+	{
+		widgetType.wvps.length = 0;
+		List_AppendRange(widgetType.wvps, widgetType.widgets.length);
+
+		for (u32 i = 0; i < widgetType.widgets.length; i++)
+			widgetType.wvps[i] = WidgetWorldMatrix(widgetType.widgets[i]);
+
+		MultiplyBatch(widgetType.wvps.data, widgetType.wvps.data, s.vp, widgetType.wvps.length);
+		widgetType.wvpsDirty = false;
+	}
+
+	return widgetType.wvps;
+}
+
+static void
+InvalidateWidgetTransforms(SimulationState& s)
+{
+	for (u32 i = 0; i < s.widgetPlugins.length; i++)
+	{
+		WidgetPlugin& widgetPlugin = s.widgetPlugins[i];
+		for (u32 j = 0; j < widgetPlugin.widgetTypes.length; j++)
+			widgetPlugin.widgetTypes[j].wvpsDirty = true;
+	}
 }
 
 static Matrix
@@ -455,16 +1125,22 @@ PopPixelShader(PluginContext& context)
 // NOTE: None of these functions return error codes because the messaging system handles errors
 // internally. It will disconnect and stop attempting to send messages when a failure occurs.
 
+// NOTE: Seconds between sensor value batches and the change a value needs to be sent again
+const r32 GUISensorInterval  = 0.25f;
+const r32 GUISensorThreshold = 0.0f;
+
 static void
 ToGUI_Connect(SimulationState& s)
 {
 	if (s.guiConnection.pipe.state != PipeState::Connected) return;
 
 	ToGUI::Connect connect = {};
-	connect.version       = LHMVersion;
-	connect.renderSurface = Renderer_GetSharedRenderTargetHandle(*s.renderer, s.renderTargetGUICopy);
-	connect.renderSize.x  = s.renderSize.x;
-	connect.renderSize.y  = s.renderSize.y;
+	connect.version        = LHMVersion;
+	connect.renderSurface  = Renderer_GetSharedRenderTargetHandle(*s.renderer, s.renderTargetGUICopy);
+	connect.renderSize.x   = s.renderSize.x;
+	connect.renderSize.y   = s.renderSize.y;
+	connect.lcdPixelFormat = s.lcdPixelFormat;
+	connect.lcdDither      = s.lcdDither;
 	SerializeAndQueueMessage(s.guiConnection, connect);
 }
 
@@ -495,15 +1171,56 @@ ToGUI_PluginStatesChanged(SimulationState& s, Slice<Plugin> plugins)
 }
 
 static void
-ToGUI_SensorsAdded(SimulationState& s, Slice<Sensor> sensors)
+ToGUI_SensorsAdded(SimulationState& s, Slice<Sensor> sensors, Slice<r32> values)
 {
 	if (s.guiConnection.pipe.state != PipeState::Connected) return;
 
 	ToGUI::SensorsAdded sensorsAdded = {};
 	sensorsAdded.sensors = sensors;
+	sensorsAdded.values  = values;
 	SerializeAndQueueMessage(s.guiConnection, sensorsAdded);
 }
 
+// NOTE: Batched to guiSensorInterval. Sensors are only sent when they've moved more than
+// guiSensorThreshold since they were last sent. Sensors that haven't changed since the last send
+// are skipped using only the changeTicks column.
+static void
+ToGUI_SensorValuesChanged(SimulationState& s)
+{
+	if (s.guiConnection.pipe.state != PipeState::Connected) return;
+	if (Platform_GetElapsedSeconds(s.guiSensorLastSend) < s.guiSensorInterval) return;
+	i64 lastSend = s.guiSensorLastSend;
+	s.guiSensorLastSend = Platform_GetTicks();
+
+	s.guiSensorHandles.length = 0;
+	s.guiSensorValues.length  = 0;
+
+	for (u32 i = 0; i < s.sensorPlugins.length; i++)
+	{
+		SensorPlugin& sensorPlugin = s.sensorPlugins[i];
+		for (u32 j = 0; j < sensorPlugin.sensors.length; j++)
+		{
+			if (sensorPlugin.changeTicks[j] <= lastSend) continue;
+
+			Sensor& sensor = sensorPlugin.sensors[j];
+			r32     value  = sensorPlugin.values[j];
+			// NOTE: NaN - NaN is NaN, which would send a sensor that stays NaN every time
+			b8 bothNaN = isnan(value) && isnan(sensor.guiValue);
+			if (bothNaN || fabsf(value - sensor.guiValue) <= s.guiSensorThreshold) continue;
+
+			sensor.guiValue = value;
+			List_Append(s.guiSensorHandles, sensor.handle);
+			List_Append(s.guiSensorValues, value);
+		}
+	}
+	if (s.guiSensorHandles.length == 0) return;
+
+	ToGUI::SensorValuesChanged valuesChanged = {};
+	valuesChanged.handles = s.guiSensorHandles;
+	valuesChanged.values  = s.guiSensorValues;
+	SerializeAndQueueMessage(s.guiConnection, valuesChanged);
+}
+
 static void
 ToGUI_WidgetTypesAdded(SimulationState& s, Slice<WidgetType> widgetTypes)
 {
@@ -532,7 +1249,7 @@ ToGUI_WidgetSelectionChanged(SimulationState& s, Slice<Handle<Widget>> widgetHan
 
 	ToGUI::WidgetSelectionChanged widgetSelection = {};
 	widgetSelection.handles = widgetHandles;
-	SerializeAndQueueMessage(s.guiConnection, widgetSelection);
+	SerializeAndReplaceMessage(s.guiConnection, widgetSelection);
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -548,8 +1265,12 @@ OnConnect(SimulationState& s)
 	for (u32 i = 0; i < s.sensorPlugins.length; i++)
 	{
 		SensorPlugin& sensorPlugin = s.sensorPlugins[i];
-		ToGUI_SensorsAdded(s, sensorPlugin.sensors);
+		ToGUI_SensorsAdded(s, sensorPlugin.sensors, sensorPlugin.values);
+
+		for (u32 j = 0; j < sensorPlugin.sensors.length; j++)
+			sensorPlugin.sensors[j].guiValue = sensorPlugin.values[j];
 	}
+	s.guiSensorLastSend = Platform_GetTicks();
 
 	for (u32 i = 0; i < s.widgetPlugins.length; i++)
 	{
@@ -581,6 +1302,7 @@ OnTeardown(ConnectionState& con)
 
 	ToGUI::Disconnect disconnect = {};
 	disconnect.header.id    = IdOf<ToGUI::Disconnect>;
+	disconnect.header.type  = MessageTypeOf<ToGUI::Disconnect>;
 	disconnect.header.index = con.sendIndex - (con.queue.length - con.queueIndex);
 	disconnect.header.size  = sizeof(ToGUI::Disconnect);
 
@@ -640,6 +1362,7 @@ TeardownSensor(Sensor& sensor)
 	String_Free(sensor.name);
 	String_Free(sensor.identifier);
 	String_Free(sensor.format);
+	String_Free(sensor.text);
 }
 
 static void
@@ -651,59 +1374,98 @@ TeardownSensorPlugin(SensorPlugin& sensorPlugin)
 		TeardownSensor(sensor);
 	}
 	List_Free(sensorPlugin.sensors);
+	List_Free(sensorPlugin.values);
+	List_Free(sensorPlugin.lastValues);
+	List_Free(sensorPlugin.changeTicks);
+	List_Free(sensorPlugin.changed);
 }
 
-static Result<SensorPlugin*>
-LoadSensorPlugin(SimulationState& s, Plugin& plugin, SensorPluginFunctions::GetPluginInfoFn* getPluginInfo = nullptr)
+static SensorPlugin&
+AddSensorPlugin(SimulationState& s, Plugin& plugin, SensorPluginFunctions::GetPluginInfoFn* getPluginInfo)
 {
-	Assert(plugin.loadState != PluginLoadState::Loaded);
-
 	SensorPlugin& sensorPlugin = ListWithHandles_Append(s.handleTable, s.sensorPlugins);
 	sensorPlugin.pluginHandle            = plugin.handle;
 	sensorPlugin.functions.GetPluginInfo = getPluginInfo;
 	// TODO: Leak on failure?
-	List_Reserve(sensorPlugin.sensors, 32);
-
-	defer { ToGUI_PluginStatesChanged(s, plugin); };
-	auto pluginGuard = guard
-	{
-		plugin.loadState = PluginLoadState::Broken;
-		List_RemoveLast(s.sensorPlugins);
-	};
+	List_Reserve(sensorPlugin.sensors,     32);
+	List_Reserve(sensorPlugin.values,      32);
+	List_Reserve(sensorPlugin.lastValues,  32);
+	List_Reserve(sensorPlugin.changeTicks, 32);
+	List_Reserve(sensorPlugin.changed,     32);
 
 	plugin.kind = PluginKind::Sensor;
+	return sensorPlugin;
+}
 
+// NOTE: Only touches the plugin and sensor plugin so it can run on a worker thread
+static b8
+LoadSensorPluginLibrary(PluginLoaderState& pluginLoader, Plugin& plugin, SensorPlugin& sensorPlugin)
+{
 	// NOTE: We keep the name and author around for display purposes when a plugin is unloaded. If it
 	// gets loaded again we need to be sure we free the old strings properly.
 	String_Free(plugin.info.name);
 	String_Free(plugin.info.author);
 
-	b8 success = PluginLoader_LoadSensorPlugin(*s.pluginLoader, plugin, sensorPlugin);
+	b8 success = plugin.outOfProcess
+		? SensorHost_Load(plugin, sensorPlugin)
+		: PluginLoader_LoadSensorPlugin(pluginLoader, plugin, sensorPlugin);
 	LOG_IF(!success, return false,
 		Severity::Error, "Failed to load Sensor plugin '%'", plugin.fileName);
 
 	sensorPlugin.name = plugin.info.name;
+	return true;
+}
 
+// NOTE: With deferredSensors set, sensors aren't registered and only the sensor plugin is touched, so
+// it can run on a worker thread.
+static b8
+InitializeSensorPlugin(SimulationState& s, SensorPlugin& sensorPlugin, List<DeferredSensor>* deferredSensors = nullptr)
+{
 	// TODO: try/catch?
-	if (sensorPlugin.functions.Initialize)
+	if (!sensorPlugin.functions.Initialize) return true;
+
+	PluginContext context = {};
+	context.s               = &s;
+	context.sensorPlugin    = &sensorPlugin;
+	context.deferredSensors = deferredSensors;
+	context.success         = true;
+
+	SensorPluginAPI::Initialize api = {};
+	api.RegisterSensors = RegisterSensors;
+
+	b8 success = sensorPlugin.functions.Initialize(context, api);
+	success &= context.success;
+	LOG_IF(!success, return false,
+		Severity::Error, "Failed to initialize Sensor plugin '%'", sensorPlugin.name);
+
+	return true;
+}
+
+static Result<SensorPlugin*>
+LoadSensorPlugin(SimulationState& s, Plugin& plugin, SensorPluginFunctions::GetPluginInfoFn* getPluginInfo = nullptr)
+{
+	Assert(plugin.loadState != PluginLoadState::Loaded);
+
+	SensorPlugin& sensorPlugin = AddSensorPlugin(s, plugin, getPluginInfo);
+
+	defer { ToGUI_PluginStatesChanged(s, plugin); };
+	auto pluginGuard = guard
 	{
-		PluginContext context = {};
-		context.s            = &s;
-		context.sensorPlugin = &sensorPlugin;
-		context.success      = true;
+		plugin.loadState = PluginLoadState::Broken;
+		List_RemoveLast(s.sensorPlugins);
+		InvalidateSensorBindings(s);
+	};
 
-		SensorPluginAPI::Initialize api = {};
-		api.RegisterSensors = RegisterSensors;
+	b8 success = LoadSensorPluginLibrary(*s.pluginLoader, plugin, sensorPlugin);
+	if (!success) return false;
 
-		success = sensorPlugin.functions.Initialize(context, api);
-		success &= context.success;
-		if (!success)
-		{
-			LOG(Severity::Error, "Failed to initialize Sensor plugin '%'", plugin.info.name);
-			// Remove all sensors so they don't get used
-			TeardownSensorPlugin(sensorPlugin);
-			return false;
-		}
+	success = InitializeSensorPlugin(s, sensorPlugin);
+	if (!success)
+	{
+		// Remove all sensors so they don't get used
+		RemoveSensorReferences(s, List_MemberSlice(sensorPlugin.sensors, &Sensor::handle));
+		TeardownSensorPlugin(sensorPlugin);
+		return false;
 	}
 
 	pluginGuard.dismiss = true;
@@ -736,7 +1498,9 @@ UnloadSensorPlugin(SimulationState& s, SensorPlugin& sensorPlugin)
 	RemoveSensorReferences(s, List_MemberSlice(sensorPlugin.sensors, &Sensor::handle));
 	TeardownSensorPlugin(sensorPlugin);
 
-	b8 success = PluginLoader_UnloadSensorPlugin(*s.pluginLoader, plugin, sensorPlugin);
+	b8 success = plugin.outOfProcess
+		? SensorHost_Unload(plugin)
+		: PluginLoader_UnloadSensorPlugin(*s.pluginLoader, plugin, sensorPlugin);
 	LOG_IF(!success, return false,
 		Severity::Error, "Failed to unload Sensor plugin '%'", plugin.info.name);
 
@@ -752,10 +1516,22 @@ TeardownWidgetType(WidgetType& widgetType)
 {
 	List_Free(widgetType.widgets);
 	List_Free(widgetType.widgetsUserData);
+	List_Free(widgetType.wvps);
+	List_Free(widgetType.sensorBindings);
+}
+
+// NOTE: Must run before the library that loaded the shaders is unloaded
+static void
+DestroyWidgetPluginShaders(SimulationState& s, WidgetPlugin& widgetPlugin)
+{
+	// NOTE: Reverse order so the renderer can reclaim the slots
+	for (i32 i = (i32) widgetPlugin.pixelShaders.length - 1; i >= 0; i--)
+		Renderer_DestroyPixelShader(*s.renderer, widgetPlugin.pixelShaders[(u32) i]);
+	List_Free(widgetPlugin.pixelShaders);
 }
 
 static void
-TeardownWidgetPlugin(WidgetPlugin& widgetPlugin)
+TeardownWidgetPlugin(SimulationState& s, WidgetPlugin& widgetPlugin)
 {
 	for (u32 i = 0; i < widgetPlugin.widgetTypes.length; i++)
 	{
@@ -763,59 +1539,87 @@ TeardownWidgetPlugin(WidgetPlugin& widgetPlugin)
 		TeardownWidgetType(widgetType);
 	}
 	List_Free(widgetPlugin.widgetTypes);
+	DestroyWidgetPluginShaders(s, widgetPlugin);
 }
 
-static Result<WidgetPlugin*>
-LoadWidgetPlugin(SimulationState& s, Plugin& plugin)
+static WidgetPlugin&
+AddWidgetPlugin(SimulationState& s, Plugin& plugin)
 {
-	Assert(plugin.loadState != PluginLoadState::Loaded);
-
 	WidgetPlugin& widgetPlugin = ListWithHandles_Append(s.handleTable, s.widgetPlugins);
 	widgetPlugin.pluginHandle = plugin.handle;
 
-	defer { ToGUI_PluginStatesChanged(s, plugin); };
-	auto pluginGuard = guard
-	{
-		plugin.loadState = PluginLoadState::Broken;
-		List_RemoveLast(s.widgetPlugins);
-	};
-
 	plugin.kind = PluginKind::Widget;
+	return widgetPlugin;
+}
 
+// NOTE: Only touches the plugin and widget plugin so it can run on a worker thread
+static b8
+LoadWidgetPluginLibrary(PluginLoaderState& pluginLoader, Plugin& plugin, WidgetPlugin& widgetPlugin)
+{
 	// NOTE: We keep the name and author around for display purposes when a plugin is unloaded. If it
 	// gets loaded again we need to be sure we free the old strings properly.
 	String_Free(plugin.info.name);
 	String_Free(plugin.info.author);
 
-	b8 success = PluginLoader_LoadWidgetPlugin(*s.pluginLoader, plugin, widgetPlugin);
+	b8 success = PluginLoader_LoadWidgetPlugin(pluginLoader, plugin, widgetPlugin);
 	LOG_IF(!success, return false,
 		Severity::Error, "Failed to load Widget plugin '%'", plugin.fileName);
 
 	widgetPlugin.name = plugin.info.name;
+	return true;
+}
 
+static b8
+InitializeWidgetPlugin(SimulationState& s, WidgetPlugin& widgetPlugin)
+{
 	// TODO: try/catch?
-	if (widgetPlugin.functions.Initialize)
+	if (!widgetPlugin.functions.Initialize) return true;
+
+	PluginContext context = {};
+	context.s            = &s;
+	context.widgetPlugin = &widgetPlugin;
+	context.success      = true;
+
+	WidgetPluginAPI::Initialize api = {};
+	api.RegisterWidgets = RegisterWidgetTypes;
+	api.LoadPixelShader = LoadPixelShader;
+
+	b8 success = widgetPlugin.functions.Initialize(context, api);
+	success &= context.success;
+	LOG_IF(!success, return false,
+		Severity::Error, "Failed to initialize Widget plugin '%'", widgetPlugin.name);
+
+	return true;
+}
+
+static Result<WidgetPlugin*>
+LoadWidgetPlugin(SimulationState& s, Plugin& plugin)
+{
+	Assert(plugin.loadState != PluginLoadState::Loaded);
+
+	WidgetPlugin& widgetPlugin = AddWidgetPlugin(s, plugin);
+
+	defer { ToGUI_PluginStatesChanged(s, plugin); };
+	auto pluginGuard = guard
 	{
-		PluginContext context = {};
-		context.s            = &s;
-		context.widgetPlugin = &widgetPlugin;
-		context.success      = true;
+		plugin.loadState = PluginLoadState::Broken;
+		List_RemoveLast(s.widgetPlugins);
+	};
 
-		WidgetPluginAPI::Initialize api = {};
-		api.RegisterWidgets = RegisterWidgetTypes;
-		api.LoadPixelShader = LoadPixelShader;
+	b8 success = LoadWidgetPluginLibrary(*s.pluginLoader, plugin, widgetPlugin);
+	if (!success) return false;
 
-		success = widgetPlugin.functions.Initialize(context, api);
-		success &= context.success;
-		if (!success)
-		{
-			LOG(Severity::Error, "Failed to initialize Widget plugin '%'", plugin.info.name);
-			// Remove all widgets so they don't get used
-			TeardownWidgetPlugin(widgetPlugin);
-			return false;
-		}
+	success = InitializeWidgetPlugin(s, widgetPlugin);
+	if (!success)
+	{
+		// Remove all widgets so they don't get used
+		TeardownWidgetPlugin(s, widgetPlugin);
+		return false;
 	}
 
+	if (plugin.language == PluginLanguage::Native)
+		WatchPluginDirectory(s, plugin);
+
 	pluginGuard.dismiss = true;
 	return &widgetPlugin;
 }
@@ -841,38 +1645,269 @@ UnloadWidgetPlugin(SimulationState& s, WidgetPlugin& widgetPlugin)
 
 		context.success = true;
 
-		widgetAPI.widgets                = widgetType.widgets;
-		widgetAPI.widgetsUserData        = widgetType.widgetsUserData;
-		widgetAPI.widgetsUserData.stride = widgetType.userDataSize;
+		widgetAPI.widgets                = widgetType.widgets;
+		widgetAPI.widgetsUserData        = widgetType.widgetsUserData;
+		widgetAPI.widgetsUserData.stride = widgetType.userDataSize;
+
+		// TODO: try/catch?
+		if (widgetType.Teardown)
+			widgetType.Teardown(context, widgetAPI);
+	}
+
+	// TODO: try/catch?
+	if (widgetPlugin.functions.Teardown)
+	{
+		WidgetPluginAPI::Teardown pluginAPI = {};
+		widgetPlugin.functions.Teardown(context, pluginAPI);
+	}
+
+	for (u32 i = 0; i < widgetPlugin.widgetTypes.length; i++)
+	{
+		WidgetType& widgetType = widgetPlugin.widgetTypes[i];
+		RemoveWidgetReferences(s, List_MemberSlice(widgetType.widgets, &Widget::handle));
+	}
+	TeardownWidgetPlugin(s, widgetPlugin);
+
+	b8 success = PluginLoader_UnloadWidgetPlugin(*s.pluginLoader, plugin, widgetPlugin);
+	LOG_IF(!success, return false,
+		Severity::Error, "Failed to unload Widget plugin '%'", plugin.info.name);
+
+	s.handleTable.Remove(widgetPlugin.handle);
+	widgetPlugin = {};
+
+	pluginGuard.dismiss = true;
+	return true;
+}
+
+// NOTE: Swaps the library behind a loaded widget plugin without tearing down its widgets. Widgets and
+// their user data live in simulation memory, so they're detached from the old widget types, the
+// library is reloaded, and they're attached to the new widget type with the same name. Widget and
+// widget type handles are kept so selection and the GUI don't notice. If a widget type's
+// userDataSize changed its widgets are initialized again (keeping position and sensor). Widgets of
+// types that no longer exist are removed.
+static b8
+ReloadWidgetPlugin(SimulationState& s, WidgetPlugin& widgetPlugin)
+{
+	Plugin& plugin = *s.handleTable[widgetPlugin.pluginHandle];
+	Assert(plugin.loadState == PluginLoadState::Loaded);
+
+	i64 startTicks = Platform_GetTicks();
+
+	defer { ToGUI_PluginStatesChanged(s, plugin); };
+	auto pluginGuard = guard { plugin.loadState = PluginLoadState::Broken; };
+
+	// Detach widgets
+	List<WidgetType> oldTypes = widgetPlugin.widgetTypes;
+	widgetPlugin.widgetTypes = {};
+	defer {
+		// NOTE: Anything left here didn't make it into the new library
+		for (u32 i = 0; i < oldTypes.length; i++)
+		{
+			WidgetType& oldType = oldTypes[i];
+			for (u32 j = 0; j < oldType.widgets.length; j++)
+				s.handleTable.Remove(oldType.widgets[j].handle);
+			RemoveWidgetReferences(s, List_MemberSlice(oldType.widgets, &Widget::handle));
+
+			if (oldType.handle)
+				s.handleTable.Remove(oldType.handle);
+			String_Free(oldType.name);
+			TeardownWidgetType(oldType);
+		}
+		List_Free(oldTypes);
+	};
+
+	// TODO: try/catch?
+	// NOTE: Widgets are not torn down. Their state survives the reload.
+	if (widgetPlugin.functions.Teardown)
+	{
+		PluginContext context = {};
+		context.s            = &s;
+		context.widgetPlugin = &widgetPlugin;
+		context.success      = true;
+
+		WidgetPluginAPI::Teardown pluginAPI = {};
+		widgetPlugin.functions.Teardown(context, pluginAPI);
+	}
+	DestroyWidgetPluginShaders(s, widgetPlugin);
+
+	// Swap libraries
+	{
+		b8 success = PluginLoader_UnloadWidgetPlugin(*s.pluginLoader, plugin, widgetPlugin);
+		LOG_IF(!success, return false,
+			Severity::Error, "Failed to unload Widget plugin for reload '%'", plugin.info.name);
+
+		String_Free(plugin.info.name);
+		String_Free(plugin.info.author);
+		widgetPlugin.functions = {};
+		widgetPlugin.name      = {};
+
+		success = PluginLoader_LoadWidgetPlugin(*s.pluginLoader, plugin, widgetPlugin);
+		LOG_IF(!success, return false,
+			Severity::Error, "Failed to reload Widget plugin '%'", plugin.fileName);
+
+		widgetPlugin.name = plugin.info.name;
+	}
+
+	// TODO: try/catch?
+	if (widgetPlugin.functions.Initialize)
+	{
+		PluginContext context = {};
+		context.s            = &s;
+		context.widgetPlugin = &widgetPlugin;
+		context.success      = true;
+
+		WidgetPluginAPI::Initialize api = {};
+		api.RegisterWidgets = RegisterWidgetTypes;
+		api.LoadPixelShader = LoadPixelShader;
+
+		b8 success = widgetPlugin.functions.Initialize(context, api);
+		success &= context.success;
+		if (!success)
+		{
+			LOG(Severity::Error, "Failed to initialize reloaded Widget plugin '%'", plugin.info.name);
+			TeardownWidgetPlugin(s, widgetPlugin);
+			return false;
+		}
+	}
+
+	// Attach widgets
+	u32 keptCount          = 0;
+	u32 reinitializedCount = 0;
+	for (u32 i = 0; i < widgetPlugin.widgetTypes.length; i++)
+	{
+		WidgetType& widgetType = widgetPlugin.widgetTypes[i];
+
+		WidgetType* oldType = nullptr;
+		for (u32 j = 0; j < oldTypes.length; j++)
+		{
+			if (oldTypes[j].handle && String_Equal(oldTypes[j].name, widgetType.name))
+			{
+				oldType = &oldTypes[j];
+				break;
+			}
+		}
+		if (!oldType)
+		{
+			ToGUI_WidgetTypesAdded(s, widgetType);
+			continue;
+		}
+
+		s.handleTable.Remove(widgetType.handle);
+		widgetType.handle = oldType->handle;
+		s.handleTable.Relocate(widgetType.handle, &widgetType);
+		oldType->handle = {};
+
+		// NOTE: The widgets don't move in memory so their handles stay valid
+		List_Free(widgetType.widgets);
+		widgetType.widgets = oldType->widgets;
+		oldType->widgets   = {};
+
+		if (widgetType.userDataSize == oldType->userDataSize)
+		{
+			List_Free(widgetType.widgetsUserData);
+			widgetType.widgetsUserData = oldType->widgetsUserData;
+			oldType->widgetsUserData   = {};
+
+			keptCount += widgetType.widgets.length;
+		}
+		else if (widgetType.widgets.length > 0)
+		{
+			List_AppendRange(widgetType.widgetsUserData, widgetType.userDataSize * widgetType.widgets.length);
+
+			PluginContext context = {};
+			context.s            = &s;
+			context.widgetPlugin = &widgetPlugin;
+			context.success      = true;
+
+			WidgetAPI::Initialize api = {};
+			api.widgets                = widgetType.widgets;
+			api.widgetsUserData        = widgetType.widgetsUserData;
+			api.widgetsUserData.stride = widgetType.userDataSize;
+
+			widgetType.Initialize(context, api);
+			LOG_IF(!context.success, IGNORE,
+				Severity::Warning, "Failed to reinitialize widgets after reload '%'", widgetType.name);
+
+			reinitializedCount += widgetType.widgets.length;
+		}
+	}
+
+	LOG(Severity::Info, "Reloaded Widget plugin '%' in % ms (% widgets kept, % reinitialized)",
+		plugin.info.name, Platform_GetElapsedMilliseconds(startTicks), keptCount, reinitializedCount);
+
+	pluginGuard.dismiss = true;
+	return true;
+}
+
+static void
+WatchPluginDirectory(SimulationState& s, Plugin& plugin)
+{
+	for (u32 i = 0; i < s.pluginWatches.length; i++)
+		if (String_Equal(s.pluginWatches[i].path, plugin.directory))
+			return;
+
+	DirectoryWatch watch = {};
+	b8 success = Platform_CreateDirectoryWatch(plugin.directory, watch);
+	LOG_IF(!success, return,
+		Severity::Warning, "Failed to watch plugin directory, plugin will not hot reload '%'", plugin.directory);
 
-		// TODO: try/catch?
-		if (widgetType.Teardown)
-			widgetType.Teardown(context, widgetAPI);
-	}
+	List_Append(s.pluginWatches, watch);
+}
 
-	// TODO: try/catch?
-	if (widgetPlugin.functions.Teardown)
+// NOTE: Loaded widget plugins are reloaded in place when their library changes. Plugins that broke
+// during a previous reload are loaded again from scratch.
+static void
+UpdatePluginWatches(SimulationState& s)
+{
+	for (u32 i = 0; i < s.pluginWatches.length; i++)
 	{
-		WidgetPluginAPI::Teardown pluginAPI = {};
-		widgetPlugin.functions.Teardown(context, pluginAPI);
-	}
+		DirectoryWatch& watch = s.pluginWatches[i];
 
-	for (u32 i = 0; i < widgetPlugin.widgetTypes.length; i++)
-	{
-		WidgetType& widgetType = widgetPlugin.widgetTypes[i];
-		RemoveWidgetReferences(s, List_MemberSlice(widgetType.widgets, &Widget::handle));
-	}
-	TeardownWidgetPlugin(widgetPlugin);
+		for (u32 j = 0; j < s.pluginChanges.length; j++)
+			String_Free(s.pluginChanges[j]);
+		List_Clear(s.pluginChanges);
 
-	b8 success = PluginLoader_UnloadWidgetPlugin(*s.pluginLoader, plugin, widgetPlugin);
-	LOG_IF(!success, return false,
-		Severity::Error, "Failed to unload Widget plugin '%'", plugin.info.name);
+		b8 success = Platform_ReadDirectoryWatch(watch, s.pluginChanges);
+		if (!success) continue;
 
-	s.handleTable.Remove(widgetPlugin.handle);
-	widgetPlugin = {};
+		for (u32 j = 0; j < s.pluginChanges.length; j++)
+		{
+			StringView fileName = s.pluginChanges[j];
+			for (u32 k = 0; k < s.plugins.length; k++)
+			{
+				Plugin& plugin = s.plugins[k];
+				if (plugin.kind != PluginKind::Widget) continue;
+				if (plugin.language != PluginLanguage::Native) continue;
+				if (!String_Equal(plugin.directory, watch.path)) continue;
+				if (!String_Equal(plugin.fileName, fileName)) continue;
 
-	pluginGuard.dismiss = true;
-	return true;
+				if (plugin.loadState == PluginLoadState::Broken)
+				{
+					LoadWidgetPlugin(s, plugin);
+					continue;
+				}
+
+				for (i32 l = (i32) s.widgetPlugins.length - 1; l >= 0; l--)
+				{
+					WidgetPlugin& widgetPlugin = s.widgetPlugins[(u32) l];
+					if (widgetPlugin.pluginHandle != plugin.handle) continue;
+
+					success = ReloadWidgetPlugin(s, widgetPlugin);
+					if (!success)
+					{
+						s.handleTable.Remove(widgetPlugin.handle);
+						List_RemoveFast(s.widgetPlugins, (u32) l);
+
+						if ((u32) l < s.widgetPlugins.length)
+						{
+							WidgetPlugin& movedPlugin = s.widgetPlugins[(u32) l];
+							s.handleTable.Relocate(movedPlugin.handle, &movedPlugin);
+						}
+					}
+				}
+			}
+		}
+	}
 }
 
 // -------------------------------------------------------------------------------------------------
@@ -888,7 +1923,7 @@ ListWithHandles_Append(HandleTable& handleTable, List<T>& list, u32 count)
 		for (u32 i = 0; i < list.length - count; i++)
 		{
 			T& element = list[i];
-			handleTable.Update(element.handle, &element);
+			handleTable.Relocate(element.handle, &element);
 		}
 	}
 
@@ -937,6 +1972,7 @@ AddWidgets(SimulationState& s, WidgetType& widgetType, u32 count)
 
 	ListWithHandles_Append(s.handleTable, widgetType.widgets, count);
 	List_AppendRange(widgetType.widgetsUserData, widgetType.userDataSize * count);
+	widgetType.wvpsDirty = true;
 
 	PluginContext context = {};
 	context.s            = &s;
@@ -1028,23 +2064,61 @@ RemoveWidgets(SimulationState& s, Slice<Handle<Widget>> widgetHandles)
 		List_RemoveFast(widgetType.widgets, widgetIndex);
 		List_RemoveRangeFast(widgetType.widgetsUserData, widgetType.userDataSize * widgetIndex, widgetType.userDataSize);
 		s.handleTable.Remove(widgetHandle);
+		widgetType.wvpsDirty = true;
 
-		if (widgetType.widgets.length > 0)
+		if (widgetIndex < widgetType.widgets.length)
 		{
 			Widget& movedWidget = widgetType.widgets[widgetIndex];
-			s.handleTable.Update(movedWidget.handle, &movedWidget);
+			s.handleTable.Relocate(movedWidget.handle, &movedWidget);
 		}
 	}
 
 	RemoveWidgetReferences(s, widgetHandles);
 }
 
+// NOTE: Finds another sensor with the given identifier that isn't one of the sensors being removed
+static Sensor*
+FindSurvivingSensor(SimulationState& s, StringView identifier, Slice<Handle<Sensor>> removedHandles)
+{
+	for (u32 i = 0; i < s.sensorPlugins.length; i++)
+	{
+		SensorPlugin& sensorPlugin = s.sensorPlugins[i];
+		for (u32 j = 0; j < sensorPlugin.sensors.length; j++)
+		{
+			Sensor& sensor = sensorPlugin.sensors[j];
+			if (!String_Equal(sensor.identifier, identifier)) continue;
+
+			b8 removed = false;
+			for (u32 k = 0; k < removedHandles.length; k++)
+				removed |= sensor.handle == removedHandles[k];
+			if (!removed) return &sensor;
+		}
+	}
+	return nullptr;
+}
+
 static void
 RemoveSensorReferences(SimulationState& s, Slice<Handle<Sensor>> sensorHandles)
 {
 	for (u32 i = 0; i < sensorHandles.length; i++)
 	{
 		Handle<Sensor> sensorHandle = sensorHandles[i];
+		Sensor&        sensor       = *s.handleTable[sensorHandle];
+
+		// NOTE: A later sensor with the same identifier may have replaced this one. If this one is
+		// the indexed one, another sensor with the same identifier takes its place. The key points
+		// into the identifier of the indexed sensor so it has to be replaced as well.
+		StringView      identifier    = sensor.identifier;
+		Handle<Sensor>* indexedHandle = HashMap_Find(s.sensorsByIdentifier, identifier);
+		if (indexedHandle && *indexedHandle == sensorHandle)
+		{
+			Sensor* survivor = FindSurvivingSensor(s, identifier, sensorHandles);
+			if (survivor)
+				HashMap_Set(s.sensorsByIdentifier, (StringView) survivor->identifier, survivor->handle);
+			else
+				HashMap_Remove(s.sensorsByIdentifier, identifier);
+		}
+
 		// TODO: Widget iterator!
 		for (u32 j = 0; j < s.widgetPlugins.length; j++)
 		{
@@ -1100,6 +2174,7 @@ MouseLook(SimulationState& s)
 	s.vp        = s.view * s.proj;
 
 	s.iview = InvertRT(s.view);
+	InvalidateWidgetTransforms(s);
 }
 
 static void
@@ -1117,6 +2192,7 @@ ResetCamera(SimulationState& s)
 	s.vp   = s.view * s.proj;
 
 	s.iview = InvertRT(s.view);
+	InvalidateWidgetTransforms(s);
 }
 
 // TODO: Think through how to handle left mouse going down and the exclusivity of selection and
@@ -1147,6 +2223,7 @@ DragSelection(SimulationState& s)
 			Widget&        selected       = *s.handleTable[selectedHandle];
 
 			selected.position += (v2) deltaPos;
+			s.handleTable[selected.typeHandle]->wvpsDirty = true;
 		}
 	}
 }
@@ -1166,7 +2243,6 @@ HighlightWidgets(SimulationState& s, Slice<Handle<Widget>> widgetHandles, Outlin
 		// TODO: Duplicating this is error prone
 		WidgetAPI::Update widgetAPI = {};
 		widgetAPI.t                       = s.currentTime;
-		widgetAPI.sensors                 = s.sensorPlugins[0].sensors;
 		widgetAPI.GetSensor               = GetSensor;
 		widgetAPI.GetViewMatrix           = GetViewMatrix;
 		widgetAPI.GetProjectionMatrix     = GetProjectionMatrix;
@@ -1198,6 +2274,8 @@ HighlightWidgets(SimulationState& s, Slice<Handle<Widget>> widgetHandles, Outlin
 			u32 widgetIndex = List_PointerToIndex(widgetType.widgets, widget);
 			widgetAPI.widgetsUserData        = widgetType.widgetsUserData[widgetType.userDataSize * widgetIndex];
 			widgetAPI.widgetsUserData.stride = widgetType.userDataSize;
+			widgetAPI.sensorValues           = GatherSensorValues(s, widgetType, widgetIndex, 1);
+			widgetAPI.wvps                   = GatherWidgetTransforms(s, widgetType)[widgetIndex];
 
 			// TODO: try/catch?
 			widgetType.Update(context, widgetAPI);
@@ -1346,6 +2424,318 @@ RemoveHoverAnimation(SimulationState& s, u32 index)
 	List_RemoveFast(s.hoverAnimations, index);
 }
 
+// -------------------------------------------------------------------------------------------------
+// Layout
+
+// NOTE: See layout.hpp. Every loaded plugin is saved, so plugins are loaded again on the next run
+// even if they don't have any widgets.
+static b8
+SaveLayout(SimulationState& s, StringView path)
+{
+	LayoutWriter writer = {};
+	Layout_InitializeWriter(writer);
+	defer { Layout_FreeWriter(writer); };
+
+	List<LayoutPlugin>     plugins       = {};
+	List<LayoutWidgetType> widgetTypes   = {};
+	List<LayoutSensor>     sensors       = {};
+	List<Widget>           widgets       = {};
+	List<u32>              widgetSensors = {};
+	Bytes                  userData      = {};
+	defer
+	{
+		List_Free(plugins);
+		List_Free(widgetTypes);
+		List_Free(sensors);
+		List_Free(widgets);
+		List_Free(widgetSensors);
+		List_Free(userData);
+	};
+
+	HashMap<Handle<Plugin>, u32> pluginIndices = {};
+	HashMap<Handle<Sensor>, u32> sensorIndices = {};
+	defer
+	{
+		HashMap_Free(pluginIndices);
+		HashMap_Free(sensorIndices);
+	};
+
+	for (u32 i = 0; i < s.plugins.length; i++)
+	{
+		Plugin& plugin = s.plugins[i];
+		if (plugin.language == PluginLanguage::Builtin) continue;
+		if (plugin.loadState != PluginLoadState::Loaded) continue;
+
+		HashMap_Set(pluginIndices, plugin.handle, plugins.length);
+
+		LayoutPlugin& layoutPlugin = List_Append(plugins);
+		layoutPlugin.kind         = plugin.kind;
+		layoutPlugin.outOfProcess = plugin.outOfProcess;
+		layoutPlugin.directory    = Layout_AppendString(writer, plugin.directory);
+		layoutPlugin.fileName     = Layout_AppendString(writer, plugin.fileName);
+	}
+
+	for (u32 i = 0; i < s.widgetPlugins.length; i++)
+	{
+		WidgetPlugin& widgetPlugin = s.widgetPlugins[i];
+
+		u32* pluginIndex = HashMap_Find(pluginIndices, widgetPlugin.pluginHandle);
+		if (!pluginIndex) continue;
+
+		for (u32 j = 0; j < widgetPlugin.widgetTypes.length; j++)
+		{
+			WidgetType& widgetType = widgetPlugin.widgetTypes[j];
+			if (widgetType.widgets.length == 0) continue;
+
+			LayoutWidgetType& layoutWidgetType = List_Append(widgetTypes);
+			layoutWidgetType.plugin        = *pluginIndex;
+			layoutWidgetType.name          = Layout_AppendString(writer, widgetType.name);
+			layoutWidgetType.userDataSize  = widgetType.userDataSize;
+			layoutWidgetType.firstWidget   = widgets.length;
+			layoutWidgetType.widgetCount   = widgetType.widgets.length;
+			layoutWidgetType.firstUserData = userData.length;
+
+			List_AppendRange(widgets, Slice<Widget>(widgetType.widgets));
+			List_AppendRange(userData, Slice<u8>(widgetType.widgetsUserData));
+
+			for (u32 k = 0; k < widgetType.widgets.length; k++)
+			{
+				Handle<Sensor> sensorHandle = widgetType.widgets[k].sensorHandle;
+
+				u32 sensorIndex = LayoutNone;
+				if (sensorHandle)
+				{
+					u32* existingIndex = HashMap_Find(sensorIndices, sensorHandle);
+					if (existingIndex)
+					{
+						sensorIndex = *existingIndex;
+					}
+					else
+					{
+						sensorIndex = sensors.length;
+						HashMap_Set(sensorIndices, sensorHandle, sensorIndex);
+
+						Sensor& sensor = *s.handleTable[sensorHandle];
+						LayoutSensor& layoutSensor = List_Append(sensors);
+						layoutSensor.identifier = Layout_AppendString(writer, sensor.identifier);
+					}
+				}
+				List_Append(widgetSensors, sensorIndex);
+			}
+		}
+	}
+
+	// NOTE: Handles are meaningless in the next run
+	for (u32 i = 0; i < widgets.length; i++)
+	{
+		Widget& widget = widgets[i];
+		widget.handle       = {};
+		widget.typeHandle   = {};
+		widget.sensorHandle = {};
+	}
+
+	Layout_AppendSection(writer, writer.header.plugins,       Slice<LayoutPlugin>(plugins));
+	Layout_AppendSection(writer, writer.header.widgetTypes,   Slice<LayoutWidgetType>(widgetTypes));
+	Layout_AppendSection(writer, writer.header.sensors,       Slice<LayoutSensor>(sensors));
+	Layout_AppendSection(writer, writer.header.widgets,       Slice<Widget>(widgets));
+	Layout_AppendSection(writer, writer.header.widgetSensors, Slice<u32>(widgetSensors));
+	Layout_AppendSection(writer, writer.header.userData,      Slice<u8>(userData));
+	ByteSlice bytes = Layout_Finalize(writer);
+
+	b8 success = Platform_WriteFileBytes(path, bytes);
+	LOG_IF(!success, return false,
+		Severity::Warning, "Failed to save layout '%'", path);
+
+	return true;
+}
+
+static Plugin*
+FindPlugin(SimulationState& s, StringView directory, StringView fileName)
+{
+	for (u32 i = 0; i < s.plugins.length; i++)
+	{
+		Plugin& plugin = s.plugins[i];
+		if (String_Equal(plugin.directory, directory) && String_Equal(plugin.fileName, fileName))
+			return &plugin;
+	}
+	return nullptr;
+}
+
+static WidgetType*
+FindWidgetType(SimulationState& s, Handle<Plugin> pluginHandle, StringView name)
+{
+	for (u32 i = 0; i < s.widgetPlugins.length; i++)
+	{
+		WidgetPlugin& widgetPlugin = s.widgetPlugins[i];
+		if (widgetPlugin.pluginHandle != pluginHandle) continue;
+
+		for (u32 j = 0; j < widgetPlugin.widgetTypes.length; j++)
+		{
+			WidgetType& widgetType = widgetPlugin.widgetTypes[j];
+			if (String_Equal(widgetType.name, name))
+				return &widgetType;
+		}
+	}
+	return nullptr;
+}
+
+// NOTE: Plugins in the layout are loaded if they aren't already. Widget records and user data are
+// bulk copied into the widget type lists, then handles are assigned. Widgets of types that no longer
+// exist are skipped. If a widget type's userDataSize changed its widgets are initialized again
+// (keeping position and sensor), same as a reload. Sensors that no longer exist are replaced with the
+// null sensor.
+static b8
+RestoreLayout(SimulationState& s, ByteSlice bytes)
+{
+	i64 startTicks = Platform_GetTicks();
+
+	LayoutHeader* header = Layout_Validate(bytes);
+	LOG_IF(!header, return false,
+		Severity::Warning, "Layout is corrupt or from a different version");
+
+	Slice<LayoutPlugin>     layoutPlugins       = Layout_GetSection<LayoutPlugin>    (bytes, header->plugins);
+	Slice<LayoutWidgetType> layoutWidgetTypes   = Layout_GetSection<LayoutWidgetType>(bytes, header->widgetTypes);
+	Slice<LayoutSensor>     layoutSensors       = Layout_GetSection<LayoutSensor>    (bytes, header->sensors);
+	Slice<Widget>           layoutWidgets       = Layout_GetSection<Widget>          (bytes, header->widgets);
+	Slice<u32>              layoutWidgetSensors = Layout_GetSection<u32>             (bytes, header->widgetSensors);
+	Slice<u8>               layoutUserData      = Layout_GetSection<u8>              (bytes, header->userData);
+
+	// Plugins
+	List<Handle<Plugin>> pluginHandles = {};
+	List_AppendRange(pluginHandles, layoutPlugins.length);
+	defer { List_Free(pluginHandles); };
+
+	for (u32 i = 0; i < layoutPlugins.length; i++)
+	{
+		LayoutPlugin& layoutPlugin = layoutPlugins[i];
+		StringView    directory    = Layout_GetString(bytes, *header, layoutPlugin.directory);
+		StringView    fileName     = Layout_GetString(bytes, *header, layoutPlugin.fileName);
+
+		Plugin* plugin = FindPlugin(s, directory, fileName);
+		if (!plugin)
+		{
+			plugin = &RegisterPlugin(s, directory, fileName);
+			plugin->outOfProcess = layoutPlugin.outOfProcess;
+		}
+		pluginHandles[i] = plugin->handle;
+
+		// NOTE: Plugins that broke while loading during startup aren't tried again
+		if (plugin->loadState == PluginLoadState::Loaded) continue;
+		if (plugin->loadState == PluginLoadState::Broken) continue;
+
+		b8 success = layoutPlugin.kind == PluginKind::Sensor
+			? (b8) LoadSensorPlugin(s, *plugin)
+			: (b8) LoadWidgetPlugin(s, *plugin);
+		LOG_IF(!success, IGNORE,
+			Severity::Warning, "Failed to load plugin '%' from layout", fileName);
+	}
+
+	// Sensors
+	List<Handle<Sensor>> sensorHandles = {};
+	List_AppendRange(sensorHandles, layoutSensors.length);
+	defer { List_Free(sensorHandles); };
+
+	u32 missingSensorCount = 0;
+	for (u32 i = 0; i < layoutSensors.length; i++)
+	{
+		StringView identifier = Layout_GetString(bytes, *header, layoutSensors[i].identifier);
+
+		Handle<Sensor> sensorHandle = FindSensor(s, identifier);
+		if (!sensorHandle)
+		{
+			sensorHandle = s.nullSensorHandle;
+			missingSensorCount++;
+		}
+		sensorHandles[i] = sensorHandle;
+	}
+
+	// Widgets
+	u32 keptCount          = 0;
+	u32 reinitializedCount = 0;
+	u32 skippedCount       = 0;
+	for (u32 i = 0; i < layoutWidgetTypes.length; i++)
+	{
+		LayoutWidgetType& layoutWidgetType = layoutWidgetTypes[i];
+		StringView        name             = Layout_GetString(bytes, *header, layoutWidgetType.name);
+
+		WidgetType* widgetTypePtr = FindWidgetType(s, pluginHandles[layoutWidgetType.plugin], name);
+		if (!widgetTypePtr)
+		{
+			LOG(Severity::Warning, "Widget type '%' in layout no longer exists", name);
+			skippedCount += layoutWidgetType.widgetCount;
+			continue;
+		}
+		WidgetType& widgetType = *widgetTypePtr;
+
+		Slice<Widget> records = {};
+		records.data   = layoutWidgets.data + layoutWidgetType.firstWidget;
+		records.length = layoutWidgetType.widgetCount;
+
+		u32     first    = widgetType.widgets.length;
+		Widget* prevData = widgetType.widgets.data;
+		List_AppendRange(widgetType.widgets, records);
+		widgetType.wvpsDirty = true;
+
+		// NOTE: Existing widgets keep their handles if the list moved
+		if (widgetType.widgets.data != prevData)
+		{
+			for (u32 j = 0; j < first; j++)
+			{
+				Widget& widget = widgetType.widgets[j];
+				s.handleTable.Relocate(widget.handle, &widget);
+			}
+		}
+
+		for (u32 j = 0; j < records.length; j++)
+		{
+			Widget& widget      = widgetType.widgets[first + j];
+			u32     sensorIndex = layoutWidgetSensors[layoutWidgetType.firstWidget + j];
+
+			widget.handle       = s.handleTable.Add(&widget);
+			widget.typeHandle   = widgetType.handle;
+			widget.sensorHandle = sensorIndex == LayoutNone ? Handle<Sensor>::Null : sensorHandles[sensorIndex];
+		}
+
+		if (widgetType.userDataSize == layoutWidgetType.userDataSize)
+		{
+			Slice<u8> userData = {};
+			userData.data   = layoutUserData.data + layoutWidgetType.firstUserData;
+			userData.length = layoutWidgetType.userDataSize * layoutWidgetType.widgetCount;
+			List_AppendRange(widgetType.widgetsUserData, userData);
+
+			keptCount += records.length;
+		}
+		else
+		{
+			List_AppendRange(widgetType.widgetsUserData, widgetType.userDataSize * records.length);
+
+			PluginContext context = {};
+			context.s            = &s;
+			context.widgetPlugin = s.handleTable[widgetType.widgetPluginHandle];
+			context.success      = true;
+
+			WidgetAPI::Initialize api = {};
+			api.widgets                = List_Slice(widgetType.widgets, first);
+			api.widgetsUserData        = List_Slice(widgetType.widgetsUserData, widgetType.userDataSize * first);
+			api.widgetsUserData.stride = widgetType.userDataSize;
+
+			widgetType.Initialize(context, api);
+			LOG_IF(!context.success, IGNORE,
+				Severity::Warning, "Failed to reinitialize widgets from layout '%'", widgetType.name);
+
+			reinitializedCount += records.length;
+		}
+
+		Slice<Widget> newWidgets = List_Slice(widgetType.widgets, first);
+		ToGUI_WidgetsAdded(s, Slice_MemberSlice(newWidgets, &Widget::handle));
+	}
+
+	LOG(Severity::Info, "Restored layout in % ms (% widgets kept, % reinitialized, % skipped, % sensors missing)",
+		Platform_GetElapsedMilliseconds(startTicks), keptCount, reinitializedCount, skippedCount, missingSensorCount);
+
+	return true;
+}
+
 // -------------------------------------------------------------------------------------------------
 // Messages From GUI
 
@@ -1463,6 +2853,13 @@ FromGUI_SetPluginLoadStates(SimulationState& s, FromGUI::SetPluginLoadStates& se
 						{
 							UnloadSensorPlugin(s, sensorPlugin);
 							List_RemoveFast(s.sensorPlugins, (u32) j);
+							InvalidateSensorBindings(s);
+
+							if ((u32) j < s.sensorPlugins.length)
+							{
+								SensorPlugin& movedPlugin = s.sensorPlugins[(u32) j];
+								s.handleTable.Relocate(movedPlugin.handle, &movedPlugin);
+							}
 						}
 					}
 				}
@@ -1475,6 +2872,12 @@ FromGUI_SetPluginLoadStates(SimulationState& s, FromGUI::SetPluginLoadStates& se
 						{
 							UnloadWidgetPlugin(s, widgetPlugin);
 							List_RemoveFast(s.widgetPlugins, (u32) j);
+
+							if ((u32) j < s.widgetPlugins.length)
+							{
+								WidgetPlugin& movedPlugin = s.widgetPlugins[(u32) j];
+								s.handleTable.Relocate(movedPlugin.handle, &movedPlugin);
+							}
 						}
 					}
 				}
@@ -1581,6 +2984,68 @@ FromGUI_SetWidgetSelection(SimulationState& s, FromGUI::SetWidgetSelection& widg
 	SelectWidgets(s, widgetSelection.handles);
 }
 
+static void
+FromGUI_SetLCDPixelFormat(SimulationState& s, FromGUI::SetLCDPixelFormat& setPixelFormat)
+{
+	Assert(setPixelFormat.format > PixelFormat::Null && setPixelFormat.format < PixelFormat::Count);
+	Assert(setPixelFormat.dither < Dither::Count);
+
+	s.lcdPixelFormat = setPixelFormat.format;
+	s.lcdDither      = setPixelFormat.dither;
+}
+
+// NOTE: Only messages that carry complete state can be superseded. Mouse moves carry an absolute
+// position, and selections and pixel formats carry the whole setting, so only the latest of a run
+// matters.
+static b8
+FromGUI_Supersedes(Bytes& next, Bytes& prev)
+{
+	Message::Header& nextHeader = (Message::Header&) next[0];
+	Message::Header& prevHeader = (Message::Header&) prev[0];
+	if (nextHeader.type != prevHeader.type) return false;
+
+	switch (nextHeader.type)
+	{
+		default: return false;
+		case MessageTypeOf<FromGUI::MouseMove>:          return true;
+		case MessageTypeOf<FromGUI::SetWidgetSelection>: return true;
+		case MessageTypeOf<FromGUI::SetLCDPixelFormat>:  return true;
+	}
+}
+
+static constexpr MessageTable<SimulationState>
+FromGUI_BuildMessageTable()
+{
+	#define HANDLE_MESSAGE(Type) \
+		table.handlers[MessageTypeOf<FromGUI::Type>] = MessageHandler<SimulationState, FromGUI::Type, FromGUI_##Type>;
+
+	MessageTable<SimulationState> table = {};
+	HANDLE_MESSAGE(TerminateSimulation)
+	HANDLE_MESSAGE(MouseMove)
+	HANDLE_MESSAGE(SelectHovered)
+	HANDLE_MESSAGE(BeginMouseLook)
+	HANDLE_MESSAGE(EndMouseLook)
+	HANDLE_MESSAGE(ResetCamera)
+	HANDLE_MESSAGE(SetPluginLoadStates)
+	HANDLE_MESSAGE(DragDrop)
+	HANDLE_MESSAGE(AddWidget)
+	HANDLE_MESSAGE(RemoveWidget)
+	HANDLE_MESSAGE(RemoveSelectedWidgets)
+	HANDLE_MESSAGE(BeginDragSelection)
+	HANDLE_MESSAGE(EndDragSelection)
+	HANDLE_MESSAGE(SetWidgetSelection)
+	HANDLE_MESSAGE(SetLCDPixelFormat)
+	return table;
+}
+
+static constexpr MessageTable<SimulationState> FromGUI_MessageTable = FromGUI_BuildMessageTable();
+
+static void
+FromGUI_HandleMessage(SimulationState& s, Bytes& bytes)
+{
+	DispatchMessage(FromGUI_MessageTable, s, bytes);
+}
+
 // -------------------------------------------------------------------------------------------------
 // Built-in Plugins
 
@@ -1600,10 +3065,9 @@ BuiltinSensorPlugin_Update(PluginContext& context, SensorPluginAPI::Update api)
 {
 	Unused(context);
 
-	Assert(api.sensors.length == 1);
-	Sensor& sensor = api.sensors[0];
+	Assert(api.values.length == 1);
 	r32 t = context.s->currentTime;
-	sensor.value = sinf(t) * sinf(t);
+	api.values[0] = sinf(t) * sinf(t);
 }
 
 static void
@@ -1626,40 +3090,160 @@ BuiltinSensorPlugin_GetPluginInfo(PluginDesc& desc, SensorPluginFunctions& funct
 }
 
 // -------------------------------------------------------------------------------------------------
+// Hardware
 
-b8
-Simulation_Initialize(
-	SimulationState&   s,
-	PluginLoaderState& pluginLoader,
-	RendererState&     renderer,
-	FT232HState&       ft232h,
-	ILI9341State&      ili9341)
+// NOTE: Frames are recorded as an MPSSE program (see FT232H_BeginProgram) so the whole frame goes out
+// in one write. This reports what batching saved compared to writing every command as it was issued.
+static void
+Hardware_Report(SimulationState& s)
 {
-	s.pluginLoader = &pluginLoader;
-	s.renderer     = &renderer;
-	s.ft232h       = &ft232h;
-	s.ili9341      = &ili9341;
-	s.startTime    = Platform_GetTicks();
-	s.renderSize   = { 320, 240 };
+	if (Platform_GetElapsedSeconds(s.ft232hLastReport) < s.frameBudget.reportInterval) return;
+	s.ft232hLastReport = Platform_GetTicks();
 
-	s.outlinePSPerPassBlur[0].textureSize   = s.renderSize;
-	s.outlinePSPerPassBlur[0].blurDirection = v2{ 1.0f, 0.0f };
-	s.outlinePSPerPassBlur[1].textureSize   = s.renderSize;
-	s.outlinePSPerPassBlur[1].blurDirection = v2{ 0.0f, 1.0f };
+	if (!s.ft232hInitialized) return;
+
+	FT232HProgramStats stats = FT232H_TakeProgramStats(*s.ft232h);
+	if (stats.emittedWrites == 0) return;
+
+	LOG(Severity::Info, "FT232H sent % bytes in % writes over % s (% bytes in % writes unbatched, % of % pin changes, % of % send headers)",
+		stats.emittedBytes, stats.emittedWrites, s.frameBudget.reportInterval, stats.requestedBytes, stats.requestedWrites,
+		stats.emittedPinWrites, stats.requestedPinWrites, stats.emittedSends, stats.requestedSends);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Startup
+
+// NOTE: Startup is a job graph (see jobs.hpp) run in three passes. The first starts the plugin
+// loader, reads the built-in shaders and the layout, and creates the renderer resources that don't
+// need files. The second loads the plugins the layout needs (or the default set) and initializes
+// them. The third restores the layout and finalizes the renderer.
+//
+// Plugin libraries are loaded on workers. In process native sensor plugins are also initialized on a
+// worker, with sensor registration deferred to the main thread. Everything else that touches the
+// renderer, the handle table, or the GUI runs on the main thread. Renderer resources are registered
+// in a fixed order so the standard resource indices hold.
+
+enum struct StartupStage
+{
+	Null,
+	PluginLoader,
+	Shaders,
+	Renderer,
+	PluginLoading,
+	PluginInitialization,
+	Layout,
+	Count
+};
+
+enum struct StartupShader
+{
+	WVP,
+	ClipSpace,
+	SolidColored,
+	VertexColored,
+	DebugCoordinates,
+	Composite,
+	Outline,
+	OutlineComposite,
+	DepthToAlpha,
+	Count
+};
+
+struct StartupFile
+{
+	StringView path;
+	b8         required;
+	ByteSlice  bytes;
+};
+
+// NOTE: Loaded when there's no layout, along with a few widgets so there's something on screen
+const StringView DefaultSensorPluginDirectory = "Sensor Plugins\\OpenHardwareMonitor";
+const StringView DefaultSensorPluginFileName  = "Sensor.OpenHardwareMonitor.dll";
+const StringView DefaultWidgetPluginDirectory = "Widget Plugins\\Filled Bar";
+const StringView DefaultWidgetPluginFileName  = "Widget.FilledBar.dll";
+const StringView DefaultWidgetTypeName        = "Filled Bar";
+const u32        DefaultWidgetCount           = 6;
+
+struct StartupPlugin
+{
+	SimulationState*     s;
+	Plugin*              plugin;
+	SensorPlugin*        sensorPlugin;
+	WidgetPlugin*        widgetPlugin;
+	b8                   initializedOnWorker;
+	List<DeferredSensor> deferredSensors;
+	u32                  lastJob;
+};
+
+struct StartupState
+{
+	SimulationState*    s;
+	WorkQueue           queue;
+	JobGraph            graph;
+	StartupFile         shaders[(u32) StartupShader::Count];
+	StartupFile         layout;
+	LayoutHeader*       layoutHeader;
+	List<StartupPlugin> plugins;
+};
+
+static StringView
+StartupStage_Name(StartupStage stage)
+{
+	switch (stage)
+	{
+		default: Assert(false); return "Unknown";
+		case StartupStage::PluginLoader:         return "Plugin Loader";
+		case StartupStage::Shaders:              return "Shaders";
+		case StartupStage::Renderer:             return "Renderer";
+		case StartupStage::PluginLoading:        return "Plugin Loading";
+		case StartupStage::PluginInitialization: return "Plugin Initialization";
+		case StartupStage::Layout:               return "Layout";
+	}
+}
+
+static StringView
+StartupShader_Path(StartupShader shader)
+{
+	switch (shader)
+	{
+		default: Assert(false); return {};
+		case StartupShader::WVP:              return "Shaders/WVP.vs.cso";
+		case StartupShader::ClipSpace:        return "Shaders/Clip Space.vs.cso";
+		case StartupShader::SolidColored:     return "Shaders/Solid Colored.ps.cso";
+		case StartupShader::VertexColored:    return "Shaders/Vertex Colored.ps.cso";
+		case StartupShader::DebugCoordinates: return "Shaders/Debug Coordinates.ps.cso";
+		case StartupShader::Composite:        return "Shaders/Composite.ps.cso";
+		case StartupShader::Outline:          return "Shaders/Outline.ps.cso";
+		case StartupShader::OutlineComposite: return "Shaders/Outline Composite.ps.cso";
+		case StartupShader::DepthToAlpha:     return "Shaders/Depth to Alpha.ps.cso";
+	}
+}
 
-	s.outlinePSPerPassSelected.outlineColor = Color128(0, 122, 204, 255);
-	s.outlinePSPerPassHovered.outlineColor  = Color128(28, 151, 234, 255);
+static ByteSlice
+Startup_GetShader(StartupState& startup, StartupShader shader)
+{
+	return startup.shaders[(u32) shader].bytes;
+}
 
-	b8 success = PluginLoader_Initialize(*s.pluginLoader);
-	if (!success) return false;
+static b8
+Startup_ReadFile(void* data)
+{
+	StartupFile& file = *(StartupFile*) data;
+	file.bytes = Platform_MapFile(file.path, FileAccess::Sequential, file.required);
+	return file.bytes.data || !file.required;
+}
 
-	List_Reserve(s.plugins, 16);
-	List_Reserve(s.handleTable.elements, 64);
-	List_Reserve(s.sensorPlugins, 8);
-	List_Reserve(s.widgetPlugins, 8);
+static b8
+Startup_InitializePluginLoader(void* data)
+{
+	SimulationState& s = *(SimulationState*) data;
+	return PluginLoader_Initialize(*s.pluginLoader);
+}
 
-	// Setup Camera
-	ResetCamera(s);
+static b8
+Startup_CreateRendererResources(void* data)
+{
+	SimulationState& s = *(SimulationState*) data;
 
 	// Create Standard Rendering Resources
 	{
@@ -1680,57 +3264,8 @@ Simulation_Initialize(
 		if (!s.renderTargetGUICopy) return false;
 	}
 
-	// Load Default Assets
+	// Default Meshes
 	{
-		// Vertex shader
-		{
-			VertexShader vs;
-
-			VertexAttribute vsAttributes[] = {
-				{ VertexAttributeSemantic::Position, VertexAttributeFormat::v3 },
-				{ VertexAttributeSemantic::Color,    VertexAttributeFormat::v4 },
-				{ VertexAttributeSemantic::TexCoord, VertexAttributeFormat::v2 },
-			};
-
-			vs = Renderer_LoadVertexShader(*s.renderer, "WVP", "Shaders/WVP.vs.cso", vsAttributes, sizeof(Matrix));
-			LOG_IF(!vs, return false,
-				Severity::Error, "Failed to load built-in wvp vertex shader");
-			Assert(vs == StandardVertexShader::WVP);
-
-			vs = Renderer_LoadVertexShader(*s.renderer, "Clip Space", "Shaders/Clip Space.vs.cso", vsAttributes, sizeof(Matrix));
-			LOG_IF(!vs, return false,
-				Severity::Error, "Failed to load built-in clip space vertex shader");
-			Assert(vs == StandardVertexShader::ClipSpace);
-		}
-
-		// Pixel shader
-		{
-			PixelShader ps;
-
-			u32 cBufSizes[] = {
-				{ sizeof(SolidColor::PSInitialize) },
-			};
-			ps = Renderer_LoadPixelShader(*s.renderer, "Solid Colored", "Shaders/Solid Colored.ps.cso", cBufSizes);
-			LOG_IF(!ps, return false,
-				Severity::Error, "Failed to load built-in solid colored pixel shader");
-			Assert(ps == StandardPixelShader::SolidColored);
-
-			ps = Renderer_LoadPixelShader(*s.renderer, "Vertex Colored", "Shaders/Vertex Colored.ps.cso", {});
-			LOG_IF(!ps, return false,
-				Severity::Error, "Failed to load built-in vertex colored pixel shader");
-			Assert(ps == StandardPixelShader::VertexColored);
-
-			ps = Renderer_LoadPixelShader(*s.renderer, "Debug Coordinates", "Shaders/Debug Coordinates.ps.cso", {});
-			LOG_IF(!ps, return false,
-				Severity::Error, "Failed to load built-in vertex colored pixel shader");
-			Assert(ps == StandardPixelShader::DebugCoordinates);
-
-			ps = Renderer_LoadPixelShader(*s.renderer, "Composite", "Shaders/Composite.ps.cso", {});
-			LOG_IF(!ps, return false,
-				Severity::Error, "Failed to load composite pixel shader");
-			Assert(ps == StandardPixelShader::Composite);
-		}
-
 		// Triangle mesh
 		{
 			Vertex vertices[] = {
@@ -1855,7 +3390,7 @@ Simulation_Initialize(
 		}
 	}
 
-	// Other rendering resources
+	// Temporary Targets
 	{
 		for (u32 i = 0; i < ArrayLength(s.tempRenderTargets); i++)
 		{
@@ -1874,68 +3409,505 @@ Simulation_Initialize(
 			s.tempDepthBuffers[i] = Renderer_CreateDepthBuffer(*s.renderer, name, true);
 			if (!s.tempDepthBuffers[i]) return false;
 		}
+	}
+
+	return true;
+}
+
+static b8
+Startup_RegisterShaders(void* data)
+{
+	StartupState&    startup = *(StartupState*) data;
+	SimulationState& s       = *startup.s;
+
+	// Vertex shader
+	{
+		VertexShader vs;
+
+		VertexAttribute vsAttributes[] = {
+			{ VertexAttributeSemantic::Position, VertexAttributeFormat::v3 },
+			{ VertexAttributeSemantic::Color,    VertexAttributeFormat::v4 },
+			{ VertexAttributeSemantic::TexCoord, VertexAttributeFormat::v2 },
+		};
+
+		vs = Renderer_CreateVertexShader(*s.renderer, "WVP", Startup_GetShader(startup, StartupShader::WVP), vsAttributes, sizeof(Matrix));
+		LOG_IF(!vs, return false,
+			Severity::Error, "Failed to load built-in wvp vertex shader");
+		Assert(vs == StandardVertexShader::WVP);
 
+		vs = Renderer_CreateVertexShader(*s.renderer, "Clip Space", Startup_GetShader(startup, StartupShader::ClipSpace), vsAttributes, sizeof(Matrix));
+		LOG_IF(!vs, return false,
+			Severity::Error, "Failed to load built-in clip space vertex shader");
+		Assert(vs == StandardVertexShader::ClipSpace);
+	}
+
+	// Pixel shader
+	{
+		PixelShader ps;
+
+		u32 cBufSizes[] = {
+			{ sizeof(SolidColor::PSInitialize) },
+		};
+		ps = Renderer_CreatePixelShader(*s.renderer, "Solid Colored", Startup_GetShader(startup, StartupShader::SolidColored), cBufSizes);
+		LOG_IF(!ps, return false,
+			Severity::Error, "Failed to load built-in solid colored pixel shader");
+		Assert(ps == StandardPixelShader::SolidColored);
+
+		ps = Renderer_CreatePixelShader(*s.renderer, "Vertex Colored", Startup_GetShader(startup, StartupShader::VertexColored), {});
+		LOG_IF(!ps, return false,
+			Severity::Error, "Failed to load built-in vertex colored pixel shader");
+		Assert(ps == StandardPixelShader::VertexColored);
+
+		ps = Renderer_CreatePixelShader(*s.renderer, "Debug Coordinates", Startup_GetShader(startup, StartupShader::DebugCoordinates), {});
+		LOG_IF(!ps, return false,
+			Severity::Error, "Failed to load built-in vertex colored pixel shader");
+		Assert(ps == StandardPixelShader::DebugCoordinates);
+
+		ps = Renderer_CreatePixelShader(*s.renderer, "Composite", Startup_GetShader(startup, StartupShader::Composite), {});
+		LOG_IF(!ps, return false,
+			Severity::Error, "Failed to load composite pixel shader");
+		Assert(ps == StandardPixelShader::Composite);
+	}
+
+	// Post process shaders
+	{
 		u32 outlineCBufSizes[] = {
 			{ sizeof(Outline::PSPerPass) }
 		};
-		s.outlineShader = Renderer_LoadPixelShader(*s.renderer, "Outline", "Shaders/Outline.ps.cso", outlineCBufSizes);
+		s.outlineShader = Renderer_CreatePixelShader(*s.renderer, "Outline", Startup_GetShader(startup, StartupShader::Outline), outlineCBufSizes);
 		LOG_IF(!s.outlineShader, return false,
 			Severity::Error, "Failed to load outline pixel shader");
 
-		s.outlineCompositeShader = Renderer_LoadPixelShader(*s.renderer, "Outline Composite", "Shaders/Outline Composite.ps.cso", outlineCBufSizes);
+		s.outlineCompositeShader = Renderer_CreatePixelShader(*s.renderer, "Outline Composite", Startup_GetShader(startup, StartupShader::OutlineComposite), outlineCBufSizes);
 		LOG_IF(!s.outlineCompositeShader, return false,
 			Severity::Error, "Failed to load outline composite pixel shader");
 
-		s.depthToAlphaShader = Renderer_LoadPixelShader(*s.renderer, "Depth to Alpha", "Shaders/Depth to Alpha.ps.cso", {});
+		s.depthToAlphaShader = Renderer_CreatePixelShader(*s.renderer, "Depth to Alpha", Startup_GetShader(startup, StartupShader::DepthToAlpha), {});
 		LOG_IF(!s.depthToAlphaShader, return false,
 			Severity::Error, "Failed to load depth to alpha pixel shader");
 	}
 
-	// Built-in Sensors
+	return true;
+}
+
+static b8
+Startup_LoadBuiltinSensors(void* data)
+{
+	SimulationState& s = *(SimulationState*) data;
+
+	// NOTE: This is awkward because we store sensors inside sensor plugins. It might be nicer to
+	// pull sensors out so we can create a sensor here without a plugin at all.
+
+	Plugin& builtInPlugin = RegisterPlugin(s, {}, {});
+	builtInPlugin.language = PluginLanguage::Builtin;
+	Result<SensorPlugin*> sensorPlugin = LoadSensorPlugin(s, builtInPlugin, BuiltinSensorPlugin_GetPluginInfo);
+	Assert(sensorPlugin);
+
+	s.nullSensorHandle = sensorPlugin->sensors[0].handle;
+	return true;
+}
+
+static void
+Startup_AddPlugin(StartupState& startup, StringView directory, StringView fileName, PluginKind kind, b8 outOfProcess)
+{
+	SimulationState& s = *startup.s;
+	if (FindPlugin(s, directory, fileName)) return;
+
+	Plugin& plugin = RegisterPlugin(s, directory, fileName);
+	plugin.outOfProcess = outOfProcess;
+
+	StartupPlugin& startupPlugin = List_Append(startup.plugins);
+	startupPlugin.s      = &s;
+	startupPlugin.plugin = &plugin;
+	if (kind == PluginKind::Sensor)
+		startupPlugin.sensorPlugin = &AddSensorPlugin(s, plugin, nullptr);
+	else
+		startupPlugin.widgetPlugin = &AddWidgetPlugin(s, plugin);
+}
+
+// NOTE: Plugins come from the layout, or the default set if there isn't one. Lists are reserved up
+// front because jobs hold pointers into them.
+static void
+Startup_AddPlugins(StartupState& startup)
+{
+	SimulationState& s = *startup.s;
+
+	ByteSlice bytes = startup.layout.bytes;
+	if (bytes.length)
+	{
+		startup.layoutHeader = Layout_Validate(bytes);
+		LOG_IF(!startup.layoutHeader, IGNORE,
+			Severity::Warning, "Layout is corrupt or from a different version");
+	}
+
+	u32 pluginCount = startup.layoutHeader ? startup.layoutHeader->plugins.count : 2;
+	List_Reserve(startup.plugins, pluginCount);
+	List_Reserve(s.plugins,       s.plugins.length       + pluginCount);
+	List_Reserve(s.sensorPlugins, s.sensorPlugins.length + pluginCount);
+	List_Reserve(s.widgetPlugins, s.widgetPlugins.length + pluginCount);
+
+	if (startup.layoutHeader)
+	{
+		LayoutHeader&       header        = *startup.layoutHeader;
+		Slice<LayoutPlugin> layoutPlugins = Layout_GetSection<LayoutPlugin>(bytes, header.plugins);
+		for (u32 i = 0; i < layoutPlugins.length; i++)
+		{
+			LayoutPlugin& layoutPlugin = layoutPlugins[i];
+			StringView    directory    = Layout_GetString(bytes, header, layoutPlugin.directory);
+			StringView    fileName     = Layout_GetString(bytes, header, layoutPlugin.fileName);
+			Startup_AddPlugin(startup, directory, fileName, layoutPlugin.kind, layoutPlugin.outOfProcess);
+		}
+	}
+	else
+	{
+		Startup_AddPlugin(startup, DefaultSensorPluginDirectory, DefaultSensorPluginFileName, PluginKind::Sensor, false);
+		Startup_AddPlugin(startup, DefaultWidgetPluginDirectory, DefaultWidgetPluginFileName, PluginKind::Widget, false);
+	}
+}
+
+static b8
+Startup_LoadPlugin(void* data)
+{
+	StartupPlugin&     startupPlugin = *(StartupPlugin*) data;
+	PluginLoaderState& pluginLoader  = *startupPlugin.s->pluginLoader;
+
+	return startupPlugin.sensorPlugin
+		? LoadSensorPluginLibrary(pluginLoader, *startupPlugin.plugin, *startupPlugin.sensorPlugin)
+		: LoadWidgetPluginLibrary(pluginLoader, *startupPlugin.plugin, *startupPlugin.widgetPlugin);
+}
+
+// NOTE: Managed and out of process plugins are initialized on the main thread in
+// Startup_RegisterSensors instead
+static b8
+Startup_InitializeSensorPlugin(void* data)
+{
+	StartupPlugin& startupPlugin = *(StartupPlugin*) data;
+	Plugin&        plugin        = *startupPlugin.plugin;
+	if (plugin.outOfProcess || plugin.language != PluginLanguage::Native) return true;
+
+	startupPlugin.initializedOnWorker = true;
+	return InitializeSensorPlugin(*startupPlugin.s, *startupPlugin.sensorPlugin, &startupPlugin.deferredSensors);
+}
+
+static b8
+Startup_RegisterSensors(void* data)
+{
+	StartupPlugin&   startupPlugin = *(StartupPlugin*) data;
+	SimulationState& s             = *startupPlugin.s;
+	SensorPlugin&    sensorPlugin  = *startupPlugin.sensorPlugin;
+
+	if (!startupPlugin.initializedOnWorker)
+		return InitializeSensorPlugin(s, sensorPlugin);
+
+	List<SensorDesc> sensorDescs = {};
+	List_Reserve(sensorDescs, startupPlugin.deferredSensors.length);
+	defer { List_Free(sensorDescs); };
+
+	for (u32 i = 0; i < startupPlugin.deferredSensors.length; i++)
+	{
+		DeferredSensor& sensor = startupPlugin.deferredSensors[i];
+		SensorDesc&     desc   = List_Append(sensorDescs);
+		desc.name       = sensor.name;
+		desc.identifier = sensor.identifier;
+		desc.format     = sensor.format;
+	}
+
+	PluginContext context = {};
+	context.s            = &s;
+	context.sensorPlugin = &sensorPlugin;
+	context.success      = true;
+
+	RegisterSensors(context, sensorDescs);
+	return context.success;
+}
+
+static b8
+Startup_InitializeWidgetPlugin(void* data)
+{
+	StartupPlugin&   startupPlugin = *(StartupPlugin*) data;
+	SimulationState& s             = *startupPlugin.s;
+	Plugin&          plugin        = *startupPlugin.plugin;
+
+	b8 success = InitializeWidgetPlugin(s, *startupPlugin.widgetPlugin);
+	if (!success) return false;
+
+	if (plugin.language == PluginLanguage::Native)
+		WatchPluginDirectory(s, plugin);
+
+	return true;
+}
+
+// NOTE: Plugins whose jobs failed or were skipped are cleaned up the same way LoadSensorPlugin and
+// LoadWidgetPlugin do it
+static void
+Startup_FinishPlugin(StartupState& startup, StartupPlugin& startupPlugin)
+{
+	SimulationState& s      = *startup.s;
+	Plugin&          plugin = *startupPlugin.plugin;
+	defer { ToGUI_PluginStatesChanged(s, plugin); };
+
+	if (JobGraph_Succeeded(startup.graph, startupPlugin.lastJob)) return;
+
+	// NOTE: The failed entry is removed from its list so teardown only sees loaded plugins. The last
+	// entry moves into its place, so its handle and the StartupPlugin pointing at it are updated.
+	plugin.loadState = PluginLoadState::Broken;
+	if (startupPlugin.sensorPlugin)
+	{
+		SensorPlugin& sensorPlugin = *startupPlugin.sensorPlugin;
+
+		// Remove all sensors so they don't get used
+		RemoveSensorReferences(s, List_MemberSlice(sensorPlugin.sensors, &Sensor::handle));
+		TeardownSensorPlugin(sensorPlugin);
+		s.handleTable.Remove(sensorPlugin.handle);
+
+		u32           index = List_PointerToIndex(s.sensorPlugins, sensorPlugin);
+		SensorPlugin* last  = &List_GetLast(s.sensorPlugins);
+		List_RemoveFast(s.sensorPlugins, index);
+		InvalidateSensorBindings(s);
+		startupPlugin.sensorPlugin = nullptr;
+
+		if (index < s.sensorPlugins.length)
+		{
+			SensorPlugin& movedPlugin = s.sensorPlugins[index];
+			s.handleTable.Relocate(movedPlugin.handle, &movedPlugin);
+
+			for (u32 i = 0; i < startup.plugins.length; i++)
+				if (startup.plugins[i].sensorPlugin == last)
+					startup.plugins[i].sensorPlugin = &movedPlugin;
+		}
+	}
+	else
+	{
+		WidgetPlugin& widgetPlugin = *startupPlugin.widgetPlugin;
+
+		// Remove all widgets so they don't get used
+		TeardownWidgetPlugin(s, widgetPlugin);
+		s.handleTable.Remove(widgetPlugin.handle);
+
+		u32           index = List_PointerToIndex(s.widgetPlugins, widgetPlugin);
+		WidgetPlugin* last  = &List_GetLast(s.widgetPlugins);
+		List_RemoveFast(s.widgetPlugins, index);
+		startupPlugin.widgetPlugin = nullptr;
+
+		if (index < s.widgetPlugins.length)
+		{
+			WidgetPlugin& movedPlugin = s.widgetPlugins[index];
+			s.handleTable.Relocate(movedPlugin.handle, &movedPlugin);
+
+			for (u32 i = 0; i < startup.plugins.length; i++)
+				if (startup.plugins[i].widgetPlugin == last)
+					startup.plugins[i].widgetPlugin = &movedPlugin;
+		}
+	}
+}
+
+static b8
+Startup_RestoreLayout(void* data)
+{
+	StartupState&    startup = *(StartupState*) data;
+	SimulationState& s       = *startup.s;
+
+	if (startup.layoutHeader)
+		return RestoreLayout(s, startup.layout.bytes);
+
+	// NOTE: The default widget plugin may have failed to load
+	Plugin* plugin = FindPlugin(s, DefaultWidgetPluginDirectory, DefaultWidgetPluginFileName);
+	LOG_IF(!plugin, return false,
+		Severity::Warning, "Default widget plugin '%' isn't loaded", DefaultWidgetPluginFileName);
+
+	WidgetType* widgetType = FindWidgetType(s, plugin->handle, DefaultWidgetTypeName);
+	LOG_IF(!widgetType, return false,
+		Severity::Warning, "Default widget plugin '%' doesn't have a '%' widget",
+		DefaultWidgetPluginFileName, DefaultWidgetTypeName);
+
+	Slice<Widget> widgets = AddWidgets(s, *widgetType, DefaultWidgetCount);
+	for (u32 i = 0; i < widgets.length; i++)
 	{
-		// NOTE: This is awkward because we store sensors inside sensor plugins. It might be nicer to
-		// pull sensors out so we can create a sensor here without a plugin at all.
+		Widget& widget = widgets[i];
+		widget.position    = ((v2) s.renderSize) / 2.0f;
+		widget.position.y += (2.0f - (r32) i) * (widget.size.y + 3.0f);
+	}
+	return true;
+}
+
+static b8
+Startup_FinalizeRenderer(void* data)
+{
+	SimulationState& s = *(SimulationState*) data;
+	return Renderer_FinalizeResourceCreation(*s.renderer);
+}
 
-		Plugin& builtInPlugin = RegisterPlugin(s, {}, {});
-		builtInPlugin.language = PluginLanguage::Builtin;
-		Result<SensorPlugin*> sensorPlugin = LoadSensorPlugin(s, builtInPlugin, BuiltinSensorPlugin_GetPluginInfo);
-		Assert(sensorPlugin);
+static void
+Startup_Free(StartupState& startup)
+{
+	for (u32 i = 0; i < ArrayLength(startup.shaders); i++)
+		Platform_UnmapFile(startup.shaders[i].bytes);
+	Platform_UnmapFile(startup.layout.bytes);
 
-		s.nullSensorHandle = sensorPlugin->sensors[0].handle;
+	for (u32 i = 0; i < startup.plugins.length; i++)
+	{
+		StartupPlugin& startupPlugin = startup.plugins[i];
+		for (u32 j = 0; j < startupPlugin.deferredSensors.length; j++)
+		{
+			DeferredSensor& sensor = startupPlugin.deferredSensors[j];
+			String_Free(sensor.name);
+			String_Free(sensor.identifier);
+			String_Free(sensor.format);
+		}
+		List_Free(startupPlugin.deferredSensors);
 	}
+	List_Free(startup.plugins);
+
+	JobGraph_Free(startup.graph);
+	Platform_DestroyWorkQueue(startup.queue);
+	startup = {};
+}
+
+// -------------------------------------------------------------------------------------------------
+
+b8
+Simulation_Initialize(
+	SimulationState&   s,
+	PluginLoaderState& pluginLoader,
+	RendererState&     renderer,
+	FT232HState&       ft232h,
+	ILI9341State&      ili9341)
+{
+	s.pluginLoader = &pluginLoader;
+	s.renderer     = &renderer;
+	s.ft232h       = &ft232h;
+	s.ili9341      = &ili9341;
+	s.startTime    = Platform_GetTicks();
+	s.renderSize   = { 320, 240 };
+
+	s.guiSensorInterval  = GUISensorInterval;
+	s.guiSensorThreshold = GUISensorThreshold;
+
+	s.lcdPixelFormat = PixelFormat::RGB565;
+	s.lcdDither      = Dither::Ordered;
+
+	FrameBudget_Initialize(s.frameBudget, 1000.0f / 60.0f);
+	s.sensorLastReport = Platform_GetTicks();
+	s.ft232hLastReport = Platform_GetTicks();
+
+	s.outlinePSPerPassBlur[0].textureSize   = s.renderSize;
+	s.outlinePSPerPassBlur[0].blurDirection = v2{ 1.0f, 0.0f };
+	s.outlinePSPerPassBlur[1].textureSize   = s.renderSize;
+	s.outlinePSPerPassBlur[1].blurDirection = v2{ 0.0f, 1.0f };
 
-	// DEBUG: Testing
+	s.outlinePSPerPassSelected.outlineColor = Color128(0, 122, 204, 255);
+	s.outlinePSPerPassHovered.outlineColor  = Color128(28, 151, 234, 255);
+
+	List_Reserve(s.plugins, 16);
+	List_Reserve(s.handleTable.elements, 64);
+	List_Reserve(s.sensorPlugins, 8);
+	List_Reserve(s.widgetPlugins, 8);
+	List_Reserve(s.guiSensorHandles, 64);
+	List_Reserve(s.guiSensorValues, 64);
+	List_Reserve(s.widgetSensorValues, 64);
+
+	// Setup Camera
+	ResetCamera(s);
+
+	StartupState startup = {};
+	startup.s = &s;
+	defer { Startup_Free(startup); };
+
+	// NOTE: The main thread runs jobs too, so one fewer worker than there are processors
+	u32 threadCount = Clamp(Platform_GetProcessorCount(), 2u, 9u) - 1;
+	b8 success = Platform_CreateWorkQueue(threadCount, startup.queue);
+	LOG_IF(!success, IGNORE,
+		Severity::Warning, "Failed to create startup work queue. Starting up on a single thread.");
+	startup.graph.queue = success ? &startup.queue : nullptr;
+
+	JobGraph& graph = startup.graph;
+
+	// Pass 1: Plugin loader, built-in assets, and the layout
 	{
-		Plugin& ohmPlugin = RegisterPlugin(s, "Sensor Plugins\\OpenHardwareMonitor", "Sensor.OpenHardwareMonitor.dll");
-		Result<SensorPlugin*> sensorPlugin = LoadSensorPlugin(s, ohmPlugin);
-		if (!sensorPlugin) return false;
+		JobGraph_Add(graph, "Plugin Loader", (u32) StartupStage::PluginLoader, Startup_InitializePluginLoader, &s);
+
+		u32 rendererJob = JobGraph_Add(graph, "Renderer Resources", (u32) StartupStage::Renderer, Startup_CreateRendererResources, &s, true);
+		u32 shadersJob  = JobGraph_Add(graph, "Register Shaders", (u32) StartupStage::Renderer, Startup_RegisterShaders, &startup, true);
+		JobGraph_AddDependency(graph, shadersJob, rendererJob);
+
+		for (u32 i = 0; i < ArrayLength(startup.shaders); i++)
+		{
+			StartupFile& shader = startup.shaders[i];
+			shader.path     = StartupShader_Path((StartupShader) i);
+			shader.required = true;
+
+			u32 readJob = JobGraph_Add(graph, shader.path, (u32) StartupStage::Shaders, Startup_ReadFile, &shader);
+			JobGraph_AddDependency(graph, shadersJob, readJob);
+		}
+
+		startup.layout.path = LayoutPath;
+		JobGraph_Add(graph, LayoutPath, (u32) StartupStage::Layout, Startup_ReadFile, &startup.layout);
 
-		Plugin& filledBarPlugin = RegisterPlugin(s, "Widget Plugins\\Filled Bar", "Widget.FilledBar.dll");
-		Result<WidgetPlugin*> widgetPlugin = LoadWidgetPlugin(s, filledBarPlugin);
-		if (!widgetPlugin) return false;
+		JobGraph_Add(graph, "Built-in Sensors", (u32) StartupStage::PluginInitialization, Startup_LoadBuiltinSensors, &s, true);
 
+		success = JobGraph_Run(graph);
+		if (!success) return false;
+	}
+
+	// Pass 2: Plugins
+	{
+		Startup_AddPlugins(startup);
 
-		u32 dummyWidgetCount = 6;
-		WidgetType& widgetType = widgetPlugin->widgetTypes[0];
-		Slice<Widget> widgets = AddWidgets(s, widgetType, dummyWidgetCount);
-		for (u32 i = 0; i < widgets.length; i++)
+		for (u32 i = 0; i < startup.plugins.length; i++)
 		{
-			Widget& widget = widgets[i];
-			widget.position    = ((v2) s.renderSize) / 2.0f;
-			widget.position.y += (2.0f - (r32) i) * (widget.size.y + 3.0f);
+			StartupPlugin& startupPlugin = startup.plugins[i];
+			StringView     name          = startupPlugin.plugin->fileName;
+
+			u32 loadJob = JobGraph_Add(graph, name, (u32) StartupStage::PluginLoading, Startup_LoadPlugin, &startupPlugin);
+			if (startupPlugin.sensorPlugin)
+			{
+				u32 initializeJob = JobGraph_Add(graph, name, (u32) StartupStage::PluginInitialization, Startup_InitializeSensorPlugin, &startupPlugin);
+				u32 registerJob   = JobGraph_Add(graph, name, (u32) StartupStage::PluginInitialization, Startup_RegisterSensors, &startupPlugin, true);
+				JobGraph_AddDependency(graph, initializeJob, loadJob);
+				JobGraph_AddDependency(graph, registerJob, initializeJob);
+				startupPlugin.lastJob = registerJob;
+			}
+			else
+			{
+				u32 initializeJob = JobGraph_Add(graph, name, (u32) StartupStage::PluginInitialization, Startup_InitializeWidgetPlugin, &startupPlugin, true);
+				JobGraph_AddDependency(graph, initializeJob, loadJob);
+				startupPlugin.lastJob = initializeJob;
+			}
 		}
+
+		// NOTE: Plugins that fail are logged and removed by Startup_FinishPlugin. It isn't fatal.
+		JobGraph_Run(graph);
+
+		for (u32 i = 0; i < startup.plugins.length; i++)
+			Startup_FinishPlugin(startup, startup.plugins[i]);
 	}
 
 	// Create a GUI Pipe
 	{
 		// TODO: Ensure there's only a single connection
-		PipeResult result = Platform_CreatePipeServer("LCDHardwareMonitor GUI Pipe", s.guiConnection.pipe);
+		PipeResult result = Platform_CreatePipeServer(GUIPipeName, s.guiConnection.pipe, GUIPipeTransport);
 		LOG_IF(result == PipeResult::UnexpectedFailure, return false,
 			Severity::Error, "Failed to create pipe for GUI communication");
 	}
 
-	success = Renderer_FinalizeResourceCreation(*s.renderer);
-	if (!success) return false;
+	// Pass 3: Layout and renderer finalization
+	{
+		// NOTE: A layout that fails to restore leaves an empty display, which isn't fatal. Finalizing
+		// doesn't depend on it for that reason, but it's still added last so it runs last.
+		JobGraph_Add(graph, "Restore Layout", (u32) StartupStage::Layout, Startup_RestoreLayout, &startup, true);
+		u32 finalizeJob = JobGraph_Add(graph, "Finalize Renderer", (u32) StartupStage::Renderer, Startup_FinalizeRenderer, &s, true);
+
+		JobGraph_Run(graph);
+		if (!JobGraph_Succeeded(graph, finalizeJob)) return false;
+	}
+
+	StringView stageNames[(u32) StartupStage::Count] = {};
+	for (u32 i = 1; i < ArrayLength(stageNames); i++)
+		stageNames[i] = StartupStage_Name((StartupStage) i);
+
+	JobGraph_LogStages(graph, stageNames);
+	LOG(Severity::Info, "Startup took % ms on % threads",
+		Platform_GetElapsedMilliseconds(s.startTime), startup.queue.threadCount + 1);
 
 	return true;
 }
@@ -1944,8 +3916,12 @@ void
 Simulation_Update(SimulationState& s)
 {
 	s.currentTime = Platform_GetElapsedSeconds(s.startTime);
+	FrameBudget_BeginFrame(s.frameBudget);
+
+	UpdatePluginWatches(s);
 
 	// GUI Communication
+	FrameBudget_BeginPhase(s.frameBudget, FramePhase::GUIReceive);
 	ConnectionState& guiCon = s.guiConnection;
 	while (!guiCon.failure)
 	{
@@ -1962,52 +3938,34 @@ Simulation_Update(SimulationState& s)
 		if (guiCon.pipe.state != PipeState::Connected) break;
 
 		// Receive
-		Bytes bytes = {};
-		defer { List_Free(bytes); };
+		// NOTE: Each message is held until the next one arrives so a burst of messages that
+		// supersede each other only gets handled once.
+		Bytes bytes   = {};
+		Bytes pending = {};
+		defer {
+			List_Free(bytes);
+			List_Free(pending);
+		};
 
-		i64 startTicks = Platform_GetTicks();
-		while (MessageTimeLeft(startTicks))
+		while (FrameBudget_TimeLeft(s.frameBudget))
 		{
 			b8 success = ReceiveMessage(guiCon, bytes);
 			if (!success) break;
 
-			#define HANDLE_MESSAGE(Type) \
-				case IdOf<FromGUI::Type>: \
-				{ \
-					using Type = FromGUI::Type; \
-					DeserializeMessage<Type>(bytes); \
-					Type& message = (Type&) bytes[0]; \
-					FromGUI_##Type(s, message); \
-					break; \
-				}
-
-			Message::Header& header = (Message::Header&) bytes[0];
-			switch (header.id)
-			{
-				default:
-				case IdOf<Message::Null>:
-					Assert(false);
-					break;
+			if (pending.length != 0 && !FromGUI_Supersedes(bytes, pending))
+				FromGUI_HandleMessage(s, pending);
 
-				HANDLE_MESSAGE(TerminateSimulation)
-				HANDLE_MESSAGE(MouseMove)
-				HANDLE_MESSAGE(SelectHovered)
-				HANDLE_MESSAGE(BeginMouseLook)
-				HANDLE_MESSAGE(EndMouseLook)
-				HANDLE_MESSAGE(ResetCamera)
-				HANDLE_MESSAGE(SetPluginLoadStates)
-				HANDLE_MESSAGE(DragDrop)
-				HANDLE_MESSAGE(AddWidget)
-				HANDLE_MESSAGE(RemoveWidget)
-				HANDLE_MESSAGE(RemoveSelectedWidgets)
-				HANDLE_MESSAGE(BeginDragSelection)
-				HANDLE_MESSAGE(EndDragSelection)
-				HANDLE_MESSAGE(SetWidgetSelection)
-			}
+			Bytes received = bytes;
+			bytes   = pending;
+			pending = received;
 		}
+		if (pending.length != 0)
+			FromGUI_HandleMessage(s, pending);
 
 		// Send
-		while (MessageTimeLeft(startTicks))
+		// NOTE: Unsent messages stay queued for the next frame
+		FrameBudget_BeginPhase(s.frameBudget, FramePhase::GUISend);
+		while (FrameBudget_TimeLeft(s.frameBudget))
 		{
 			b8 success = SendMessage(guiCon);
 			if (!success) break;
@@ -2019,30 +3977,17 @@ Simulation_Update(SimulationState& s)
 	// TODO: Only update plugins that are actually being used
 
 	// Update Sensors
+	FrameBudget_BeginPhase(s.frameBudget, FramePhase::Sensors);
 	{
-		PluginContext context = {};
-		context.s = &s;
-
-		SensorPluginAPI::Update api = {};
-		api.RegisterSensors   = RegisterSensors;
-		api.UnregisterSensors = UnregisterSensors;
+		SensorSchedule_Update(s);
 
-		for (u32 i = 0; i < s.sensorPlugins.length; i++)
-		{
-			SensorPlugin& sensorPlugin = s.sensorPlugins[i];
-
-			// TODO: try/catch?
-			if (sensorPlugin.functions.Update)
-			{
-				context.sensorPlugin = &sensorPlugin;
-				context.success      = true;
-
-				api.sensors = sensorPlugin.sensors;
-				sensorPlugin.functions.Update(context, api);
-			}
-		}
+		// NOTE: Changed values accumulate until there's time to send them
+		if (FrameBudget_TimeLeft(s.frameBudget))
+			ToGUI_SensorValuesChanged(s);
 	}
 
+	FrameBudget_BeginPhase(s.frameBudget, FramePhase::Render);
+
 	Renderer_PushRenderTarget(*s.renderer, StandardRenderTarget::Main);
 	Renderer_PushDepthBuffer(*s.renderer, StandardDepthBuffer::Main);
 	Renderer_ClearRenderTarget(*s.renderer, Colors128::Clear);
@@ -2051,15 +3996,9 @@ Simulation_Update(SimulationState& s)
 
 	// Update Widgets
 	{
-		// TODO: How sensor values propagate to widgets is an open question. Does
-		// the application spin through the widgets and update the values (Con:
-		// iterating over the list twice. Con: Lots of sensor lookups)? Do we
-		// store a map from sensors to widgets that use them and update widgets
-		// when the sensor value changes (Con: complexity maybe)? Do we store a
-		// pointer in widgets to the sensor value (Con: Have to patch up the
-		// pointer when sensors resize) (could be a relative pointer so update
-		// happens on a single base pointer) (Con: drawing likely needs access to
-		// the full sensor)?
+		// NOTE: Sensor values are gathered into a dense slice parallel to each widget type's widgets
+		// so plugins index values directly instead of looking up every sensor. GetSensor is still
+		// available when a widget needs the rest of the sensor (e.g. text).
 
 		PluginContext context = {};
 		context.s = &s;
@@ -2068,7 +4007,6 @@ Simulation_Update(SimulationState& s)
 
 		WidgetAPI::Update widgetAPI = {};
 		widgetAPI.t                       = s.currentTime;
-		widgetAPI.sensors                 = s.sensorPlugins[0].sensors;
 		widgetAPI.GetSensor               = GetSensor;
 		widgetAPI.GetViewMatrix           = GetViewMatrix;
 		widgetAPI.GetProjectionMatrix     = GetProjectionMatrix;
@@ -2106,6 +4044,8 @@ Simulation_Update(SimulationState& s)
 				widgetAPI.widgets                = widgetType.widgets;
 				widgetAPI.widgetsUserData        = widgetType.widgetsUserData;
 				widgetAPI.widgetsUserData.stride = widgetType.userDataSize;
+				widgetAPI.sensorValues           = GatherSensorValues(s, widgetType, 0, widgetType.widgets.length);
+				widgetAPI.wvps                   = GatherWidgetTransforms(s, widgetType);
 
 				// TODO: try/catch?
 				widgetType.Update(context, widgetAPI);
@@ -2287,6 +4227,7 @@ Simulation_Update(SimulationState& s)
 	Renderer_Render(*s.renderer);
 
 	// Hardware Communication
+	FrameBudget_BeginPhase(s.frameBudget, FramePhase::Transmit);
 	{
 		if (FT232H_HasError(*s.ft232h))
 		{
@@ -2345,9 +4286,10 @@ Simulation_Update(SimulationState& s)
 					bytes.length = 0;
 				}
 
+				FT232H_BeginProgram(*s.ft232h);
 				FT232H_SetCS(*s.ft232h, Signal::Low);
 				ILI9341_BeginDrawFrames(*s.ili9341);
-				FT232H_Flush(*s.ft232h);
+				FT232H_EndProgram(*s.ft232h);
 			}
 			else
 			{
@@ -2357,13 +4299,23 @@ Simulation_Update(SimulationState& s)
 
 		if (s.ft232hInitialized)
 		{
-			// TODO: Handle pixel and row strides
-			CPUTextureBytes frame = Renderer_GetCPUTextureBytes(*s.renderer, s.renderTargetCPUCopy);
-			Assert(frame.pixelStride == sizeof(u16));
-			Assert(frame.rowStride == frame.pixelStride * frame.size.x);
-			ILI9341_DrawFrame(*s.ili9341, frame.bytes);
+			PixelConverter& converter = s.lcdConverter;
+			if (converter.format != s.lcdPixelFormat || converter.dither != s.lcdDither)
+				PixelConverter_Initialize(converter, s.lcdPixelFormat, s.lcdDither);
+
+			CPUTextureBytes frame  = Renderer_GetCPUTextureBytes(*s.renderer, s.renderTargetCPUCopy);
+			ByteSlice       pixels = Pixels_Convert(converter, frame, s.lcdFrame);
+
+			FT232H_BeginProgram(*s.ft232h);
+			ILI9341_ChangePixelFormat(*s.ili9341, s.lcdPixelFormat);
+			ILI9341_DrawFrame(*s.ili9341, pixels);
+			FT232H_EndProgram(*s.ft232h);
 		}
 	}
+
+	FrameBudget_EndFrame(s.frameBudget);
+	SensorSchedule_Report(s);
+	Hardware_Report(s);
 }
 
 void
@@ -2375,10 +4327,16 @@ Simulation_Teardown(SimulationState& s)
 	// case. (We still need to teardown plugins though to give them a chance to
 	// save changes and whatnot.)
 
+	SaveLayout(s, LayoutPath);
+
 	ConnectionState& guiCon = s.guiConnection;
 	if (guiCon.pipe.state == PipeState::Connected)
 		OnTeardown(guiCon);
 	Connection_Teardown(guiCon);
+	List_Free(s.guiSensorHandles);
+	List_Free(s.guiSensorValues);
+	List_Free(s.widgetSensorValues);
+	HashMap_Free(s.sensorsByIdentifier);
 
 	if (s.ft232hInitialized)
 	{
@@ -2386,6 +4344,7 @@ Simulation_Teardown(SimulationState& s)
 		ILI9341_Teardown(*s.ili9341);
 		FT232H_Teardown(*s.ft232h);
 	}
+	List_Free(s.lcdFrame);
 
 	for (u32 i = 0; i < s.widgetPlugins.length; i++)
 	{
@@ -2394,7 +4353,7 @@ Simulation_Teardown(SimulationState& s)
 	}
 	List_Free(s.widgetPlugins);
 
-	for (u32 i = 0; i < s.widgetPlugins.length; i++)
+	for (u32 i = 0; i < s.sensorPlugins.length; i++)
 	{
 		SensorPlugin& sensorPlugin = s.sensorPlugins[i];
 		UnloadSensorPlugin(s, sensorPlugin);
@@ -2408,6 +4367,14 @@ Simulation_Teardown(SimulationState& s)
 	}
 	List_Free(s.plugins);
 
+	for (u32 i = 0; i < s.pluginWatches.length; i++)
+		Platform_DestroyDirectoryWatch(s.pluginWatches[i]);
+	List_Free(s.pluginWatches);
+
+	for (u32 i = 0; i < s.pluginChanges.length; i++)
+		String_Free(s.pluginChanges[i]);
+	List_Free(s.pluginChanges);
+
 	PluginLoader_Teardown(*s.pluginLoader);
 
 	s = {};
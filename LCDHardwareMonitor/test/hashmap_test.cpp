@@ -0,0 +1,266 @@
+#include "LHMAPI.h"
+
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+
+#include "platform.h"
+
+#include "platform_linux.hpp"
+
+// NOTE: Runs random operations against HashMap and std::unordered_map and checks they agree after
+// every one. Built with and without LHM_SIMD so both control byte paths are covered. --bench times
+// lookups by identifier against a linear scan, the way sensors were found before the map.
+// Usage: hashmap_test [operations]
+//        hashmap_test --bench
+
+static u64 rngState = 0x9E37'79B9'7F4A'7C15;
+
+static u32
+Random(u32 count)
+{
+	// NOTE: xorshift64*
+	rngState ^= rngState >> 12;
+	rngState ^= rngState << 25;
+	rngState ^= rngState >> 27;
+	return (u32) ((rngState * 0x2545'F491'4F6C'DD1D) >> 32) % count;
+}
+
+static String
+MakeIdentifier(u32 i)
+{
+	return String_Format("/hwmon/chip%/device%/temp%", i % 7, i / 7 % 13, i);
+}
+
+static void
+FreeIdentifiers(List<String>& identifiers)
+{
+	for (u32 i = 0; i < identifiers.length; i++)
+		String_Free(identifiers[i]);
+	List_Free(identifiers);
+}
+
+// -------------------------------------------------------------------------------------------------
+// Equivalence
+
+template<typename K, typename V, typename Reference, typename KeyFn, typename RefKeyFn>
+static b8
+Check(HashMap<K, V>& map, Reference& reference, u32 keyCount, KeyFn key, RefKeyFn refKey)
+{
+	LOG_IF(map.length != reference.size(), return false,
+		Severity::Error, "Length is %, expected %", map.length, (u32) reference.size());
+
+	for (u32 i = 0; i < keyCount; i++)
+	{
+		V* value = HashMap_Find(map, key(i));
+		auto it = reference.find(refKey(i));
+
+		b8 found = it != reference.end();
+		LOG_IF((value != nullptr) != found, return false,
+			Severity::Error, "Key % found: %, expected %", i, value != nullptr, found);
+		LOG_IF(found && *value != it->second, return false,
+			Severity::Error, "Key % has value %, expected %", i, *value, it->second);
+	}
+	return true;
+}
+
+// NOTE: key and refKey map an index in [0, keyCount) to the same key for each map. Every operation
+// checks its own key and a full check runs every checkInterval operations.
+template<typename K, typename RK, typename KeyFn, typename RefKeyFn>
+static b8
+Test_Equivalence(StringView label, u32 operations, u32 keyCount, KeyFn key, RefKeyFn refKey)
+{
+	HashMap<K, u32> map = {};
+	defer { HashMap_Free(map); };
+
+	std::unordered_map<RK, u32> reference;
+
+	const u32 checkInterval = 100'000;
+
+	List<K>   rangeKeys   = {};
+	List<u32> rangeValues = {};
+	defer
+	{
+		List_Free(rangeKeys);
+		List_Free(rangeValues);
+	};
+
+	for (u32 op = 0; op < operations; op++)
+	{
+		u32 i     = Random(keyCount);
+		u32 value = Random(u32Max);
+
+		switch (Random(16))
+		{
+			// Set
+			default:
+			{
+				b8 added    = HashMap_Set(map, key(i), value);
+				b8 expected = reference.find(refKey(i)) == reference.end();
+				reference[refKey(i)] = value;
+				LOG_IF(added != expected, return false,
+					Severity::Error, "% op %: Set returned %, expected %", label, op, added, expected);
+				break;
+			}
+
+			// Remove
+			case 0: case 1: case 2: case 3: case 4:
+			{
+				b8 removed  = HashMap_Remove(map, key(i));
+				b8 expected = reference.erase(refKey(i)) != 0;
+				LOG_IF(removed != expected, return false,
+					Severity::Error, "% op %: Remove returned %, expected %", label, op, removed, expected);
+				break;
+			}
+
+			// SetRange
+			case 5:
+			{
+				u32 count = Random(64);
+				u32 expected = 0;
+				List_Clear(rangeKeys);
+				List_Clear(rangeValues);
+				for (u32 j = 0; j < count; j++)
+				{
+					u32 k = Random(keyCount);
+					List_Append(rangeKeys, key(k));
+					List_Append(rangeValues, value + j);
+					expected += reference.find(refKey(k)) == reference.end();
+					reference[refKey(k)] = value + j;
+				}
+
+				// NOTE: A key repeated within one range is only added once
+				u32 added = HashMap_SetRange(map, (Slice<K>) rangeKeys, (Slice<u32>) rangeValues);
+				LOG_IF(added != expected, return false,
+					Severity::Error, "% op %: SetRange added %, expected %", label, op, added, expected);
+				break;
+			}
+
+			// Clear, rarely, so the map gets large and collects tombstones in between
+			case 6:
+			{
+				if (Random(1000) != 0) break;
+				HashMap_Clear(map);
+				reference.clear();
+				break;
+			}
+		}
+
+		u32* found = HashMap_Find(map, key(i));
+		auto it = reference.find(refKey(i));
+		b8 expected = it != reference.end();
+		LOG_IF((found != nullptr) != expected || (found && *found != it->second), return false,
+			Severity::Error, "% op %: Find disagrees for key %", label, op, i);
+
+		if (op % checkInterval == checkInterval - 1)
+		{
+			b8 success = Check(map, reference, keyCount, key, refKey);
+			LOG_IF(!success, return false,
+				Severity::Error, "% op %: Full check failed", label, op);
+		}
+	}
+
+	b8 success = Check(map, reference, keyCount, key, refKey);
+	LOG_IF(!success, return false, Severity::Error, "% final check failed", label);
+
+	Platform_Print("LHM_SIMD %: % ops on % keys match std::unordered_map\n", LHM_SIMD, operations, label);
+	return true;
+}
+
+static b8
+Test_All(u32 operations)
+{
+	// NOTE: Few enough keys that sets and removes keep hitting existing entries
+	const u32 keyCount = 20'000;
+
+	List<String> identifiers = {};
+	defer { FreeIdentifiers(identifiers); };
+	for (u32 i = 0; i < keyCount; i++)
+		List_Append(identifiers, MakeIdentifier(i));
+
+	b8 success = true;
+	success = success && Test_Equivalence<StringView, std::string>("StringView", operations, keyCount,
+		[&](u32 i) { return (StringView) identifiers[i]; },
+		[&](u32 i) { return std::string(identifiers[i].data, identifiers[i].length); });
+	success = success && Test_Equivalence<u64, u64>("u64", operations, keyCount,
+		[&](u32 i) { return (u64) i * 0x1'0000'0001; },
+		[&](u32 i) { return (u64) i * 0x1'0000'0001; });
+	return success;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Benchmark
+
+static void
+Benchmark()
+{
+	const u32 counts[] = { 100, 1'000, 10'000, 100'000 };
+	const u32 lookups  = 200'000;
+
+	Platform_Print("LHM_SIMD %\n", LHM_SIMD);
+	Platform_Print("  sensors  hash find (ns)  linear find (ns)\n");
+	for (u32 c = 0; c < ArrayLength(counts); c++)
+	{
+		u32 count = counts[c];
+
+		List<String> identifiers = {};
+		defer { FreeIdentifiers(identifiers); };
+		for (u32 i = 0; i < count; i++)
+			List_Append(identifiers, MakeIdentifier(i));
+
+		HashMap<StringView, u32> map = {};
+		defer { HashMap_Free(map); };
+		for (u32 i = 0; i < count; i++)
+			HashMap_Set(map, (StringView) identifiers[i], i);
+
+		// NOTE: Lookups use separate copies of the keys, like identifiers read from a layout
+		List<String> queries = {};
+		defer { FreeIdentifiers(queries); };
+		for (u32 i = 0; i < 1024; i++)
+			List_Append(queries, MakeIdentifier(Random(count)));
+
+		u64 sink = 0;
+		i64 startTicks = Platform_GetTicks();
+		for (u32 i = 0; i < lookups; i++)
+			sink += *HashMap_Find(map, (StringView) queries[i & 1023]);
+		r64 hashNs = 1e9 * Platform_GetElapsedSeconds(startTicks) / lookups;
+
+		// NOTE: Linear lookups are slow enough at 100k that fewer are needed for a stable number
+		u32 linearLookups = Max(lookups / count * 100, 100u);
+		startTicks = Platform_GetTicks();
+		for (u32 i = 0; i < linearLookups; i++)
+		{
+			StringView query = queries[i & 1023];
+			for (u32 j = 0; j < identifiers.length; j++)
+			{
+				if (!String_Equal(identifiers[j], query)) continue;
+				sink += j;
+				break;
+			}
+		}
+		r64 linearNs = 1e9 * Platform_GetElapsedSeconds(startTicks) / linearLookups;
+
+		Platform_Print("  %  %  %  (sink %)\n", count, hashNs, linearNs, sink);
+	}
+}
+
+i32
+main(i32 argc, c8* argv[])
+{
+	b8 success = Platform_InitializeLog(LogOverflow::Block);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize logging");
+	defer { Platform_TeardownLog(); };
+
+	StringView mode = argc > 1 ? String_ViewCString(argv[1]) : StringView {};
+	if (String_Equal(mode, "--bench"))
+	{
+		Benchmark();
+		return 0;
+	}
+
+	u32 operations = argc > 1 ? (u32) atoi(argv[1]) : 2'000'000;
+	LOG_IF(operations == 0, return -1, Severity::Fatal, "Usage: hashmap_test [operations] | --bench");
+
+	success = Test_All(operations);
+	return success ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+#include "LHMAPI.h"
+
+#include <stdio.h>
+
+#include "platform.h"
+
+#include "platform_linux.hpp"
+
+// NOTE: Built once per LHM_SIMD level. The scalar build writes its results to a file and the SIMD
+// builds compare theirs against it, since one TU can only see one version of the math.
+// Usage: math_test --write <file>
+//        math_test --compare <file>
+//        math_test --bench
+
+// NOTE: ctest treats this as skipped rather than failed
+const i32 SkipExitCode = 77;
+
+const u32 InputCount = 8192;
+const r32 Tolerance  = 1e-5f;
+
+struct MathInputs
+{
+	List<Matrix> matrices;
+	List<v4>     vectors;
+};
+
+struct MathResults
+{
+	List<r32> values;
+};
+
+// NOTE: Fixed seed so every build sees the same inputs
+static u32 rngState = 0x1234'5678;
+
+static r32
+Random(r32 min, r32 max)
+{
+	rngState = rngState * 1664525u + 1013904223u;
+	r32 unit = (r32) (rngState >> 8) / (r32) (1u << 24);
+	return min + unit * (max - min);
+}
+
+static void
+Inputs_Generate(MathInputs& inputs)
+{
+	List_Reserve(inputs.matrices, InputCount);
+	List_Reserve(inputs.vectors, InputCount);
+	for (u32 i = 0; i < InputCount; i++)
+	{
+		Matrix& m = List_Append(inputs.matrices);
+		for (u32 j = 0; j < ArrayLength(m.raw); j++)
+			m.raw[j] = Random(-4.0f, 4.0f);
+
+		v4& v = List_Append(inputs.vectors);
+		v = { Random(-4.0f, 4.0f), Random(-4.0f, 4.0f), Random(-4.0f, 4.0f), Random(-4.0f, 4.0f) };
+	}
+}
+
+static void
+Inputs_Free(MathInputs& inputs)
+{
+	List_Free(inputs.matrices);
+	List_Free(inputs.vectors);
+}
+
+static void
+Results_Append(MathResults& results, const Matrix& m)
+{
+	for (u32 i = 0; i < ArrayLength(m.raw); i++)
+		List_Append(results.values, m.raw[i]);
+}
+
+static void
+Results_Append(MathResults& results, v4 v)
+{
+	for (u32 i = 0; i < ArrayLength(v.arr); i++)
+		List_Append(results.values, v.arr[i]);
+}
+
+// NOTE: Every function with a SIMD path, in a fixed order
+static void
+Results_Compute(MathResults& results, MathInputs& inputs)
+{
+	u32 count = inputs.matrices.length;
+	Matrix& rhs = inputs.matrices[0];
+
+	for (u32 i = 0; i < count; i++)
+		Results_Append(results, inputs.matrices[i] * inputs.matrices[(i + 1) % count]);
+
+	for (u32 i = 0; i < count; i++)
+		Results_Append(results, inputs.vectors[i] * inputs.matrices[i]);
+
+	for (u32 i = 0; i < count; i++)
+		Results_Append(results, InvertRT(inputs.matrices[i]));
+
+	List<Matrix> matrices = {};
+	List<v4>     vectors  = {};
+	defer
+	{
+		List_Free(matrices);
+		List_Free(vectors);
+	};
+	List_AppendRange(matrices, count);
+	List_AppendRange(vectors, count);
+
+	MultiplyBatch(matrices.data, inputs.matrices.data, rhs, count);
+	for (u32 i = 0; i < count; i++)
+		Results_Append(results, matrices[i]);
+
+	TransformBatch(vectors.data, inputs.vectors.data, rhs, count);
+	for (u32 i = 0; i < count; i++)
+		Results_Append(results, vectors[i]);
+}
+
+static b8
+Results_Compare(MathResults& results, Bytes& reference)
+{
+	LOG_IF(reference.length != results.values.length * sizeof(r32), return false,
+		Severity::Error, "Reference has % bytes, expected %", reference.length, results.values.length * (u32) sizeof(r32));
+
+	r32* expected = (r32*) reference.data;
+
+	u32 mismatches = 0;
+	r32 worstError = 0.0f;
+	for (u32 i = 0; i < results.values.length; i++)
+	{
+		// NOTE: Relative for large values. FMA and different summation orders round differently.
+		r32 error = Abs(results.values[i] - expected[i]) / Max(1.0f, Abs(expected[i]));
+		worstError = Max(worstError, error);
+		if (!(error <= Tolerance)) mismatches++;
+	}
+
+	Platform_Print("LHM_SIMD %: % values, worst relative error %\n", LHM_SIMD, results.values.length, worstError);
+	LOG_IF(mismatches, return false,
+		Severity::Error, "% values differ from the scalar results by more than %", mismatches, Tolerance);
+
+	return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Benchmark
+
+template<typename Fn>
+static void
+Benchmark_Run(StringView label, u32 iterations, u32 opsPerIteration, Fn fn)
+{
+	i64 startTicks = Platform_GetTicks();
+	for (u32 i = 0; i < iterations; i++)
+		fn(i);
+	r32 seconds = Platform_GetElapsedSeconds(startTicks);
+
+	Platform_Print("  %: % ns\n", label, 1e9 * seconds / ((r64) iterations * opsPerIteration));
+}
+
+static void
+Benchmark(MathInputs& inputs)
+{
+	const u32 iterations = 10'000'000;
+	const u32 mask       = InputCount - 1;
+	static_assert((InputCount & mask) == 0);
+
+	List<Matrix> matrices = {};
+	List<v4>     vectors  = {};
+	defer
+	{
+		List_Free(matrices);
+		List_Free(vectors);
+	};
+	List_AppendRange(matrices, InputCount);
+	List_AppendRange(vectors, InputCount);
+
+	// NOTE: Results are summed and printed so the compiler can't drop the work
+	Matrix& rhs = inputs.matrices[0];
+	r32 sink = 0.0f;
+
+	Platform_Print("LHM_SIMD %\n", LHM_SIMD);
+	Benchmark_Run("Matrix * Matrix", iterations, 1, [&](u32 i) {
+		Matrix m = inputs.matrices[i & mask] * rhs;
+		sink += m.raw[i & 15];
+	});
+	Benchmark_Run("v4 * Matrix    ", iterations, 1, [&](u32 i) {
+		v4 v = inputs.vectors[i & mask] * rhs;
+		sink += v.arr[i & 3];
+	});
+	Benchmark_Run("InvertRT       ", iterations, 1, [&](u32 i) {
+		Matrix m = InvertRT(inputs.matrices[i & mask]);
+		sink += m.raw[i & 15];
+	});
+	Benchmark_Run("MultiplyBatch  ", iterations / InputCount, InputCount, [&](u32 i) {
+		MultiplyBatch(matrices.data, inputs.matrices.data, rhs, InputCount);
+		sink += matrices[i % InputCount].raw[0];
+	});
+	Benchmark_Run("TransformBatch ", iterations / InputCount, InputCount, [&](u32 i) {
+		TransformBatch(vectors.data, inputs.vectors.data, rhs, InputCount);
+		sink += vectors[i % InputCount].arr[0];
+	});
+
+	Platform_Print("  (sink %)\n", sink);
+}
+
+i32
+main(i32 argc, c8* argv[])
+{
+	b8 success = Platform_InitializeLog(LogOverflow::Block);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize logging");
+	defer { Platform_TeardownLog(); };
+
+	#if LHM_SIMD >= 2
+	__builtin_cpu_init();
+	b8 supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	LOG_IF(!supported, return SkipExitCode,
+		Severity::Warning, "This CPU doesn't support AVX2 and FMA");
+	#endif
+
+	StringView mode = argc > 1 ? String_ViewCString(argv[1]) : StringView {};
+
+	MathInputs inputs = {};
+	defer { Inputs_Free(inputs); };
+	Inputs_Generate(inputs);
+
+	if (String_Equal(mode, "--bench"))
+	{
+		Benchmark(inputs);
+		return 0;
+	}
+
+	LOG_IF(argc != 3, return -1, Severity::Fatal, "Usage: math_test --write|--compare <file> | --bench");
+	StringView path = String_ViewCString(argv[2]);
+
+	MathResults results = {};
+	defer { List_Free(results.values); };
+	Results_Compute(results, inputs);
+
+	if (String_Equal(mode, "--write"))
+	{
+		ByteSlice bytes = {};
+		bytes.length = results.values.length * sizeof(r32);
+		bytes.data   = (u8*) results.values.data;
+
+		success = Platform_WriteFileBytes(path, bytes);
+		return success ? 0 : 1;
+	}
+
+	if (String_Equal(mode, "--compare"))
+	{
+		Bytes reference = Platform_LoadFileBytes(path);
+		defer { List_Free(reference); };
+		LOG_IF(!reference.data, return 1, Severity::Error, "Failed to load reference '%'", path);
+
+		success = Results_Compare(results, reference);
+		return success ? 0 : 1;
+	}
+
+	LOG(Severity::Fatal, "Unknown mode '%'", mode);
+	return -1;
+}
@@ -0,0 +1,199 @@
+#include "LHMAPI.h"
+
+#include <stdio.h>
+
+#include "platform.h"
+
+#include "platform_linux.hpp"
+
+// NOTE: Single-process ping-pong between a server and a client pipe. Both ends are polled on this
+// thread the same way the simulation and GUI poll theirs, so the numbers include the epoll update
+// on every read.
+// Usage: pipe_benchmark [iterations]
+
+struct PipePair
+{
+	Pipe server;
+	Pipe client;
+};
+
+static b8
+Pair_Connect(PipePair& pair, StringView name, PipeTransport transport)
+{
+	PipeResult result = Platform_CreatePipeServer(name, pair.server, transport);
+	LOG_IF(result != PipeResult::Success, return false,
+		Severity::Error, "Failed to create pipe server '%'", name);
+
+	result = Platform_ConnectPipe(pair.server);
+	LOG_IF(result == PipeResult::UnexpectedFailure, return false,
+		Severity::Error, "Failed to start pipe server '%'", name);
+
+	result = Platform_CreatePipeClient(name, pair.client, transport);
+	LOG_IF(result == PipeResult::UnexpectedFailure, return false,
+		Severity::Error, "Failed to create pipe client '%'", name);
+
+	// NOTE: The shared memory transport is ready once the client has received the mapping
+	u8 probe = 0;
+	for (u32 attempt = 0; attempt < 1000; attempt++)
+	{
+		result = Platform_UpdatePipeConnection(pair.server);
+		if (result == PipeResult::UnexpectedFailure) return false;
+
+		result = Platform_UpdatePipeConnection(pair.client);
+		if (result == PipeResult::UnexpectedFailure) return false;
+
+		if (pair.server.state != PipeState::Connected) continue;
+		if (pair.client.state != PipeState::Connected) continue;
+
+		result = Platform_WritePipe(pair.client, probe);
+		if (result == PipeResult::Success) break;
+		Platform_Sleep(1);
+	}
+
+	Bytes bytes = {};
+	defer { List_Free(bytes); };
+	for (u32 attempt = 0; attempt < 1000 && bytes.length == 0; attempt++)
+	{
+		Platform_UpdatePipeConnection(pair.server);
+		Platform_ReadPipe(pair.server, bytes);
+	}
+	LOG_IF(bytes.length != 1, return false,
+		Severity::Error, "Pipe '%' never connected", name);
+
+	return true;
+}
+
+static void
+Pair_Destroy(PipePair& pair)
+{
+	Platform_DestroyPipe(pair.client);
+	Platform_DestroyPipe(pair.server);
+}
+
+static b8
+Pipe_Send(Pipe& pipe, ByteSlice bytes)
+{
+	for (;;)
+	{
+		PipeResult result = Platform_WritePipe(pipe, bytes);
+		if (result == PipeResult::Success) return true;
+		if (result == PipeResult::UnexpectedFailure) return false;
+	}
+}
+
+static b8
+Pipe_Receive(Pipe& pipe, Bytes& bytes)
+{
+	for (;;)
+	{
+		PipeResult result = Platform_UpdatePipeConnection(pipe);
+		if (result == PipeResult::UnexpectedFailure) return false;
+
+		result = Platform_ReadPipe(pipe, bytes);
+		if (result == PipeResult::UnexpectedFailure) return false;
+		if (bytes.length) return true;
+	}
+}
+
+static b8
+Benchmark_RoundTrip(PipePair& pair, StringView label, u32 iterations)
+{
+	Bytes bytes = {};
+	defer { List_Free(bytes); };
+
+	u8 message[16] = {};
+
+	i64 startTicks = Platform_GetTicks();
+	for (u32 i = 0; i < iterations; i++)
+	{
+		message[0] = (u8) i;
+
+		b8 success = true;
+		success = success && Pipe_Send(pair.client, message);
+		success = success && Pipe_Receive(pair.server, bytes);
+		success = success && Pipe_Send(pair.server, bytes);
+		success = success && Pipe_Receive(pair.client, bytes);
+		LOG_IF(!success, return false,
+			Severity::Error, "% round trip failed", label);
+		LOG_IF(bytes.length != sizeof(message) || bytes[0] != (u8) i, return false,
+			Severity::Error, "% round trip returned the wrong message", label);
+	}
+	r32 seconds = Platform_GetElapsedSeconds(startTicks);
+
+	Platform_Print("%: % us round trip (16 bytes)\n", label, 1e6 * seconds / iterations);
+	return true;
+}
+
+// NOTE: Sizes are a mix of sensor updates and full frame payloads
+static b8
+Benchmark_Throughput(PipePair& pair, StringView label, u32 iterations)
+{
+	static const u32 sizes[] = { 16, 64, 256, 1024, 4096, 16384 };
+
+	Bytes message = {};
+	Bytes bytes   = {};
+	defer
+	{
+		List_Free(message);
+		List_Free(bytes);
+	};
+
+	List_AppendRange(message, sizes[ArrayLength(sizes) - 1]);
+	for (u32 i = 0; i < message.length; i++)
+		message[i] = (u8) i;
+
+	u64 total = 0;
+	i64 startTicks = Platform_GetTicks();
+	for (u32 i = 0; i < iterations; i++)
+	{
+		ByteSlice slice = message;
+		slice.length = sizes[i % ArrayLength(sizes)];
+
+		b8 success = true;
+		success = success && Pipe_Send(pair.server, slice);
+		success = success && Pipe_Receive(pair.client, bytes);
+		LOG_IF(!success, return false,
+			Severity::Error, "% transfer failed", label);
+		LOG_IF(bytes.length != slice.length || memcmp(bytes.data, slice.data, slice.length) != 0, return false,
+			Severity::Error, "% transfer returned the wrong message", label);
+
+		total += slice.length;
+	}
+	r32 seconds = Platform_GetElapsedSeconds(startTicks);
+
+	Platform_Print("%: % MB/s (mixed sizes)\n", label, (r64) total / seconds / Megabyte);
+	return true;
+}
+
+static b8
+Benchmark_Transport(StringView name, StringView label, PipeTransport transport, u32 iterations)
+{
+	PipePair pair = {};
+	defer { Pair_Destroy(pair); };
+
+	b8 success = Pair_Connect(pair, name, transport);
+	if (!success) return false;
+
+	success = success && Benchmark_RoundTrip(pair, label, iterations);
+	success = success && Benchmark_Throughput(pair, label, iterations);
+	return success;
+}
+
+i32
+main(i32 argc, c8* argv[])
+{
+	b8 success = Platform_InitializeLog(LogOverflow::Block);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize logging");
+	defer { Platform_TeardownLog(); };
+
+	u32 iterations = argc > 1 ? (u32) atoi(argv[1]) : 100000;
+	LOG_IF(iterations == 0, return -1, Severity::Fatal, "Usage: pipe_benchmark [iterations]");
+
+	String name = String_Format("PipeBenchmark-%", (i64) getpid());
+	defer { String_Free(name); };
+
+	success = true;
+	success = success && Benchmark_Transport(name, "seqpacket + epoll", PipeTransport::NamedPipe, iterations);
+	success = success && Benchmark_Transport(name, "shared memory", PipeTransport::SharedMemory, iterations);
+	return success ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+#include "LHMAPI.h"
+
+#include <stdio.h>
+
+#include "platform.h"
+#include "renderer.h"
+#include "plugin_shared.h"
+#include "pixels.hpp"
+
+#include "platform_linux.hpp"
+
+// NOTE: Times every format and dither mode on a synthetic gradient and compares it to the time the
+// converted frame spends on the wire. SPI moves one bit per clock, so this is a lower bound for the
+// wire and ignores MPSSE command overhead. Every mode is also converted with the scalar path alone
+// and has to match the SIMD path exactly. Before that, solid colors are converted in every mode and
+// checked against bytes worked out by hand. Built once per LHM_SIMD level.
+// Usage: pixels_benchmark [iterations]
+
+// NOTE: ctest treats this as skipped rather than failed
+const i32 SkipExitCode = 77;
+
+// NOTE: The ILI9341 panel and ILI9341::WriteClockSpeed
+const v2u FrameSize  = { 320, 240 };
+const u32 ClockSpeed = 30'000'000;
+
+static void
+Frame_Generate(Bytes& source, CPUTextureBytes& frame, v2u size)
+{
+	List_AppendRange(source, 4 * size.x * size.y);
+	for (u32 y = 0; y < size.y; y++)
+	{
+		for (u32 x = 0; x < size.x; x++)
+		{
+			u8* pixel = &source[4 * (y * size.x + x)];
+			pixel[0] = (u8) (255 * x / Max(size.x - 1, 1u));
+			pixel[1] = (u8) (255 * y / Max(size.y - 1, 1u));
+			pixel[2] = (u8) (x + y);
+			pixel[3] = 0xFF;
+		}
+	}
+
+	frame.bytes       = source;
+	frame.size        = size;
+	frame.pixelStride = 4;
+	frame.rowStride   = 4 * size.x;
+}
+
+static ByteSlice
+ConvertScalar(PixelConverter& converter, CPUTextureBytes frame, Bytes& buffer)
+{
+	u32 rowBytes = PixelFormat_BytesPerPixel(converter.format) * frame.size.x;
+	List_Reserve(buffer, rowBytes * frame.size.y);
+	buffer.length = rowBytes * frame.size.y;
+
+	for (u32 y = 0; y < frame.size.y; y++)
+	{
+		u8* src = &frame.bytes.data[y * frame.rowStride];
+		u8* dst = &buffer.data[y * rowBytes];
+		ConvertRowScalar(converter, dst, src, 0, frame.size.x, y);
+	}
+
+	return buffer;
+}
+
+// NOTE: Pure channels and white survive any dither unchanged. A full channel saturates and an empty
+// one gets less than one step added, which truncates away.
+struct KnownColor
+{
+	StringView name;
+	u8         bgra[4];
+	u8         rgb565[2];
+	u8         rgb666[3];
+};
+
+const KnownColor KnownColors[] = {
+	{ "Black", { 0x00, 0x00, 0x00, 0xFF }, { 0x00, 0x00 }, { 0x00, 0x00, 0x00 } },
+	{ "Red",   { 0x00, 0x00, 0xFF, 0xFF }, { 0xF8, 0x00 }, { 0xFC, 0x00, 0x00 } },
+	{ "Green", { 0x00, 0xFF, 0x00, 0xFF }, { 0x07, 0xE0 }, { 0x00, 0xFC, 0x00 } },
+	{ "Blue",  { 0xFF, 0x00, 0x00, 0xFF }, { 0x00, 0x1F }, { 0x00, 0x00, 0xFC } },
+	{ "White", { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFF, 0xFF }, { 0xFC, 0xFC, 0xFC } },
+};
+
+// NOTE: Odd sized so both the SIMD loops and the scalar tail run, and every dither offset is used
+const v2u KnownSize = { 2 * DitherSize + 7, DitherSize + 3 };
+
+static b8
+CheckKnownColor(const KnownColor& color, PixelConverter& converter, ByteSlice converted, StringView path)
+{
+	u32       bpp      = PixelFormat_BytesPerPixel(converter.format);
+	const u8* expected = converter.format == PixelFormat::RGB565 ? color.rgb565 : color.rgb666;
+
+	LOG_IF(converted.length != bpp * KnownSize.x * KnownSize.y, return false,
+		Severity::Error, "% % (% dither) converted to % bytes", path, PixelFormat_Name(converter.format),
+		Dither_Name(converter.dither), converted.length);
+
+	for (u32 i = 0; i < KnownSize.x * KnownSize.y; i++)
+	{
+		b8 matches = memcmp(&converted.data[bpp * i], expected, bpp) == 0;
+		LOG_IF(!matches, return false,
+			Severity::Error, "% % % (% dither) is wrong at pixel %", path, color.name,
+			PixelFormat_Name(converter.format), Dither_Name(converter.dither), i);
+	}
+	return true;
+}
+
+static b8
+Test_KnownColors()
+{
+	Bytes source = {};
+	Bytes buffer = {};
+	defer
+	{
+		List_Free(source);
+		List_Free(buffer);
+	};
+
+	List_AppendRange(source, 4 * KnownSize.x * KnownSize.y);
+
+	CPUTextureBytes frame = {};
+	frame.bytes       = source;
+	frame.size        = KnownSize;
+	frame.pixelStride = 4;
+	frame.rowStride   = 4 * KnownSize.x;
+
+	for (u32 c = 0; c < ArrayLength(KnownColors); c++)
+	{
+		const KnownColor& color = KnownColors[c];
+		for (u32 i = 0; i < KnownSize.x * KnownSize.y; i++)
+			memcpy(&source[4 * i], color.bgra, 4);
+
+		for (u32 f = (u32) PixelFormat::Null + 1; f < (u32) PixelFormat::Count; f++)
+		{
+			for (u32 d = (u32) Dither::Null; d < (u32) Dither::Count; d++)
+			{
+				PixelConverter converter = {};
+				PixelConverter_Initialize(converter, (PixelFormat) f, (Dither) d);
+
+				b8 success = true;
+				success = success && CheckKnownColor(color, converter, ConvertScalar(converter, frame, buffer), "Scalar");
+				success = success && CheckKnownColor(color, converter, Pixels_Convert(converter, frame, buffer), "SIMD");
+				if (!success) return false;
+			}
+		}
+	}
+
+	Platform_Print("LHM_SIMD %: % solid colors match in every format and dither mode\n",
+		LHM_SIMD, ArrayLength(KnownColors));
+	return true;
+}
+
+static b8
+Benchmark(u32 iterations)
+{
+	Bytes source = {};
+	defer { List_Free(source); };
+
+	CPUTextureBytes frame = {};
+	Frame_Generate(source, frame, FrameSize);
+
+	Bytes buffer   = {};
+	Bytes expected = {};
+	defer
+	{
+		List_Free(buffer);
+		List_Free(expected);
+	};
+
+	Platform_Print("LHM_SIMD %\n", LHM_SIMD);
+	for (u32 f = (u32) PixelFormat::Null + 1; f < (u32) PixelFormat::Count; f++)
+	{
+		for (u32 d = (u32) Dither::Null; d < (u32) Dither::Count; d++)
+		{
+			PixelConverter converter = {};
+			PixelConverter_Initialize(converter, (PixelFormat) f, (Dither) d);
+
+			ByteSlice reference = ConvertScalar(converter, frame, expected);
+
+			// NOTE: Also warms up so the buffer allocation isn't timed
+			ByteSlice converted = Pixels_Convert(converter, frame, buffer);
+			b8 matches = converted.length == reference.length
+				&& memcmp(converted.data, reference.data, converted.length) == 0;
+			LOG_IF(!matches, return false,
+				Severity::Error, "% (% dither) doesn't match the scalar conversion",
+				PixelFormat_Name(converter.format), Dither_Name(converter.dither));
+
+			i64 startTicks = Platform_GetTicks();
+			for (u32 i = 0; i < iterations; i++)
+				converted = Pixels_Convert(converter, frame, buffer);
+			r32 convertMs = Platform_GetElapsedMilliseconds(startTicks) / iterations;
+			r32 wireMs    = 1000.0f * 8.0f * converted.length / ClockSpeed;
+
+			Platform_Print("  % (% dither): % ms, % bytes, % ms on the wire at % Hz\n",
+				PixelFormat_Name(converter.format), Dither_Name(converter.dither), convertMs,
+				converted.length, wireMs, ClockSpeed);
+		}
+	}
+	return true;
+}
+
+i32
+main(i32 argc, c8* argv[])
+{
+	b8 success = Platform_InitializeLog(LogOverflow::Block);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize logging");
+	defer { Platform_TeardownLog(); };
+
+	#if LHM_SIMD >= 2
+	__builtin_cpu_init();
+	b8 supported = __builtin_cpu_supports("avx2");
+	LOG_IF(!supported, return SkipExitCode,
+		Severity::Warning, "This CPU doesn't support AVX2");
+	#endif
+
+	u32 iterations = argc > 1 ? (u32) atoi(argv[1]) : 32;
+	LOG_IF(iterations == 0, return -1, Severity::Fatal, "Usage: pixels_benchmark [iterations]");
+
+	success = Test_KnownColors();
+	success = success && Benchmark(iterations);
+	return success ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+#include "LHMAPI.h"
+
+#include <stdio.h>
+
+#include "platform.h"
+#include "pluginloader.h"
+#include "plugin_shared.h"
+
+#include "platform_linux.hpp"
+#include "pluginloader_linux.hpp"
+
+// NOTE: Loads plugins through the Linux loader, checks that failed loads don't leave the module
+// mapped, and measures the cost of calling into a plugin.
+// Usage: pluginloader_test <build directory> [iterations]
+
+static StringView buildDirectory;
+
+static Plugin
+MakePlugin(StringView directory, StringView fileName, PluginKind kind)
+{
+	Plugin plugin = {};
+	plugin.kind      = kind;
+	plugin.language  = PluginLanguage::Native;
+	plugin.directory = String_Format("%/%", buildDirectory, directory);
+	plugin.fileName  = String_FromView(fileName);
+	return plugin;
+}
+
+static void
+FreePlugin(Plugin& plugin)
+{
+	String_Free(plugin.directory);
+	String_Free(plugin.fileName);
+	String_Free(plugin.info.name);
+	String_Free(plugin.info.author);
+	plugin = {};
+}
+
+// NOTE: RTLD_NOLOAD only succeeds if the module is still mapped
+static b8
+IsModuleLoaded(Plugin& plugin)
+{
+	String path = String_Format("%/%", plugin.directory, plugin.fileName);
+	defer { String_Free(path); };
+
+	void* module = dlopen(path.data, RTLD_NOW | RTLD_NOLOAD);
+	if (module) dlclose(module);
+	return module;
+}
+
+static b8
+Test_LoadSensorPlugin(PluginLoaderState& loader, StringView directory, StringView fileName)
+{
+	Plugin plugin = MakePlugin(directory, fileName, PluginKind::Sensor);
+	defer { FreePlugin(plugin); };
+
+	SensorPlugin sensorPlugin = {};
+	b8 success = PluginLoader_LoadSensorPlugin(loader, plugin, sensorPlugin);
+	LOG_IF(!success, return false,
+		Severity::Error, "Failed to load '%'", fileName);
+	LOG_IF(!IsModuleLoaded(plugin), return false,
+		Severity::Error, "'%' loaded but isn't mapped", fileName);
+
+	success = PluginLoader_UnloadSensorPlugin(loader, plugin, sensorPlugin);
+	LOG_IF(!success, return false,
+		Severity::Error, "Failed to unload '%'", fileName);
+	LOG_IF(IsModuleLoaded(plugin), return false,
+		Severity::Error, "'%' is still mapped after unloading", fileName);
+
+	return true;
+}
+
+static b8
+Test_RejectSensorPlugin(PluginLoaderState& loader, StringView directory, StringView fileName)
+{
+	Plugin plugin = MakePlugin(directory, fileName, PluginKind::Sensor);
+	defer { FreePlugin(plugin); };
+
+	SensorPlugin sensorPlugin = {};
+	b8 success = PluginLoader_LoadSensorPlugin(loader, plugin, sensorPlugin);
+	LOG_IF(success, return false,
+		Severity::Error, "Loaded invalid plugin '%'", fileName);
+	LOG_IF(plugin.loadState != PluginLoadState::Broken || plugin.loaderData, return false,
+		Severity::Error, "Failed load of '%' left loader state behind", fileName);
+	LOG_IF(IsModuleLoaded(plugin), return false,
+		Severity::Error, "Failed load of '%' leaked the module", fileName);
+
+	return true;
+}
+
+// NOTE: A sensor plugin doesn't export GetWidgetPluginInfo, so this fails at dlsym
+static b8
+Test_RejectWidgetPlugin(PluginLoaderState& loader, StringView directory, StringView fileName)
+{
+	Plugin plugin = MakePlugin(directory, fileName, PluginKind::Widget);
+	defer { FreePlugin(plugin); };
+
+	WidgetPlugin widgetPlugin = {};
+	b8 success = PluginLoader_LoadWidgetPlugin(loader, plugin, widgetPlugin);
+	LOG_IF(success, return false,
+		Severity::Error, "Loaded sensor plugin '%' as a widget plugin", fileName);
+	LOG_IF(plugin.loadState != PluginLoadState::Broken || plugin.loaderData, return false,
+		Severity::Error, "Failed load of '%' left loader state behind", fileName);
+	LOG_IF(IsModuleLoaded(plugin), return false,
+		Severity::Error, "Failed load of '%' leaked the module", fileName);
+
+	return true;
+}
+
+// NOTE: Same body as the test plugin's Update, called through a pointer the compiler can't see
+// through. The difference between the two is what crossing into a plugin costs.
+static void
+LocalUpdate(PluginContext& context, SensorPluginAPI::Update api)
+{
+	Unused(context);
+	api.values[0] += 1.0f;
+}
+
+static SensorPluginFunctions::UpdateFn* volatile localUpdate = LocalUpdate;
+
+static r64
+MeasureUpdate(SensorPluginFunctions::UpdateFn* update, u32 iterations, r32& value)
+{
+	value = 0.0f;
+
+	SensorPluginAPI::Update api = {};
+	api.values = value;
+
+	PluginContext* context = nullptr;
+	i64 startTicks = Platform_GetTicks();
+	for (u32 i = 0; i < iterations; i++)
+		update(*context, api);
+	r32 seconds = Platform_GetElapsedSeconds(startTicks);
+
+	return 1e9 * seconds / iterations;
+}
+
+static b8
+Benchmark_CallCost(PluginLoaderState& loader, u32 iterations)
+{
+	Plugin plugin = MakePlugin("Test Plugins", "Sensor.Test.so", PluginKind::Sensor);
+	defer { FreePlugin(plugin); };
+
+	SensorPlugin sensorPlugin = {};
+	b8 success = PluginLoader_LoadSensorPlugin(loader, plugin, sensorPlugin);
+	LOG_IF(!success, return false, Severity::Error, "Failed to load the test plugin");
+	defer { PluginLoader_UnloadSensorPlugin(loader, plugin, sensorPlugin); };
+
+	// NOTE: Values are counted in floats, which stop being exact at 2^24
+	iterations = Min(iterations, 1u << 24);
+
+	r32 pluginValue = 0.0f;
+	r32 localValue  = 0.0f;
+	r64 pluginNs = MeasureUpdate(sensorPlugin.functions.Update, iterations, pluginValue);
+	r64 localNs  = MeasureUpdate(localUpdate, iterations, localValue);
+
+	LOG_IF(pluginValue != (r32) iterations || localValue != (r32) iterations, return false,
+		Severity::Error, "Update was called the wrong number of times");
+
+	Platform_Print("plugin Update: % ns/call\n", pluginNs);
+	Platform_Print("local Update:  % ns/call\n", localNs);
+	return true;
+}
+
+i32
+main(i32 argc, c8* argv[])
+{
+	b8 success = Platform_InitializeLog(LogOverflow::Block);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize logging");
+	defer { Platform_TeardownLog(); };
+
+	LOG_IF(argc < 2, return -1, Severity::Fatal, "Usage: pluginloader_test <build directory> [iterations]");
+	buildDirectory = String_ViewCString(argv[1]);
+	u32 iterations = argc > 2 ? (u32) atoi(argv[2]) : 1000;
+
+	PluginLoaderState loader = {};
+	success = PluginLoader_Initialize(loader);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize the plugin loader");
+	defer { PluginLoader_Teardown(loader); };
+
+	success = true;
+	success = success && Test_LoadSensorPlugin(loader, "Test Plugins", "Sensor.Test.so");
+	success = success && Test_LoadSensorPlugin(loader, "Sensor Plugins/hwmon", "Sensor.hwmon.so");
+	success = success && Test_LoadSensorPlugin(loader, "Sensor Plugins/procfs", "Sensor.procfs.so");
+	success = success && Test_RejectSensorPlugin(loader, "Test Plugins", "Sensor.TestInvalid.so");
+	success = success && Test_RejectWidgetPlugin(loader, "Test Plugins", "Sensor.Test.so");
+	success = success && Benchmark_CallCost(loader, iterations);
+	return success ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+#include "LHMAPI.h"
+
+#include <stdio.h>
+
+#include "platform.h"
+#include "pluginloader.h"
+#include "renderer.h"
+#include "plugin_shared.h"
+#include "sensor_table.hpp"
+#include "layout.hpp"
+#include "jobs.hpp"
+#include "gui_protocol.hpp"
+#include "Solid Colored.ps.h"
+#include "Outline.ps.h"
+#include "pixels.hpp"
+#include "ft232h.h"
+#include "ili9341.hpp"
+#include "simulation.hpp"
+
+#include "platform_linux.hpp"
+
+// NOTE: Drives the sensor bookkeeping in simulation.hpp directly, without loading plugins. There's
+// no Linux renderer or FT232H, so the build drops unreferenced functions at link time instead.
+// Usage: simulation_test
+
+static SensorPlugin&
+AddTestSensorPlugin(SimulationState& s, StringView name)
+{
+	SensorPlugin& sensorPlugin = ListWithHandles_Append(s.handleTable, s.sensorPlugins);
+	sensorPlugin.name = name;
+	return sensorPlugin;
+}
+
+static b8
+RegisterTestSensors(SimulationState& s, u32 sensorPluginIndex, Slice<SensorDesc> descs)
+{
+	PluginContext context = {};
+	context.s            = &s;
+	context.sensorPlugin = &s.sensorPlugins[sensorPluginIndex];
+	context.success      = true;
+	RegisterSensors(context, descs);
+	return context.success;
+}
+
+static void
+TeardownTestSensorPlugin(SimulationState& s, u32 sensorPluginIndex)
+{
+	SensorPlugin& sensorPlugin = s.sensorPlugins[sensorPluginIndex];
+	RemoveSensorReferences(s, List_MemberSlice(sensorPlugin.sensors, &Sensor::handle));
+	TeardownSensorPlugin(sensorPlugin);
+}
+
+static void
+TeardownTestSimulation(SimulationState& s)
+{
+	for (u32 i = 0; i < s.sensorPlugins.length; i++)
+		TeardownSensorPlugin(s.sensorPlugins[i]);
+	List_Free(s.sensorPlugins);
+	HashMap_Free(s.sensorsByIdentifier);
+	List_Free(s.handleTable.elements);
+	List_Free(s.handleTable.generations);
+}
+
+// NOTE: The identifier map has to point at a sensor that still exists, with a key that points into
+// that sensor's identifier, no matter which of the duplicates goes away first
+static b8
+Test_DuplicateIdentifier(u32 removedIndex)
+{
+	SimulationState s = {};
+	defer { TeardownTestSimulation(s); };
+
+	AddTestSensorPlugin(s, "First");
+	AddTestSensorPlugin(s, "Second");
+
+	SensorDesc desc = { "Temperature", "/shared/temp0", "%.0f C" };
+	b8 success = true;
+	success &= RegisterTestSensors(s, 0, desc);
+	success &= RegisterTestSensors(s, 1, desc);
+	LOG_IF(!success, return false, Severity::Error, "Failed to register sensors");
+
+	Handle<Sensor> winner = FindSensor(s, desc.identifier);
+	LOG_IF(winner != s.sensorPlugins[1].sensors[0].handle, return false,
+		Severity::Error, "The last sensor registered isn't the one found");
+
+	u32 survivorIndex = 1 - removedIndex;
+	Sensor& survivor = s.sensorPlugins[survivorIndex].sensors[0];
+	TeardownTestSensorPlugin(s, removedIndex);
+
+	Handle<Sensor> found = FindSensor(s, desc.identifier);
+	LOG_IF(found != survivor.handle, return false,
+		Severity::Error, "Removing plugin % lost the sensor from plugin %", removedIndex, survivorIndex);
+
+	u64 hash = HashMap_Hash(desc.identifier);
+	u32 slot = HashMap_FindSlot(s.sensorsByIdentifier, desc.identifier, hash);
+	LOG_IF(s.sensorsByIdentifier.keys[slot].data != survivor.identifier.data, return false,
+		Severity::Error, "Removing plugin % left a key that doesn't point at the surviving sensor", removedIndex);
+
+	TeardownTestSensorPlugin(s, survivorIndex);
+	LOG_IF(FindSensor(s, desc.identifier), return false,
+		Severity::Error, "Removing every sensor left the identifier in the map");
+
+	return true;
+}
+
+// NOTE: Unregistering a sensor moves the last one into its place. Handles to the moved sensor have
+// to stay valid.
+static b8
+Test_UnregisterSensor()
+{
+	SimulationState s = {};
+	defer { TeardownTestSimulation(s); };
+
+	AddTestSensorPlugin(s, "Test");
+
+	SensorDesc descs[] = {
+		{ "CPU", "/test/cpu", "%.0f MHz" },
+		{ "GPU", "/test/gpu", "%.0f MHz" },
+		{ "RAM", "/test/ram", "%.0f MHz" },
+	};
+	b8 success = RegisterTestSensors(s, 0, descs);
+	LOG_IF(!success, return false, Severity::Error, "Failed to register sensors");
+
+	SensorPlugin&  sensorPlugin = s.sensorPlugins[0];
+	Handle<Sensor> removed      = sensorPlugin.sensors[0].handle;
+	Handle<Sensor> moved        = sensorPlugin.sensors[2].handle;
+
+	PluginContext context = {};
+	context.s            = &s;
+	context.sensorPlugin = &sensorPlugin;
+	context.success      = true;
+	UnregisterSensors(context, removed);
+	LOG_IF(!context.success, return false, Severity::Error, "Failed to unregister a sensor");
+
+	LOG_IF(s.handleTable.IsValid(removed), return false,
+		Severity::Error, "The unregistered sensor's handle is still valid");
+	LOG_IF(FindSensor(s, descs[0].identifier), return false,
+		Severity::Error, "The unregistered sensor is still in the map");
+
+	Handle<Sensor> found = FindSensor(s, descs[2].identifier);
+	LOG_IF(found != moved, return false,
+		Severity::Error, "The moved sensor's handle changed");
+	LOG_IF(!s.handleTable.IsValid(found), return false,
+		Severity::Error, "The moved sensor's handle is no longer valid");
+
+	Sensor& sensor = *s.handleTable[found];
+	LOG_IF(&sensor != &sensorPlugin.sensors[0], return false,
+		Severity::Error, "The moved sensor's handle doesn't point at its new location");
+	LOG_IF(!String_Equal(sensor.identifier, descs[2].identifier), return false,
+		Severity::Error, "The moved sensor's handle points at '%'", sensor.identifier);
+
+	// NOTE: Removing the last sensor doesn't move anything
+	context.success = true;
+	UnregisterSensors(context, moved);
+	LOG_IF(!context.success || sensorPlugin.sensors.length != 1, return false,
+		Severity::Error, "Failed to unregister the last sensor");
+
+	return true;
+}
+
+i32
+main(i32 argc, c8* argv[])
+{
+	Unused(argc, argv);
+
+	b8 success = Platform_InitializeLog(LogOverflow::Block);
+	LOG_IF(!success, return -1, Severity::Fatal, "Failed to initialize logging");
+	defer { Platform_TeardownLog(); };
+
+	success = true;
+	success = success && Test_DuplicateIdentifier(0);
+	success = success && Test_DuplicateIdentifier(1);
+	success = success && Test_UnregisterSensor();
+	if (success) Platform_Print("Sensor bookkeeping tests passed\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+#include "LHMAPI.h"
+
+// NOTE: Minimal sensor plugin for pluginloader_test. Built twice: once as is and once with
+// LHM_TEST_INVALID_DESC, which reports a version the loader has to reject.
+
+static void
+Update(PluginContext& context, SensorPluginAPI::Update api)
+{
+	Unused(context);
+	api.values[0] += 1.0f;
+}
+
+EXPORT void
+GetSensorPluginInfo(PluginDesc& desc, SensorPluginFunctions& functions)
+{
+	desc.name       = "Test Sensors";
+	desc.author     = "LCDHardwareMonitor contributors";
+	desc.version    = 1;
+	desc.lhmVersion = LHMVersion;
+
+	#if LHM_TEST_INVALID_DESC
+	desc.lhmVersion = LHMVersion + 1;
+	#endif
+
+	functions.Update = Update;
+}
@@ -79,25 +79,23 @@ public ref struct State : ISensorPlugin, ISensorPluginInitialize, ISensorPluginU
 						break;
 
 					case SensorType::Clock:       format = "%i MHz";   break;
-					case SensorType::Control:     format = "%s%%";     break;
-					case SensorType::Data:        format = "%f";       break;
+					case SensorType::Control:     format = "%.0f%%";   break;
+					case SensorType::Data:        format = "%.1f GB";  break;
 					case SensorType::Factor:      format = "%.2f";     break;
 					case SensorType::Fan:         format = "%.0f RPM"; break;
 					case SensorType::Flow:        format = "%.2f L/h"; break;
 					case SensorType::Level:       format = "%.0f%%";   break;
 					case SensorType::Load:        format = "%.0f%%";   break;
 					case SensorType::Power:       format = "%.1f W";   break;
-					case SensorType::SmallData:   format = "%s";       break;
+					case SensorType::SmallData:   format = "%.1f MB";  break;
 					case SensorType::Temperature: format = "%.0f C";   break;
 					case SensorType::Voltage:     format = "%.2f V";   break;
 				}
-				// TODO: Don't update unless changed
-				CLRString^ value  = CLRString::Format(format, ohmSensor.Value);
 
 				SensorDesc sensor = {};
 				sensor.name       = StringView_PinCLR(ohmSensor.Name);
 				sensor.identifier = StringView_PinCLR(ohmSensor.Identifier->ToString());
-				sensor.format     = StringView_PinCLR(value);
+				sensor.format     = StringView_PinCLR(format);
 				api.RegisterSensors(context, sensor);
 				StringView_ReleaseCLR(sensor.name);
 				StringView_ReleaseCLR(sensor.identifier);
@@ -142,12 +140,10 @@ public ref struct State : ISensorPlugin, ISensorPluginInitialize, ISensorPluginU
 			State::activeHardware[i]->Update();
 
 		// TODO: This is stupid. Something something activeSensors
-		for (u32 i = 0; i < api.sensors.length; i++)
+		for (u32 i = 0; i < api.values.length; i++)
 		{
-			Sensor& sensor = api.sensors[i];
 			ISensor% ohmSensor = *State::activeSensors[(i32) i];
-
-			sensor.value = ohmSensor.Value.GetValueOrDefault();
+			api.values[i] = ohmSensor.Value.GetValueOrDefault();
 		}
 	}
 };
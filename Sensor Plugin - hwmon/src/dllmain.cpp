@@ -0,0 +1,258 @@
+#include "LHMAPI.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// NOTE: Sensors come from /sys/class/hwmon. Every input file is opened once during initialization
+// and re-read from the start with pread on each update, so an update is one syscall per sensor and
+// never allocates. Set LHM_HWMON_ROOT to read a different directory tree (e.g. a fake one for
+// testing).
+
+struct HwmonType
+{
+	StringView prefix;
+	StringView format;
+	r32        scale;
+};
+
+// NOTE: sysfs reports millidegrees, RPM, millivolts, microwatts, and milliamps
+static const HwmonType hwmonTypes[] = {
+	{ "temp",  "%.0f C",   1.0f / 1000.0f    },
+	{ "fan",   "%.0f RPM", 1.0f              },
+	{ "in",    "%.2f V",   1.0f / 1000.0f    },
+	{ "power", "%.1f W",   1.0f / 1000000.0f },
+	{ "curr",  "%.2f A",   1.0f / 1000.0f    },
+};
+
+struct HwmonInput
+{
+	i32 fd;
+	r32 scale;
+};
+
+static List<HwmonInput> inputs = {};
+
+static b8
+IsDigit(c8 c)
+{
+	return c >= '0' && c <= '9';
+}
+
+// Matches <type><index>_input and returns the length of <type><index>
+static const HwmonType*
+MatchInput(const c8* fileName, u32& baseLength)
+{
+	for (u32 i = 0; i < ArrayLength(hwmonTypes); i++)
+	{
+		const HwmonType& type = hwmonTypes[i];
+		if (strncmp(fileName, type.prefix.data, type.prefix.length) != 0) continue;
+
+		const c8* c = fileName + type.prefix.length;
+		if (!IsDigit(*c)) continue;
+		while (IsDigit(*c)) c++;
+		if (strcmp(c, "_input") != 0) continue;
+
+		baseLength = (u32) (c - fileName);
+		return &type;
+	}
+	return nullptr;
+}
+
+static b8
+ParseInteger(const c8* text, u32 length, i64& value)
+{
+	u32 i = 0;
+	b8 negative = i < length && text[i] == '-';
+	if (negative) i++;
+
+	u32 first = i;
+	i64 result = 0;
+	for (; i < length && IsDigit(text[i]); i++)
+		result = 10*result + (text[i] - '0');
+	if (i == first) return false;
+
+	value = negative ? -result : result;
+	return true;
+}
+
+static u32
+ReadText(StringView path, c8* buffer, u32 capacity)
+{
+	buffer[0] = '\0';
+
+	i32 fd = open(path.data, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) return 0;
+	defer { close(fd); };
+
+	ssize_t length = read(fd, buffer, capacity - 1);
+	if (length <= 0) return 0;
+
+	while (length > 0 && (buffer[length - 1] == '\n' || buffer[length - 1] == ' '))
+		length--;
+
+	buffer[length] = '\0';
+	return (u32) length;
+}
+
+static b8
+Initialize(PluginContext& context, SensorPluginAPI::Initialize api)
+{
+	const c8* root = getenv("LHM_HWMON_ROOT");
+	if (!root) root = "/sys/class/hwmon";
+
+	// NOTE: Containers and some VMs have no hwmon at all. That's a machine without sensors, not a
+	// broken plugin.
+	DIR* rootDir = opendir(root);
+	if (!rootDir) return true;
+	defer { closedir(rootDir); };
+
+	List<String>     names       = {};
+	List<String>     identifiers = {};
+	List<StringView> formats     = {};
+	defer {
+		for (u32 i = 0; i < names.length; i++)
+		{
+			String_Free(names[i]);
+			String_Free(identifiers[i]);
+		}
+		List_Free(names);
+		List_Free(identifiers);
+		List_Free(formats);
+	};
+
+	while (dirent* device = readdir(rootDir))
+	{
+		if (device->d_name[0] == '.') continue;
+
+		String devicePath = String_Format("%/%", root, (const c8*) device->d_name);
+		defer { String_Free(devicePath); };
+
+		DIR* deviceDir = opendir(devicePath.data);
+		if (!deviceDir) continue;
+		defer { closedir(deviceDir); };
+
+		c8 chip[64];
+		{
+			String chipPath = String_Format("%/name", devicePath);
+			defer { String_Free(chipPath); };
+
+			if (ReadText(chipPath, chip, sizeof(chip)) == 0)
+				strncpy_s(chip, sizeof(chip), device->d_name, sizeof(chip) - 1);
+		}
+
+		// NOTE: hwmonN is numbered in probe order, which changes between boots. The device the chip
+		// belongs to is stable, so identifiers use its path instead. Chips without a device (rare,
+		// and usually one of a kind) fall back to hwmonN.
+		String linkPath = String_Format("%/device", devicePath);
+		defer { String_Free(linkPath); };
+
+		c8* target = realpath(linkPath.data, nullptr);
+		defer { free(target); };
+
+		const c8* location = target ? target : device->d_name;
+		StringView devices = "/sys/devices/";
+		if (target && strncmp(target, devices.data, devices.length) == 0)
+			location = &target[devices.length];
+		while (*location == '/') location++;
+
+		while (dirent* file = readdir(deviceDir))
+		{
+			u32 baseLength;
+			const HwmonType* type = MatchInput(file->d_name, baseLength);
+			if (!type) continue;
+
+			c8 base[64] = {};
+			if (baseLength >= sizeof(base)) continue;
+			memcpy(base, file->d_name, baseLength);
+
+			String inputPath = String_Format("%/%", devicePath, (const c8*) file->d_name);
+			defer { String_Free(inputPath); };
+
+			HwmonInput input = {};
+			input.fd    = open(inputPath.data, O_RDONLY | O_CLOEXEC);
+			input.scale = type->scale;
+			if (input.fd < 0) continue;
+
+			c8 label[64];
+			{
+				String labelPath = String_Format("%/%_label", devicePath, (const c8*) base);
+				defer { String_Free(labelPath); };
+
+				if (ReadText(labelPath, label, sizeof(label)) == 0)
+					strncpy_s(label, sizeof(label), base, sizeof(label) - 1);
+			}
+
+			List_Append(inputs, input);
+			List_Append(names,       String_Format("% %", (const c8*) chip, (const c8*) label));
+			List_Append(identifiers, String_Format("/hwmon/%/%/%", (const c8*) chip, location, (const c8*) base));
+			List_Append(formats,     type->format);
+		}
+	}
+
+	List<SensorDesc> sensors = {};
+	defer { List_Free(sensors); };
+
+	List_Reserve(sensors, inputs.length);
+	for (u32 i = 0; i < inputs.length; i++)
+	{
+		SensorDesc& sensor = List_Append(sensors);
+		sensor.name       = names[i];
+		sensor.identifier = identifiers[i];
+		sensor.format     = formats[i];
+	}
+	api.RegisterSensors(context, sensors);
+
+	// TODO: Handle devices being added and removed
+	return true;
+}
+
+static void
+Update(PluginContext& context, SensorPluginAPI::Update api)
+{
+	Unused(context);
+	Assert(api.values.length == inputs.length);
+
+	for (u32 i = 0; i < inputs.length; i++)
+	{
+		HwmonInput& input = inputs[i];
+
+		// NOTE: Some drivers fail reads while the device is asleep. Keep the last value.
+		c8 buffer[32];
+		ssize_t length = pread(input.fd, buffer, sizeof(buffer), 0);
+		if (length <= 0) continue;
+
+		i64 raw;
+		if (!ParseInteger(buffer, (u32) length, raw)) continue;
+
+		api.values[i] = (r32) raw * input.scale;
+	}
+}
+
+static void
+Teardown(PluginContext& context, SensorPluginAPI::Teardown api)
+{
+	Unused(context, api);
+
+	for (u32 i = 0; i < inputs.length; i++)
+		close(inputs[i].fd);
+	List_Free(inputs);
+}
+
+EXPORT void
+GetSensorPluginInfo(PluginDesc& desc, SensorPluginFunctions& functions)
+{
+	desc.name       = "hwmon Sensors";
+	desc.author     = "LCDHardwareMonitor contributors";
+	desc.version    = 1;
+	desc.lhmVersion = LHMVersion;
+
+	functions.Initialize = Initialize;
+	functions.Update     = Update;
+	functions.Teardown   = Teardown;
+
+	// NOTE: Most hwmon drivers refresh their readings a few times per second at most
+	functions.updateInterval = 0.25f;
+}
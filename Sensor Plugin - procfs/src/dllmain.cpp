@@ -0,0 +1,459 @@
+#include "LHMAPI.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// NOTE: CPU load comes from /proc/stat, CPU clocks from /proc/cpuinfo, and memory from
+// /proc/meminfo and /proc/pressure/memory. Each file is opened once and re-read from the start with
+// pread into a buffer that is reused between polls. Parsing walks the buffer in place so a poll
+// never allocates (the buffer only grows if a file outgrows it). Set LHM_PROCFS_ROOT to read a
+// different directory (e.g. canned snapshots for testing).
+
+struct ProcFile
+{
+	i32      fd;
+	List<c8> buffer;
+};
+
+struct Scanner
+{
+	const c8* cursor;
+	const c8* end;
+};
+
+struct CoreTimes
+{
+	u64 idle;
+	u64 total;
+};
+
+struct State
+{
+	ProcFile        stat;
+	ProcFile        cpuinfo;
+	ProcFile        meminfo;
+	ProcFile        pressure;
+
+	// NOTE: Index 0 is the aggregate of all cores
+	List<CoreTimes> coreTimes;
+	u32             coreCount;
+	b8              hasClocks;
+	b8              hasPressure;
+
+	// Sensor indices
+	u32             firstLoad;
+	u32             firstClock;
+	u32             memoryUsed;
+	u32             memoryLoad;
+	u32             memoryPressure;
+};
+
+static State state = {};
+
+// -------------------------------------------------------------------------------------------------
+// Scanning
+
+static b8
+IsDigit(c8 c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static b8
+Scanner_AtEnd(Scanner& scanner)
+{
+	return scanner.cursor >= scanner.end;
+}
+
+static void
+Scanner_SkipSpaces(Scanner& scanner)
+{
+	while (!Scanner_AtEnd(scanner) && (*scanner.cursor == ' ' || *scanner.cursor == '\t'))
+		scanner.cursor++;
+}
+
+static void
+Scanner_SkipLine(Scanner& scanner)
+{
+	while (!Scanner_AtEnd(scanner) && *scanner.cursor != '\n')
+		scanner.cursor++;
+	if (!Scanner_AtEnd(scanner))
+		scanner.cursor++;
+}
+
+static b8
+Scanner_Match(Scanner& scanner, StringView text)
+{
+	if ((u32) (scanner.end - scanner.cursor) < text.length) return false;
+	for (u32 i = 0; i < text.length; i++)
+		if (scanner.cursor[i] != text.data[i]) return false;
+
+	scanner.cursor += text.length;
+	return true;
+}
+
+static b8
+Scanner_SkipPast(Scanner& scanner, c8 c)
+{
+	while (!Scanner_AtEnd(scanner) && *scanner.cursor != '\n')
+	{
+		if (*scanner.cursor++ == c) return true;
+	}
+	return false;
+}
+
+static b8
+Scanner_ParseU64(Scanner& scanner, u64& value)
+{
+	Scanner_SkipSpaces(scanner);
+
+	const c8* first = scanner.cursor;
+	u64 result = 0;
+	while (!Scanner_AtEnd(scanner) && IsDigit(*scanner.cursor))
+		result = 10*result + (u64) (*scanner.cursor++ - '0');
+	if (scanner.cursor == first) return false;
+
+	value = result;
+	return true;
+}
+
+static b8
+Scanner_ParseR64(Scanner& scanner, r64& value)
+{
+	u64 whole;
+	if (!Scanner_ParseU64(scanner, whole)) return false;
+
+	r64 result = (r64) whole;
+	if (!Scanner_AtEnd(scanner) && *scanner.cursor == '.')
+	{
+		scanner.cursor++;
+
+		r64 scale = 0.1;
+		while (!Scanner_AtEnd(scanner) && IsDigit(*scanner.cursor))
+		{
+			result += scale * (*scanner.cursor++ - '0');
+			scale  *= 0.1;
+		}
+	}
+
+	value = result;
+	return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Files
+
+static b8
+ProcFile_Open(ProcFile& file, const c8* root, StringView name)
+{
+	String path = String_Format("%/%", root, name);
+	defer { String_Free(path); };
+
+	file.fd = open(path.data, O_RDONLY | O_CLOEXEC);
+	if (file.fd < 0) return false;
+
+	List_Reserve(file.buffer, 4096);
+	return true;
+}
+
+static void
+ProcFile_Close(ProcFile& file)
+{
+	if (file.fd >= 0)
+		close(file.fd);
+	file.fd = -1;
+	List_Free(file.buffer);
+}
+
+static b8
+ProcFile_Read(ProcFile& file, Scanner& scanner)
+{
+	if (file.fd < 0) return false;
+
+	// NOTE: procfs generates the whole file on each read from offset 0. A read that fills the
+	// buffer may have been truncated, so grow and read again.
+	for (;;)
+	{
+		ssize_t length = pread(file.fd, file.buffer.data, file.buffer.capacity, 0);
+		if (length < 0) return false;
+
+		if ((u32) length < file.buffer.capacity)
+		{
+			scanner.cursor = file.buffer.data;
+			scanner.end    = file.buffer.data + length;
+			return true;
+		}
+
+		List_Reserve(file.buffer, 2 * file.buffer.capacity);
+	}
+}
+
+// -------------------------------------------------------------------------------------------------
+// Parsing
+
+// Calls f(index, idle, total) for each cpu line. Index 0 is the aggregate line.
+template<typename Fn>
+static void
+ParseStat(Scanner scanner, Fn f)
+{
+	while (!Scanner_AtEnd(scanner))
+	{
+		if (!Scanner_Match(scanner, "cpu")) break;
+
+		u64 index = 0;
+		if (!Scanner_AtEnd(scanner) && IsDigit(*scanner.cursor))
+		{
+			Scanner_ParseU64(scanner, index);
+			index++;
+		}
+
+		// user nice system idle iowait irq softirq steal (guest time is already in user)
+		u64 times[8] = {};
+		for (u32 i = 0; i < ArrayLength(times); i++)
+			if (!Scanner_ParseU64(scanner, times[i])) break;
+
+		u64 idle  = times[3] + times[4];
+		u64 total = 0;
+		for (u32 i = 0; i < ArrayLength(times); i++)
+			total += times[i];
+
+		f((u32) index, idle, total);
+		Scanner_SkipLine(scanner);
+	}
+}
+
+// Calls f(index, mhz) for each cpu MHz line
+template<typename Fn>
+static void
+ParseCPUInfo(Scanner scanner, Fn f)
+{
+	u32 index = 0;
+	while (!Scanner_AtEnd(scanner))
+	{
+		if (Scanner_Match(scanner, "cpu MHz") && Scanner_SkipPast(scanner, ':'))
+		{
+			r64 mhz;
+			if (Scanner_ParseR64(scanner, mhz))
+				f(index++, mhz);
+		}
+		Scanner_SkipLine(scanner);
+	}
+}
+
+static void
+ParseMemInfo(Scanner scanner, u64& totalKB, u64& availableKB)
+{
+	totalKB     = 0;
+	availableKB = 0;
+
+	while (!Scanner_AtEnd(scanner))
+	{
+		if      (Scanner_Match(scanner, "MemTotal:"))     Scanner_ParseU64(scanner, totalKB);
+		else if (Scanner_Match(scanner, "MemAvailable:")) Scanner_ParseU64(scanner, availableKB);
+		Scanner_SkipLine(scanner);
+	}
+}
+
+static b8
+ParsePressure(Scanner scanner, r64& avg10)
+{
+	while (!Scanner_AtEnd(scanner))
+	{
+		if (Scanner_Match(scanner, "some") && Scanner_SkipPast(scanner, '='))
+			return Scanner_ParseR64(scanner, avg10);
+		Scanner_SkipLine(scanner);
+	}
+	return false;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Plugin
+
+static b8
+Initialize(PluginContext& context, SensorPluginAPI::Initialize api)
+{
+	State& s = state;
+	s.stat.fd     = -1;
+	s.cpuinfo.fd  = -1;
+	s.meminfo.fd  = -1;
+	s.pressure.fd = -1;
+
+	const c8* root = getenv("LHM_PROCFS_ROOT");
+	if (!root) root = "/proc";
+
+	if (!ProcFile_Open(s.stat,    root, "stat"))    return false;
+	if (!ProcFile_Open(s.meminfo, root, "meminfo")) return false;
+	ProcFile_Open(s.cpuinfo,  root, "cpuinfo");
+	ProcFile_Open(s.pressure, root, "pressure/memory");
+
+	// Count cores and take the first sample for deltas
+	Scanner scanner;
+	if (!ProcFile_Read(s.stat, scanner)) return false;
+	ParseStat(scanner, [&](u32 index, u64 idle, u64 total) {
+		if (index != s.coreTimes.length) return;
+		List_Append(s.coreTimes, { idle, total });
+	});
+	if (s.coreTimes.length == 0) return false;
+	s.coreCount = s.coreTimes.length - 1;
+
+	u32 clockCount = 0;
+	if (ProcFile_Read(s.cpuinfo, scanner))
+		ParseCPUInfo(scanner, [&](u32, r64) { clockCount++; });
+	s.hasClocks = clockCount == s.coreCount;
+
+	r64 pressure;
+	s.hasPressure = ProcFile_Read(s.pressure, scanner) && ParsePressure(scanner, pressure);
+
+	// Register sensors
+	List<String>     names       = {};
+	List<String>     identifiers = {};
+	List<StringView> formats     = {};
+	defer {
+		for (u32 i = 0; i < names.length; i++)
+		{
+			String_Free(names[i]);
+			String_Free(identifiers[i]);
+		}
+		List_Free(names);
+		List_Free(identifiers);
+		List_Free(formats);
+	};
+
+	s.firstLoad = names.length;
+	List_Append(names,       String_Format("CPU Total"));
+	List_Append(identifiers, String_Format("/procfs/cpu/load"));
+	List_Append(formats,     StringView("%.0f%%"));
+	for (u32 i = 0; i < s.coreCount; i++)
+	{
+		List_Append(names,       String_Format("CPU Core #%", i));
+		List_Append(identifiers, String_Format("/procfs/cpu/load/%", i));
+		List_Append(formats,     StringView("%.0f%%"));
+	}
+
+	s.firstClock = names.length;
+	for (u32 i = 0; i < s.coreCount && s.hasClocks; i++)
+	{
+		List_Append(names,       String_Format("CPU Core #% Clock", i));
+		List_Append(identifiers, String_Format("/procfs/cpu/clock/%", i));
+		List_Append(formats,     StringView("%i MHz"));
+	}
+
+	s.memoryUsed = names.length;
+	List_Append(names,       String_Format("Used Memory"));
+	List_Append(identifiers, String_Format("/procfs/memory/used"));
+	List_Append(formats,     StringView("%.1f GB"));
+
+	s.memoryLoad = names.length;
+	List_Append(names,       String_Format("Memory"));
+	List_Append(identifiers, String_Format("/procfs/memory/load"));
+	List_Append(formats,     StringView("%.0f%%"));
+
+	s.memoryPressure = names.length;
+	if (s.hasPressure)
+	{
+		List_Append(names,       String_Format("Memory Pressure"));
+		List_Append(identifiers, String_Format("/procfs/memory/pressure"));
+		List_Append(formats,     StringView("%.1f%%"));
+	}
+
+	List<SensorDesc> sensors = {};
+	defer { List_Free(sensors); };
+
+	List_Reserve(sensors, names.length);
+	for (u32 i = 0; i < names.length; i++)
+	{
+		SensorDesc& sensor = List_Append(sensors);
+		sensor.name       = names[i];
+		sensor.identifier = identifiers[i];
+		sensor.format     = formats[i];
+	}
+	api.RegisterSensors(context, sensors);
+
+	// TODO: Handle cores going online and offline
+	return true;
+}
+
+static void
+Update(PluginContext& context, SensorPluginAPI::Update api)
+{
+	Unused(context);
+	State& s = state;
+
+	Scanner scanner;
+
+	// Load
+	if (ProcFile_Read(s.stat, scanner))
+	{
+		ParseStat(scanner, [&](u32 index, u64 idle, u64 total) {
+			if (index >= s.coreTimes.length) return;
+
+			CoreTimes& prev = s.coreTimes[index];
+			u64 deltaIdle  = idle  - prev.idle;
+			u64 deltaTotal = total - prev.total;
+			prev = { idle, total };
+
+			// NOTE: No time has passed, keep the last value
+			if (deltaTotal == 0) return;
+
+			r64 load = 1.0 - (r64) deltaIdle / (r64) deltaTotal;
+			api.values[s.firstLoad + index] = (r32) (100.0 * load);
+		});
+	}
+
+	// Clocks
+	if (s.hasClocks && ProcFile_Read(s.cpuinfo, scanner))
+	{
+		ParseCPUInfo(scanner, [&](u32 index, r64 mhz) {
+			if (index >= s.coreCount) return;
+			api.values[s.firstClock + index] = (r32) mhz;
+		});
+	}
+
+	// Memory
+	if (ProcFile_Read(s.meminfo, scanner))
+	{
+		u64 totalKB, availableKB;
+		ParseMemInfo(scanner, totalKB, availableKB);
+		if (totalKB != 0)
+		{
+			u64 usedKB = totalKB - Min(availableKB, totalKB);
+			api.values[s.memoryUsed] = (r32) ((r64) usedKB / (1024.0 * 1024.0));
+			api.values[s.memoryLoad] = (r32) (100.0 * (r64) usedKB / (r64) totalKB);
+		}
+	}
+
+	r64 pressure;
+	if (s.hasPressure && ProcFile_Read(s.pressure, scanner) && ParsePressure(scanner, pressure))
+		api.values[s.memoryPressure] = (r32) pressure;
+}
+
+static void
+Teardown(PluginContext& context, SensorPluginAPI::Teardown api)
+{
+	Unused(context, api);
+	State& s = state;
+
+	ProcFile_Close(s.stat);
+	ProcFile_Close(s.cpuinfo);
+	ProcFile_Close(s.meminfo);
+	ProcFile_Close(s.pressure);
+	List_Free(s.coreTimes);
+	s = {};
+}
+
+EXPORT void
+GetSensorPluginInfo(PluginDesc& desc, SensorPluginFunctions& functions)
+{
+	desc.name       = "procfs Sensors";
+	desc.author     = "LCDHardwareMonitor contributors";
+	desc.version    = 1;
+	desc.lhmVersion = LHMVersion;
+
+	functions.Initialize = Initialize;
+	functions.Update     = Update;
+	functions.Teardown   = Teardown;
+
+	// NOTE: CPU times are counted in jiffies, so short intervals make load readings noisy
+	functions.updateInterval = 0.5f;
+}
@@ -47,7 +47,6 @@ UpdateBarWidgets(PluginContext& context, WidgetAPI::Update api)
 
 	for (u32 i = 0; i < api.widgets.length; i++)
 	{
-		Widget&    widget    = api.widgets[i];
 		BarWidget& barWidget = (BarWidget&) api.widgetsUserData[i];
 
 		// Update
@@ -58,19 +57,13 @@ UpdateBarWidgets(PluginContext& context, WidgetAPI::Update api)
 			// Option 2 - Split Update and Render for widgets
 			// Option 3 - Don't render multiple times - push shader overrides before updating
 			// Option 4 - Don't render multiple times - remember rendering calls and replay them
-			Sensor& sensor = *api.GetSensor(context, widget.sensorHandle);
-			barWidget.psPerObject.fillAmount = Lerp(barWidget.psPerObject.fillAmount, sensor.value, 0.10f);
+			r32 sensorValue = api.sensorValues[i];
+			barWidget.psPerObject.fillAmount = Lerp(barWidget.psPerObject.fillAmount, sensorValue, 0.10f);
 		}
 
 		// Draw
 		{
-			v2 position = WidgetPosition(widget);
-			v2 size = widget.size;
-
-			Matrix world = Identity();
-			SetPosition(world, position, -widget.depth);
-			SetScale   (world, size, 1.0f);
-			barWidget.vsPerObject.wvp = world * api.GetViewProjectionMatrix(context);
+			barWidget.vsPerObject.wvp = api.wvps[i];
 
 			// TODO: Can we use instancing to accelerate this?
 			api.UpdateVSConstantBuffer(context, StandardVertexShader::WVP, 0, &barWidget.vsPerObject);